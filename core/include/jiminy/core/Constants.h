@@ -26,6 +26,7 @@ namespace jiminy
     extern std::string const TELEMETRY_DELIMITER;
     extern int64_t const TELEMETRY_MAX_BUFFER_SIZE;
     extern float64_t const TELEMETRY_DEFAULT_TIME_UNIT;
+    extern int64_t const TELEMETRY_FLIGHT_RECORDER_CHUNKS; ///< Number of chunks among which the memory budget of the flight recorder is split
 
     extern uint8_t const DELAY_MIN_BUFFER_RESERVE; ///< Minimum memory allocation is memory is full and the older data stored is dated less than the desired delay
     extern uint8_t const DELAY_MAX_BUFFER_EXCEED;  ///< Maximum number of data stored allowed to be dated more than the desired delay
@@ -34,6 +35,10 @@ namespace jiminy
     extern float64_t const SIMULATION_MAX_TIMESTEP;
     extern float64_t const SIMULATION_INITIAL_TIMESTEP;
     extern float64_t const STEPPER_MIN_TIMESTEP;
+
+    extern uint8_t const COLLISION_CYLINDER_RIM_POINTS; ///< Number of points sampled along each rim of the cylinders for collision detection
+
+    extern uint32_t const MODEL_CACHE_VERSION; ///< Version of the layout of the model cache, to be incremented whenever it changes
 }
 
 #endif  // JIMINY_CONSTANTS_H
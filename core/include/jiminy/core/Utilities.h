@@ -198,8 +198,77 @@ namespace jiminy
     hresult_t jsonLoad(configHolder_t                    & config,
                        std::shared_ptr<AbstractIODevice> & device);
 
+    // ************** Binary serialization utilities ****************
+
+    /// \brief Serialize a configuration in a compact binary format, preserving the exact type
+    ///        of every field. The heat map functors are not supported, except the default
+    ///        flat ground, and an error is returned if any other is found.
+    hresult_t binaryDump(configHolder_t const & config,
+                         std::string          & data);
+
+    hresult_t binaryLoad(configHolder_t       & config,
+                         std::string    const & data);
+
     // ************ Random number generator utilities ***************
 
+    /// \brief Counter-based random number generator.
+    ///
+    /// \details The n-th number of the stream is a pure function of the key of the stream and n,
+    ///          so that independent streams do not share any state, and fast-forwarding or
+    ///          rewinding a stream only requires setting its counter. The key is derived
+    ///          from a seed and the identifier of the stream.
+    class RandomStream
+    {
+    public:
+        RandomStream(uint32_t const & seed = 0U,
+                     uint64_t const & streamId = 0U);
+        RandomStream(uint32_t    const & seed,
+                     std::string const & streamName);
+
+        void seed(uint32_t const & seed,
+                  uint64_t const & streamId);
+        void seed(uint32_t    const & seed,
+                  std::string const & streamName);
+        /// \brief Move to the given position in the stream.
+        void setCounter(uint64_t const & counter);
+        uint64_t const & getCounter(void) const;
+
+        uint32_t operator()(void);
+
+        float64_t uniform(float64_t const & lo,
+                          float64_t const & hi);
+        float64_t normal(float64_t const & mean,
+                         float64_t const & std);
+        vectorN_t normal(uint32_t  const & size,
+                         float64_t const & mean,
+                         float64_t const & std);
+        vectorN_t normal(vectorN_t const & mean,
+                         vectorN_t const & std);
+        vectorN_t normal(vectorN_t const & std);
+
+    private:
+        float32_t uniform(void);
+        float32_t normal(void);
+
+    private:
+        uint64_t key_;
+        uint64_t counter_;
+    };
+
+    /// \brief Compute a non-cryptographic hash of some data, stable across platforms and runs.
+    ///
+    /// \details The hash of some previous data can be specified as seed, to hash them together.
+    uint64_t computeHash(std::string const & data,
+                         uint64_t    const & seed = 0xCBF29CE484222325ULL);
+    uint64_t computeHash(std::vector<std::string> const & data,
+                         uint64_t                 const & seed = 0xCBF29CE484222325ULL);
+
+    /// \brief Get a stream identifier, stable across platforms and runs, from a name.
+    uint64_t getStreamId(std::string const & streamName);
+
+    /* The following functions rely on a default stream local to each thread,
+       seeded by `resetRandGenerators`. */
+
     void resetRandGenerators(uint32_t const & seed);
 
     float64_t randUniform(float64_t const & lo,
@@ -220,6 +289,14 @@ namespace jiminy
     vectorN_t randVectorNormal(vectorN_t const & mean,
                                vectorN_t const & std);
 
+    // ********************** Time utilities ************************
+
+    /// \brief Convert a time into an integer number of STEPPER_MIN_TIMESTEP, rounded to the nearest.
+    int64_t timeToTick(float64_t const & t);
+
+    /// \brief Convert an integer number of STEPPER_MIN_TIMESTEP into a time.
+    float64_t tickToTime(int64_t const & tick);
+
     // ******************* Telemetry utilities **********************
 
     std::vector<std::string> defaultVectorFieldnames(std::string const & baseName,
@@ -376,6 +453,9 @@ namespace jiminy
     void catInPlace(std::vector<vectorN_t> const & xList,
                     vectorN_t                    & xCat);
     vectorN_t cat(std::vector<vectorN_t> const & xList);
+
+    /// \brief Flat ground at zero height, which is the default ground profile.
+    std::pair<float64_t, vector3_t> flatGround(vector3_t const & pos);
 }
 
 #include "jiminy/core/Utilities.tpp"
@@ -35,6 +35,8 @@ namespace jiminy
         {
             configHolder_t config;
             config["telemetryEnable"] = true;
+            config["updatePeriod"] = -1.0;
+            config["sensorsTypesRead"] = std::vector<std::string>(); // Evaluated beforehand if their update is deferred. Empty: every type
 
             return config;
         };
@@ -45,9 +47,13 @@ namespace jiminy
         struct controllerOptions_t
         {
             bool_t const telemetryEnable;     ///< Flag used to enable the telemetry of the controller
+            float64_t const updatePeriod;     ///< Update period of the controller. Negative to use the one of the engine, zero for continuous update.
+            std::vector<std::string> const sensorsTypesRead;  ///< Type of the sensors read to compute the command. Empty for every type.
 
             controllerOptions_t(configHolder_t const & options) :
-            telemetryEnable(boost::get<bool_t>(options.at("telemetryEnable")))
+            telemetryEnable(boost::get<bool_t>(options.at("telemetryEnable"))),
+            updatePeriod(boost::get<float64_t>(options.at("updatePeriod"))),
+            sensorsTypesRead(boost::get<std::vector<std::string> >(options.at("sensorsTypesRead")))
             {
                 // Empty.
             }
@@ -138,6 +144,8 @@ namespace jiminy
         ///
         /// \details    It assumes that the robot internal state (including sensors) is consistent
         ///             with other input arguments. It fetches the sensor data automatically.
+        ///             In continuous control, only the frames used by the simulation are up-to-date
+        ///             in the data of the robot. Call `flushKinematicsFrames` before reading others.
         ///
         /// \param[in]  t       Current time
         /// \param[in]  q       Current configuration vector
@@ -213,6 +221,26 @@ namespace jiminy
         virtual hresult_t configureTelemetry(std::shared_ptr<TelemetryData> telemetryData,
                                              std::string const & objectPrefixName = "");
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Mark the telemetry as configured again, reusing the variables registered
+        ///             during the previous configuration.
+        ///
+        /// \remark     This method is not intended to be called manually. The Engine is taking care
+        ///             of it instead of configuring the telemetry, if the fingerprint of the telemetry
+        ///             is unchanged since the previous simulation.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        void resumeTelemetry(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        ///
+        /// \brief      Get the hash of the variables and constants to register to the telemetry,
+        ///             and of the telemetry data to which the controller is currently bound.
+        ///
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        uint64_t getTelemetryFingerprint(void) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         ///
         /// \brief      Update the internal buffers of the telemetry associated with variables
@@ -50,7 +50,13 @@ namespace jiminy
                                        float64_t        const & dt,
                                        pinocchio::Force const & F);
         hresult_t registerForceProfile(std::string           const & frameName,
-                                       forceProfileFunctor_t         forceFct);
+                                       forceProfileFunctor_t         forceFct,
+                                       float64_t             const & updatePeriod = 0.0);
+        hresult_t registerForceProfile(std::string      const & frameName,
+                                       pinocchio::Force const & offset,
+                                       pinocchio::Force const & amplitude = pinocchio::Force::Zero(),
+                                       float64_t        const & frequency = 0.0,
+                                       float64_t        const & phase = 0.0);
 
         bool_t const & getIsInitialized(void) const;
         Robot const & getRobot(void) const;
@@ -62,9 +68,12 @@ namespace jiminy
     private:
         // Make private some methods to deter their use
         using EngineMultiRobot::addSystem;
+        using EngineMultiRobot::addKinematicSystem;
         using EngineMultiRobot::removeSystem;
         using EngineMultiRobot::addCouplingForce;
         using EngineMultiRobot::removeCouplingForces;
+        using EngineMultiRobot::addInteractionFrame;
+        using EngineMultiRobot::removeInteractionFrames;
         using EngineMultiRobot::start;
         using EngineMultiRobot::simulate;
         using EngineMultiRobot::registerForceImpulse;
@@ -2,6 +2,7 @@
 #define JIMINY_ENGINE_MULTIROBOT_H
 
 #include <functional>
+#include <queue>
 
 #include "jiminy/core/telemetry/TelemetrySender.h"
 #include "jiminy/core/Utilities.h"
@@ -18,6 +19,9 @@ namespace jiminy
     float64_t const CONSTRAINT_INVERSION_DAMPING = 1e-12; ///< Damping factor used to perform matrix pseudo-inverse
                                                           /// when computing forward dynamics with constraints.
 
+    std::set<std::string> const CONTACT_MODELS{"spring_damper",
+                                               "time_stepping"};
+
     class AbstractController;
     class TelemetryData;
     class TelemetryRecorder;
@@ -37,6 +41,7 @@ namespace jiminy
     using callbackFunctor_t = std::function<bool_t(float64_t const & /*t*/,
                                                    vectorN_t const & /*q*/,
                                                    vectorN_t const & /*v*/)>;
+    using timedEventFunctor_t = std::function<void(float64_t const & /*t*/)>;
 
     struct forceProfile_t
     {
@@ -45,10 +50,13 @@ namespace jiminy
 
         forceProfile_t(std::string           const & frameNameIn,
                        int32_t               const & frameIdxIn,
-                       forceProfileFunctor_t const & forceFctIn) :
+                       forceProfileFunctor_t const & forceFctIn,
+                       float64_t             const & updatePeriodIn) :
         frameName(frameNameIn),
         frameIdx(frameIdxIn),
-        forceFct(forceFctIn)
+        forceFct(forceFctIn),
+        updatePeriod(updatePeriodIn),
+        forcePrev(pinocchio::Force::Zero())
         {
             // Empty on purpose
         }
@@ -57,6 +65,8 @@ namespace jiminy
         std::string frameName;
         int32_t frameIdx;
         forceProfileFunctor_t forceFct;
+        float64_t updatePeriod;         ///< Period at which the profile is sampled. Zero if continuous.
+        pinocchio::Force forcePrev;     ///< Force at the last update, held constant until the next one if sampled
     } ;
 
     struct forceCoupling_t
@@ -98,6 +108,143 @@ namespace jiminy
         forceCouplingFunctor_t forceFct;
     };
 
+    /// \brief Native force profile, evaluated without calling any user-defined function.
+    ///
+    /// \details The force is given in world frame by
+    ///          F(t) = offset + amplitude * sin(2 * pi * frequency * t + phase),
+    ///          which covers both constant wrenches and sinusoidal disturbances.
+    struct forceProfileNative_t
+    {
+    public:
+        forceProfileNative_t(void) = default;
+
+        forceProfileNative_t(std::string      const & frameNameIn,
+                             int32_t          const & frameIdxIn,
+                             pinocchio::Force const & offsetIn,
+                             pinocchio::Force const & amplitudeIn,
+                             float64_t        const & frequencyIn,
+                             float64_t        const & phaseIn) :
+        frameName(frameNameIn),
+        frameIdx(frameIdxIn),
+        offset(offsetIn),
+        amplitude(amplitudeIn),
+        frequency(frequencyIn),
+        phase(phaseIn)
+        {
+            // Empty on purpose
+        }
+
+    public:
+        std::string frameName;
+        int32_t frameIdx;
+        pinocchio::Force offset;
+        pinocchio::Force amplitude;
+        float64_t frequency;
+        float64_t phase;
+    };
+
+    /// \brief Native coupling force, evaluated without calling any user-defined function.
+    ///
+    /// \details It is a spring-damper along the line going through the origin of both frames.
+    ///          A tether only pulls both frames toward each other, when stretched beyond
+    ///          its rest length.
+    struct forceCouplingNative_t
+    {
+    public:
+        forceCouplingNative_t(void) = default;
+
+        forceCouplingNative_t(std::string const & systemName1In,
+                              int32_t     const & systemIdx1In,
+                              std::string const & systemName2In,
+                              int32_t     const & systemIdx2In,
+                              std::string const & frameName1In,
+                              int32_t     const & frameIdx1In,
+                              std::string const & frameName2In,
+                              int32_t     const & frameIdx2In,
+                              float64_t   const & stiffnessIn,
+                              float64_t   const & dampingIn,
+                              float64_t   const & restLengthIn,
+                              bool_t      const & isTetherIn) :
+        systemName1(systemName1In),
+        systemIdx1(systemIdx1In),
+        systemName2(systemName2In),
+        systemIdx2(systemIdx2In),
+        frameName1(frameName1In),
+        frameIdx1(frameIdx1In),
+        frameName2(frameName2In),
+        frameIdx2(frameIdx2In),
+        stiffness(stiffnessIn),
+        damping(dampingIn),
+        restLength(restLengthIn),
+        isTether(isTetherIn)
+        {
+            // Empty on purpose.
+        }
+
+    public:
+        std::string systemName1;
+        int32_t systemIdx1;
+        std::string systemName2;
+        int32_t systemIdx2;
+        std::string frameName1;
+        int32_t frameIdx1;
+        std::string frameName2;
+        int32_t frameIdx2;
+        float64_t stiffness;
+        float64_t damping;
+        float64_t restLength;
+        bool_t isTether;
+    };
+
+    /// \brief Frame of a system interacting with the ones of every other system.
+    struct interactionFrame_t
+    {
+    public:
+        interactionFrame_t(void) = default;
+
+        interactionFrame_t(std::string const & systemNameIn,
+                           int32_t     const & systemIdxIn,
+                           std::string const & frameNameIn,
+                           int32_t     const & frameIdxIn) :
+        systemName(systemNameIn),
+        systemIdx(systemIdxIn),
+        frameName(frameNameIn),
+        frameIdx(frameIdxIn)
+        {
+            // Empty on purpose.
+        }
+
+    public:
+        std::string systemName;
+        int32_t systemIdx;
+        std::string frameName;
+        int32_t frameIdx;
+    };
+
+    struct collisionBody_t
+    {
+    public:
+        collisionBody_t(void) = default;
+
+        collisionBody_t(int32_t const & systemIdxIn,
+                        int32_t const & geometryIdxIn) :
+        systemIdx(systemIdxIn),
+        geometryIdx(geometryIdxIn),
+        centerRef(vector3_t::Zero()),
+        lowerBound(vector3_t::Zero()),
+        upperBound(vector3_t::Zero())
+        {
+            // Empty on purpose.
+        }
+
+    public:
+        int32_t systemIdx;
+        int32_t geometryIdx;    ///< Index of the geometry in the collision geometry of the robot
+        vector3_t centerRef;    ///< Center of the geometry at the last update of the broadphase
+        vector3_t lowerBound;   ///< Lower corner of the bounding box of the geometry, inflated by the margin
+        vector3_t upperBound;   ///< Upper corner of the bounding box of the geometry, inflated by the margin
+    };
+
     struct forceImpulse_t
     {
     public:
@@ -125,9 +272,107 @@ namespace jiminy
         pinocchio::Force F;
     };
 
+    enum class timedEventType_t : uint8_t
+    {
+        FORCE_IMPULSE_START = 0,
+        FORCE_IMPULSE_END = 1,
+        SENSORS_UPDATE = 2,
+        CONTROLLER_UPDATE = 3,
+        FORCE_PROFILE_UPDATE = 4,
+        USER_EVENT = 5
+    };
+
+    struct timedEvent_t
+    {
+    public:
+        timedEvent_t(void) = default;
+
+        timedEvent_t(int64_t          const & tickIn,
+                     timedEventType_t const & typeIn,
+                     int32_t          const & systemIdxIn,
+                     int32_t          const & idxIn,
+                     int64_t          const & periodIn) :
+        tick(tickIn),
+        type(typeIn),
+        systemIdx(systemIdxIn),
+        idx(idxIn),
+        period(periodIn)
+        {
+            // Empty on purpose
+        }
+
+        bool_t operator > (timedEvent_t const & other) const
+        {
+            // Events sharing the same tick are processed by type, so that a force ends after it starts
+            return (tick > other.tick) || (tick == other.tick && type > other.type);
+        }
+
+    public:
+        int64_t tick;           ///< Time of the event, in number of STEPPER_MIN_TIMESTEP
+        timedEventType_t type;
+        int32_t systemIdx;      ///< Index of the system to which the event is associated, if any
+        int32_t idx;            ///< Index of the object of the system to which the event is associated, if any
+        int64_t period;         ///< Period of the event in ticks if periodic, zero otherwise
+    };
+
+    struct timedEventUser_t
+    {
+    public:
+        timedEventUser_t(void) = default;
+
+        timedEventUser_t(float64_t           const & tIn,
+                         timedEventFunctor_t const & eventFctIn,
+                         float64_t           const & periodIn) :
+        t(tIn),
+        eventFct(eventFctIn),
+        period(periodIn)
+        {
+            // Empty on purpose
+        }
+
+    public:
+        float64_t t;                    ///< Time of the first occurrence of the event
+        timedEventFunctor_t eventFct;
+        float64_t period;               ///< Period of the event if periodic, zero otherwise
+    };
+
+    /// \brief Min-heap of timed events, so that only the due events must be processed at each step.
+    using timedEventQueue_t = std::priority_queue<timedEvent_t,
+                                                  std::vector<timedEvent_t>,
+                                                  std::greater<timedEvent_t> >;
+
     using forceProfileRegister_t = std::vector<forceProfile_t>;
     using forceCouplingRegister_t = std::vector<forceCoupling_t>;
     using forceImpulseRegister_t = std::vector<forceImpulse_t>;
+    using forceProfileNativeRegister_t = std::vector<forceProfileNative_t>;
+    using forceCouplingNativeRegister_t = std::vector<forceCouplingNative_t>;
+
+    /// \brief Native trajectory prescribing the motion of a kinematic system.
+    ///
+    /// \details The configuration is interpolated by cubic Hermite splines in tangent space,
+    ///          whose velocity at the knots is estimated by finite differences. It is held
+    ///          constant out of the time range of the knots.
+    struct kinematicTrajectory_t
+    {
+    public:
+        kinematicTrajectory_t(void) = default;
+
+        kinematicTrajectory_t(vectorN_t const & timesIn,
+                              matrixN_t const & positionsIn) :
+        times(timesIn),
+        positions(positionsIn),
+        deltas(),
+        slopes()
+        {
+            // Empty on purpose.
+        }
+
+    public:
+        vectorN_t times;        ///< Time of the knots, strictly increasing
+        matrixN_t positions;    ///< Configuration at the knots, stored column-wise
+        matrixN_t deltas;       ///< Difference of configuration between successive knots, stored column-wise
+        matrixN_t slopes;       ///< Velocity at the knots, stored column-wise
+    };
 
     struct stepperState_t
     {
@@ -179,6 +424,9 @@ namespace jiminy
     using stateSplitRef_t = std::pair<std::vector<Eigen::Ref<typename F<vectorN_t>::type> >,
                                       std::vector<Eigen::Ref<typename F<vectorN_t>::type> > >;
 
+    template<template<typename> class F = type_identity>
+    using motorsStateSplitRef_t = std::vector<Eigen::Ref<typename F<vectorN_t>::type> >;
+
     struct systemState_t
     {
     public:
@@ -192,6 +440,8 @@ namespace jiminy
         uMotor(),
         uInternal(),
         fExternal(),
+        xMotor(),
+        xMotorDot(),
         isInitialized_(false),
         robot_(nullptr)
         {
@@ -220,6 +470,8 @@ namespace jiminy
         vectorN_t uMotor;
         vectorN_t uInternal;
         forceVector_t fExternal;
+        vectorN_t xMotor;       ///< Internal continuous state of the motors
+        vectorN_t xMotorDot;    ///< Derivative of the internal state of the motors
 
     private:
         bool_t isInitialized_;
@@ -232,6 +484,11 @@ namespace jiminy
     public:
         friend EngineMultiRobot;
 
+        // The state of the kinematic systems is read directly when splitting the stepper state
+        template<template<typename> class F>
+        friend stateSplitRef_t<F> splitStateImpl(std::vector<systemDataHolder_t> const & systemsData,
+                                                 typename F<vectorN_t>::type & val);
+
         systemDataHolder_t(void);
 
         systemDataHolder_t(std::string const & systemNameIn,
@@ -242,8 +499,9 @@ namespace jiminy
     public:
         std::string name;
         std::shared_ptr<Robot> robot;
-        std::shared_ptr<AbstractController> controller;
+        std::shared_ptr<AbstractController> controller;    ///< Controller of the system. Null for kinematic systems.
         callbackFunctor_t callbackFct;
+        bool_t isKinematic;                                 ///< Whether the motion of the system is prescribed by a trajectory instead of integrated
         std::vector<std::string> positionFieldnames;
         std::vector<std::string> velocityFieldnames;
         std::vector<std::string> accelerationFieldnames;
@@ -255,18 +513,84 @@ namespace jiminy
         systemState_t state;       ///< Internal buffer with the state for the integration loop
         systemState_t statePrev;   ///< Internal state for the integration loop at the end of the previous iteration
         forceProfileRegister_t forcesProfile;
+        forceProfileNativeRegister_t forcesProfileNative;
         forceImpulseRegister_t forcesImpulse;
-        std::set<float64_t> forcesImpulseBreaks;    ///< Ordered list (without repetitions) of the start and end time associated with the forces
-        std::set<float64_t>::const_iterator forcesImpulseBreakNextIt;   ///< Iterator related to the time of the next breakpoint associated with the impulse forces
         std::vector<bool_t> forcesImpulseActive;    ///< Flag to active the forces. This is used to handle t-, t+ properly. Otherwise, it is impossible to determine at time t if the force is active or not.
+        float64_t controllerUpdatePeriod;           ///< Effective update period of the controller. Zero if continuous.
+        std::vector<std::string> sensorsTypes;      ///< Type of every group of sensors of the robot
+        std::vector<float64_t> sensorsUpdatePeriod; ///< Effective update period of every group of sensors. Zero if continuous.
+        vectorN_t jointsBoundedPosition;            ///< Buffer storing contiguously the position of the bounded joints
+        vectorN_t jointsBoundedVelocity;            ///< Buffer storing contiguously the velocity of the bounded joints
+        vectorN_t jointsBoundedEffort;              ///< Buffer storing contiguously the bound efforts of the bounded joints
+        kinematicTrajectory_t trajectory;           ///< Trajectory prescribing the motion of the system if kinematic
     };
 
     class EngineMultiRobot
     {
     public:
+        configHolder_t getDefaultInteractionOptions()
+        {
+            configHolder_t config;
+            config["stiffness"] = 0.0;          // Attractive beyond the rest length, repulsive below
+            config["damping"] = 0.0;
+            config["restLength"] = 0.0;         // [m]
+            config["cutoffRadius"] = 1.0;       // [m]
+            config["broadphaseMargin"] = 0.1;   // [m]
+
+            return config;
+        };
+
+        struct interactionOptions_t
+        {
+            float64_t const stiffness;
+            float64_t const damping;
+            float64_t const restLength;
+            float64_t const cutoffRadius;       ///< Distance beyond which the frames do not interact
+            float64_t const broadphaseMargin;   ///< Extra distance for the candidate pairs of frames, so that they remain valid over a whole step
+
+            interactionOptions_t(configHolder_t const & options) :
+            stiffness(boost::get<float64_t>(options.at("stiffness"))),
+            damping(boost::get<float64_t>(options.at("damping"))),
+            restLength(boost::get<float64_t>(options.at("restLength"))),
+            cutoffRadius(boost::get<float64_t>(options.at("cutoffRadius"))),
+            broadphaseMargin(boost::get<float64_t>(options.at("broadphaseMargin")))
+            {
+                // Empty.
+            }
+        };
+
+        configHolder_t getDefaultCollisionOptions()
+        {
+            configHolder_t config;
+            config["enableGround"] = false;     // Collisions between the geometry of the bodies and the ground
+            config["enableSelf"] = false;       // Collisions between the non-adjacent bodies of a system
+            config["enableSystems"] = false;    // Collisions between the bodies of different systems
+            config["broadphaseMargin"] = 0.05;  // [m]
+
+            return config;
+        };
+
+        struct collisionOptions_t
+        {
+            bool_t    const enableGround;
+            bool_t    const enableSelf;
+            bool_t    const enableSystems;
+            float64_t const broadphaseMargin;   ///< Extra distance for the candidate pairs of bodies, so that they remain valid while the bodies barely move
+
+            collisionOptions_t(configHolder_t const & options) :
+            enableGround(boost::get<bool_t>(options.at("enableGround"))),
+            enableSelf(boost::get<bool_t>(options.at("enableSelf"))),
+            enableSystems(boost::get<bool_t>(options.at("enableSystems"))),
+            broadphaseMargin(boost::get<float64_t>(options.at("broadphaseMargin")))
+            {
+                // Empty.
+            }
+        };
+
         configHolder_t getDefaultContactOptions()
         {
             configHolder_t config;
+            config["model"] = std::string("spring_damper"); // ["spring_damper", "time_stepping"]
             config["frictionViscous"] = 0.8;
             config["frictionDry"] = 1.0;
             config["frictionStictionVel"] = 1.0e-2;
@@ -274,6 +598,8 @@ namespace jiminy
             config["stiffness"] = 1.0e6;
             config["damping"] = 2.0e3;
             config["transitionEps"] = 1.0e-3; // [m]
+            config["pgsIterMax"] = 50U;
+            config["pgsTolAbs"] = 1.0e-8; // [N.s]
 
             return config;
         };
@@ -293,11 +619,7 @@ namespace jiminy
         {
             configHolder_t config;
             config["gravity"] = (vectorN_t(6) << 0.0, 0.0, -9.81, 0.0, 0.0, 0.0).finished();
-            config["groundProfile"] = heatMapFunctor_t(
-                [](vector3_t const & pos) -> std::pair <float64_t, vector3_t>
-                {
-                    return {0.0, (vector3_t() << 0.0, 0.0, 1.0).finished()};
-                });
+            config["groundProfile"] = heatMapFunctor_t(flatGround);
 
             return config;
         };
@@ -315,6 +637,7 @@ namespace jiminy
             config["iterMax"] = 1000000; // -1: infinity
             config["sensorsUpdatePeriod"] = 0.0;
             config["controllerUpdatePeriod"] = 0.0;
+            config["sensorsLazyEvaluation"] = false; // Evaluate continuous sensors only when their data is needed
             config["logInternalStepperSteps"] = false;
 
             return config;
@@ -329,6 +652,11 @@ namespace jiminy
             config["enableEffort"] = true;
             config["enableEnergy"] = true;
             config["timeUnit"] = 1e6;
+            config["flightRecorderMemSize"] = 0U; // [bytes] Only keep the most recent data fitting in it. 0: keep everything
+            config["flightRecorderDumpPath"] = std::string(""); // Binary log to write if the simulation fails. Empty: disabled
+            config["constantsMemSize"] = 0U; // [bytes] Memory reserved up front for the constants. 0: default
+            config["integersMemSize"] = 0U; // [bytes] Memory reserved up front for the integer variables. 0: default
+            config["floatsMemSize"] = 0U; // [bytes] Memory reserved up front for the float variables. 0: default
             return config;
         };
 
@@ -340,12 +668,15 @@ namespace jiminy
             config["world"] = getDefaultWorldOptions();
             config["joints"] = getDefaultJointOptions();
             config["contacts"] = getDefaultContactOptions();
+            config["interactions"] = getDefaultInteractionOptions();
+            config["collisions"] = getDefaultCollisionOptions();
 
             return config;
         };
 
         struct contactOptions_t
         {
+            std::string const model;        ///< "time_stepping" integrates with fixed steps of 'stepper.dtMax', ignoring 'odeSolver', 'tolAbs', 'tolRel' and 'dtRestoreThresholdRel'
             float64_t const frictionViscous;
             float64_t const frictionDry;
             float64_t const frictionStictionVel;
@@ -353,15 +684,20 @@ namespace jiminy
             float64_t const stiffness;
             float64_t const damping;
             float64_t const transitionEps;
+            uint32_t  const pgsIterMax;     ///< Maximum number of projected Gauss-Seidel sweeps (time-stepping only)
+            float64_t const pgsTolAbs;      ///< Impulse variation below which the projected Gauss-Seidel has converged (time-stepping only)
 
             contactOptions_t(configHolder_t const & options) :
+            model(boost::get<std::string>(options.at("model"))),
             frictionViscous(boost::get<float64_t>(options.at("frictionViscous"))),
             frictionDry(boost::get<float64_t>(options.at("frictionDry"))),
             frictionStictionVel(boost::get<float64_t>(options.at("frictionStictionVel"))),
             frictionStictionRatio(boost::get<float64_t>(options.at("frictionStictionRatio"))),
             stiffness(boost::get<float64_t>(options.at("stiffness"))),
             damping(boost::get<float64_t>(options.at("damping"))),
-            transitionEps(boost::get<float64_t>(options.at("transitionEps")))
+            transitionEps(boost::get<float64_t>(options.at("transitionEps"))),
+            pgsIterMax(boost::get<uint32_t>(options.at("pgsIterMax"))),
+            pgsTolAbs(boost::get<float64_t>(options.at("pgsTolAbs")))
             {
                 // Empty.
             }
@@ -409,6 +745,7 @@ namespace jiminy
             int32_t     const iterMax;
             float64_t   const sensorsUpdatePeriod;
             float64_t   const controllerUpdatePeriod;
+            bool_t      const sensorsLazyEvaluation;
             bool_t      const logInternalStepperSteps;
 
             stepperOptions_t(configHolder_t const & options) :
@@ -422,6 +759,7 @@ namespace jiminy
             iterMax(boost::get<int32_t>(options.at("iterMax"))),
             sensorsUpdatePeriod(boost::get<float64_t>(options.at("sensorsUpdatePeriod"))),
             controllerUpdatePeriod(boost::get<float64_t>(options.at("controllerUpdatePeriod"))),
+            sensorsLazyEvaluation(boost::get<bool_t>(options.at("sensorsLazyEvaluation"))),
             logInternalStepperSteps(boost::get<bool_t>(options.at("logInternalStepperSteps")))
             {
                 // Empty.
@@ -436,6 +774,11 @@ namespace jiminy
             bool_t const enableEffort;
             bool_t const enableEnergy;
             float64_t const timeUnit;
+            uint32_t const flightRecorderMemSize;
+            std::string const flightRecorderDumpPath;
+            uint32_t const constantsMemSize;
+            uint32_t const integersMemSize;
+            uint32_t const floatsMemSize;
 
             telemetryOptions_t(configHolder_t const & options) :
             enableConfiguration(boost::get<bool_t>(options.at("enableConfiguration"))),
@@ -443,7 +786,12 @@ namespace jiminy
             enableAcceleration(boost::get<bool_t>(options.at("enableAcceleration"))),
             enableEffort(boost::get<bool_t>(options.at("enableEffort"))),
             enableEnergy(boost::get<bool_t>(options.at("enableEnergy"))),
-            timeUnit(boost::get<float64_t>(options.at("timeUnit")))
+            timeUnit(boost::get<float64_t>(options.at("timeUnit"))),
+            flightRecorderMemSize(boost::get<uint32_t>(options.at("flightRecorderMemSize"))),
+            flightRecorderDumpPath(boost::get<std::string>(options.at("flightRecorderDumpPath"))),
+            constantsMemSize(boost::get<uint32_t>(options.at("constantsMemSize"))),
+            integersMemSize(boost::get<uint32_t>(options.at("integersMemSize"))),
+            floatsMemSize(boost::get<uint32_t>(options.at("floatsMemSize")))
             {
                 // Empty.
             }
@@ -456,13 +804,17 @@ namespace jiminy
             worldOptions_t     const world;
             jointOptions_t     const joints;
             contactOptions_t   const contacts;
+            interactionOptions_t const interactions;
+            collisionOptions_t const collisions;
 
             engineOptions_t(configHolder_t const & options) :
             telemetry(boost::get<configHolder_t>(options.at("telemetry"))),
             stepper(boost::get<configHolder_t>(options.at("stepper"))),
             world(boost::get<configHolder_t>(options.at("world"))),
             joints(boost::get<configHolder_t>(options.at("joints"))),
-            contacts(boost::get<configHolder_t>(options.at("contacts")))
+            contacts(boost::get<configHolder_t>(options.at("contacts"))),
+            interactions(boost::get<configHolder_t>(options.at("interactions"))),
+            collisions(boost::get<configHolder_t>(options.at("collisions")))
             {
                 // Empty.
             }
@@ -481,6 +833,21 @@ namespace jiminy
                             std::shared_ptr<Robot> robot,
                             std::shared_ptr<AbstractController> controller,
                             callbackFunctor_t callbackFct);
+        /// \brief Add a kinematic system, whose motion is prescribed by a trajectory.
+        ///
+        /// \details The state of a kinematic system is not integrated, so that it does not take
+        ///          part in the error control of the stepper, and it does not need any controller
+        ///          nor initial state. It still applies and undergoes the coupling, interaction
+        ///          and collision forces, but they do not affect its motion.
+        ///
+        /// \param[in] systemName Name of the system
+        /// \param[in] robot Robot whose motion is prescribed
+        /// \param[in] times Time of the knots of the trajectory, strictly increasing
+        /// \param[in] positions Configuration of the robot at the knots, stored column-wise
+        hresult_t addKinematicSystem(std::string const & systemName,
+                                     std::shared_ptr<Robot> robot,
+                                     vectorN_t const & times,
+                                     matrixN_t const & positions);
         hresult_t removeSystem(std::string const & systemName);
 
         /// \brief Add a force linking both systems together
@@ -502,10 +869,46 @@ namespace jiminy
                                    std::string            const & frameName1,
                                    std::string            const & frameName2,
                                    forceCouplingFunctor_t         forceFct);
+
+        /// \brief Add a native spring-damper force linking both systems together.
+        ///
+        /// \details Contrary to a user-defined callback function, it is evaluated natively,
+        ///          along with every other native coupling force.
+        ///
+        /// \param[in] systemName1 Name of the first system
+        /// \param[in] systemName2 Name of the second system
+        /// \param[in] frameName1 Frame on the first system where the force is applied.
+        /// \param[in] frameName2 Frame on the second system where
+        ///                       (the opposite of) the force is applied.
+        /// \param[in] stiffness Stiffness of the spring
+        /// \param[in] damping Damping along the line going through both frames
+        /// \param[in] restLength Distance between both frames at rest
+        /// \param[in] isTether Whether the force only pulls the frames toward each other
+        hresult_t addCouplingForce(std::string const & systemName1,
+                                   std::string const & systemName2,
+                                   std::string const & frameName1,
+                                   std::string const & frameName2,
+                                   float64_t   const & stiffness,
+                                   float64_t   const & damping,
+                                   float64_t   const & restLength,
+                                   bool_t      const & isTether = false);
         hresult_t removeCouplingForces(std::string const & systemName1,
                                        std::string const & systemName2);
         hresult_t removeCouplingForces(std::string const & systemName);
 
+        /// \brief Designate a frame of a system interacting with the ones of every other system.
+        ///
+        /// \details The interaction force derives from a short-range potential, whose parameters
+        ///          are the 'interactions' options of the engine. Only the pairs of frames closer
+        ///          than the cutoff radius are evaluated, thanks to a uniform-grid broadphase
+        ///          updated once per step, so that the cost scales with the number of neighbours.
+        ///
+        /// \param[in] systemName Name of the system
+        /// \param[in] frameName Frame of the system where the interaction forces are applied
+        hresult_t addInteractionFrame(std::string const & systemName,
+                                      std::string const & frameName);
+        hresult_t removeInteractionFrames(std::string const & systemName);
+
         /// \brief Reset engine.
         ///
         /// \details This function resets the engine, the robot and the controller.
@@ -555,6 +958,17 @@ namespace jiminy
         hresult_t simulate(float64_t const & tEnd,
                            std::map<std::string, vectorN_t> const & xInit);
 
+        /// \brief Record some variables of the telemetry separately, less often than the others.
+        ///
+        /// \details The variables are recorded once every 'decimation' snapshots. They are
+        ///          specified by their names, or any prefix of their names, and belong to the
+        ///          first group matching them. Their last recorded value is used in between
+        ///          when parsing the log.
+        hresult_t registerTelemetryGroup(std::string              const & groupName,
+                                         uint32_t                 const & decimation,
+                                         std::vector<std::string> const & fieldnames);
+        hresult_t removeTelemetryGroups(void);
+
         /// \brief Apply an impulse force on a frame for a given duration at the desired time.
         ///        The force must be given in the world frame.
         hresult_t registerForceImpulse(std::string      const & systemName,
@@ -565,9 +979,30 @@ namespace jiminy
 
         /// \brief Apply an time-continuous external force on a frame.
         ///        The force can be time and state dependent, and must be given in the world frame.
+        ///        If the update period is positive, the force is only evaluated periodically and
+        ///        held constant in between. Otherwise, it is evaluated continuously.
         hresult_t registerForceProfile(std::string           const & systemName,
                                        std::string           const & frameName,
-                                       forceProfileFunctor_t         forceFct);
+                                       forceProfileFunctor_t         forceFct,
+                                       float64_t             const & updatePeriod = 0.0);
+
+        /// \brief Apply a native time-continuous external force on a frame.
+        ///        The force is given in world frame by
+        ///        F(t) = offset + amplitude * sin(2 * pi * frequency * t + phase).
+        hresult_t registerForceProfile(std::string      const & systemName,
+                                       std::string      const & frameName,
+                                       pinocchio::Force const & offset,
+                                       pinocchio::Force const & amplitude = pinocchio::Force::Zero(),
+                                       float64_t        const & frequency = 0.0,
+                                       float64_t        const & phase = 0.0);
+
+        /// \brief Call a user-defined function at the desired time, and periodically afterward if
+        ///        the period is positive. It is a breakpoint for the stepper, so that the function
+        ///        is free to alter anything affecting the dynamics, e.g. the command or the forces.
+        hresult_t registerTimedEvent(float64_t           const & t,
+                                     timedEventFunctor_t         eventFct,
+                                     float64_t           const & period = 0.0);
+        hresult_t removeTimedEvents(void);
 
         configHolder_t getOptions(void) const;
         hresult_t setOptions(configHolder_t const & engineOptions);
@@ -606,21 +1041,40 @@ namespace jiminy
 
     protected:
         hresult_t configureTelemetry(void);
+        /// \brief Hash of the variables to register to the telemetry, used to determine
+        ///        whether the ones registered during the previous simulation can be reused.
+        uint64_t getTelemetryFingerprint(void) const;
         void updateTelemetry(void);
 
         stateSplitRef_t<std::add_const> splitState(vectorN_t const & val) const;
         stateSplitRef_t<> splitState(vectorN_t & val) const;
+        motorsStateSplitRef_t<std::add_const> splitMotorsState(vectorN_t const & val) const;
+        motorsStateSplitRef_t<> splitMotorsState(vectorN_t & val) const;
 
         void syncStepperStateWithSystems(void);
         void syncSystemsStateWithStepper(void);
 
-        static void computeForwardKinematics(systemDataHolder_t       & system,
-                                             vectorN_t          const & q,
-                                             vectorN_t          const & v,
-                                             vectorN_t          const & a);
+        /// \brief Update the configuration, velocity and acceleration of a kinematic system
+        ///        by evaluating its trajectory.
+        static void computeKinematicTrajectory(systemDataHolder_t       & system,
+                                               float64_t          const & t);
+
+        static void computeForwardKinematics(systemDataHolder_t                & system,
+                                             Eigen::Ref<vectorN_t const> const & q,
+                                             Eigen::Ref<vectorN_t const> const & v,
+                                             Eigen::Ref<vectorN_t const> const & a,
+                                             bool_t                      const & updateAllFrames = true);
 
         pinocchio::Force computeContactDynamics(systemDataHolder_t const & system,
                                                 int32_t            const & frameIdx) const;
+        /// \brief Compute the force of the spring-damper contact model, in world frame.
+        ///
+        /// \param[in] depth Penetration depth. It must be negative.
+        /// \param[in] normal Normal of the contact surface, pointing toward the body receiving the force.
+        /// \param[in] velocity Velocity of the body relative to the contact surface, in world frame.
+        vector3_t computeContactForce(float64_t const & depth,
+                                      vector3_t const & normal,
+                                      vector3_t const & velocity) const;
 
         void computeCommand(systemDataHolder_t                & system,
                             float64_t                   const & t,
@@ -637,6 +1091,21 @@ namespace jiminy
                                    Eigen::Ref<vectorN_t const> const & q,
                                    Eigen::Ref<vectorN_t const> const & v,
                                    forceVector_t                     & fext);
+        pinocchio::Force computeCouplingForceNative(forceCouplingNative_t const & force) const;
+        void updateInteractionPairs(void);
+        void computeInteractionForces(void);
+        /// \brief Update the candidate pairs of colliding bodies, and the bodies close to the ground.
+        ///
+        /// \details Sweep-and-prune along the x-axis over the bounding boxes of the geometries.
+        ///          The boxes are inflated by the margin, so that nothing is done as long as no
+        ///          body has moved by more than half of it since the last update. The sorting is
+        ///          kept from one update to the next, so that it costs a single pass most of the time.
+        ///
+        /// \param[in] isForced Whether to update the pairs even if the bodies barely moved.
+        void updateCollisionPairs(bool_t const & isForced = false);
+        /// \brief Generate the contact points of the candidate pairs, and apply the associated
+        ///        spring-damper contact forces.
+        void computeCollisionForces(void);
         void computeInternalForces(float64_t                       const & t,
                                    stateSplitRef_t<std::add_const> const & xSplit);
         void computeAllForces(float64_t                       const & t,
@@ -645,9 +1114,43 @@ namespace jiminy
                                    vectorN_t const & xCat,
                                    vectorN_t       & dxdtCat);
 
+        /// \brief Perform a single step of the time-stepping contact scheme.
+        ///
+        /// \details Moreau-Jean midpoint scheme: the configuration is predicted at mid-step,
+        ///          the smooth dynamics is evaluated there, then the contact impulses are
+        ///          computed at velocity-level before updating the configuration with the
+        ///          velocity at the end of the step.
+        void computeTimeSteppingUpdate(float64_t const & t,
+                                       float64_t const & dt,
+                                       vectorN_t       & xCat,
+                                       vectorN_t       & dxdtCat);
+        void computeContactImpulses(systemDataHolder_t                & system,
+                                    Eigen::Ref<vectorN_t const> const & q,
+                                    float64_t                   const & dt,
+                                    vectorN_t                         & v);
+
         void reset(bool_t const & resetRandomNumbers,
                    bool_t const & resetDynamicForceRegister);
 
+        /// \brief Schedule every timed event of the simulation: start and end of the impulse
+        ///        forces, discrete update of the sensors and controllers, and user-defined events.
+        void initializeTimedEvents(void);
+
+        /// \brief Process every timed event due at the current time.
+        ///
+        /// \return Whether or not the dynamics has changed because of the processed events.
+        bool_t processTimedEvents(float64_t const & t);
+
+        /// \brief Update the sensors whose update is due strictly within the last successful step.
+        ///
+        /// \details They are not breakpoints for the stepper. Instead, the state at the time of
+        ///          the update is interpolated linearly between the states at both ends of the step.
+        void processSensorsTimedEventsInStep(float64_t const & tPrev,
+                                             float64_t const & t);
+
+        /// \brief Get the time of the next timed event being a breakpoint for the stepper, INF if none.
+        float64_t getTimedEventNext(void) const;
+
     private:
         template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl,
                  typename ConfigVectorType, typename TangentVectorType>
@@ -709,10 +1212,24 @@ namespace jiminy
         TelemetrySender telemetrySender_;
         std::shared_ptr<TelemetryData> telemetryData_;
         std::unique_ptr<TelemetryRecorder> telemetryRecorder_;
+        uint64_t telemetryFingerprint_;                     ///< Fingerprint of the variables registered to the telemetry data, 0 if none
         stepper_t stepper_;
         float64_t stepperUpdatePeriod_;
         stepperState_t stepperState_;
         forceCouplingRegister_t forcesCoupling_;
+        forceCouplingNativeRegister_t forcesCouplingNative_;
+        forceVector_t forcesCouplingNativeValue_;   ///< Buffer storing the native coupling forces before applying them
+        std::vector<interactionFrame_t> interactionFrames_;
+        std::vector<std::pair<int64_t, int32_t> > interactionCells_;    ///< Cell of the uniform grid of every interaction frame, sorted by cell
+        std::vector<std::pair<int32_t, int32_t> > interactionPairs_;    ///< Candidate pairs of interaction frames, updated once per step
+        std::vector<collisionBody_t> collisionBodies_;
+        std::vector<int32_t> collisionSweepOrder_;     ///< Collision bodies sorted by lower bound along x-axis, kept from one update to the next
+        std::vector<std::pair<int32_t, int32_t> > collisionPairs_;     ///< Candidate pairs of colliding bodies
+        std::vector<int32_t> collisionGroundCandidates_;    ///< Collision bodies close to the ground
+        std::vector<timedEventUser_t> timedEventsUser_;
+        timedEventQueue_t timedEvents_;        ///< Timed events being breakpoints for the stepper
+        timedEventQueue_t sensorsTimedEvents_; ///< Discrete update of the sensors, which are not breakpoints
+        bool_t isContactTimeStepping_;  ///< Whether the contacts are handled by the time-stepping scheme instead of the spring-damper model
     };
 }
 
@@ -13,6 +13,7 @@
 #include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/algorithm/aba.hpp"
 #include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/crba.hpp"
 #include "pinocchio/algorithm/energy.hpp"
 
 #include "jiminy/core/engine/EngineMultiRobot.h"
@@ -52,6 +53,26 @@ namespace pinocchio_overload
         return data.tau;
     }
 
+    template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl,
+             typename ConfigVectorType>
+    inline const typename pinocchio::DataTpl<Scalar,Options,JointCollectionTpl>::MatrixXs &
+    crba(pinocchio::ModelTpl<Scalar,Options,JointCollectionTpl> const & model,
+         pinocchio::DataTpl<Scalar,Options,JointCollectionTpl>        & data,
+         Eigen::MatrixBase<ConfigVectorType>                    const & q)
+    {
+        pinocchio::crba(model, data, q);
+        for (int32_t i = 1; i < model.njoints; i++)
+        {
+            // Only support inertia for 1DoF joints.
+            if (model.joints[i].nv() == 1)
+            {
+                int32_t const jointVelocityIdx = model.joints[i].idx_v();
+                data.M(jointVelocityIdx, jointVelocityIdx) += model.rotorInertia[jointVelocityIdx];
+            }
+        }
+        return data.M;
+    }
+
     template<typename Scalar, int Options, template<typename, int> class JointCollectionTpl>
     struct AbaBackwardStep
     : public pinocchio::fusion::JointVisitorBase< AbaBackwardStep<Scalar,Options,JointCollectionTpl> >
@@ -3,6 +3,7 @@
 #define JIMINY_STEPPERS_H
 
 #include <set>
+#include <functional>
 
 #include "jiminy/core/Types.h"
 
@@ -49,6 +50,56 @@ namespace jiminy
             }
         };
 
+        // ************************************************************************
+        // ***************************** Time-stepping ****************************
+        // ************************************************************************
+
+        class TimeStepping
+        {
+        public:
+            using stepper_category = controlled_stepper_tag;
+            using updateFunctor_t = std::function<void(state_type       & /*x*/,
+                                                       deriv_type       & /*dxdt*/,
+                                                       time_type  const & /*t*/,
+                                                       time_type  const & /*dt*/)>;
+
+            /* The state update is delegated to the engine, since it requires the
+               contact impulses that cannot be expressed as a plain ODE rhs.
+               No error control is performed: every step is successful and the
+               next time step is always the largest one allowed. Hence, the error
+               control options of the adaptive steppers, namely 'tolAbs', 'tolRel'
+               and 'dtRestoreThresholdRel', are ignored. */
+            TimeStepping(updateFunctor_t updateFct,
+                         time_type const & dtMax) :
+            updateFct_(std::move(updateFct)),
+            dtMax_(dtMax)
+            {
+                // Empty on purpose.
+            }
+
+            static unsigned short order(void)
+            {
+                return 1;
+            }
+
+            template<class System>
+            controlled_step_result try_step(System       /* system */,
+                                            state_type & x,
+                                            deriv_type & dxdt,
+                                            time_type  & t,
+                                            time_type  & dt) const
+            {
+                updateFct_(x, dxdt, t, dt);
+                t += dt;
+                dt = dtMax_;
+                return controlled_step_result::success;
+            }
+
+        private:
+            updateFunctor_t updateFct_;
+            time_type dtMax_;
+        };
+
         // ************************************************************************
         // **************************** Bulirsch-Stoer ****************************
         // ************************************************************************
@@ -144,7 +195,8 @@ namespace jiminy
     using stepper_t = boost::variant<
         stepper::BulirschStoer,
         stepper::RungeKutta,
-        stepper::EulerExplicit
+        stepper::EulerExplicit,
+        stepper::TimeStepping
     >;
 
     std::set<std::string> const STEPPERS{"runge_kutta_dopri5",
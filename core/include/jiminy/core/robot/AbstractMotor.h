@@ -33,8 +33,11 @@ namespace jiminy
     {
         MotorSharedDataHolder_t(void) :
         data_(),
+        state_(),
+        stateDerivative_(),
         motors_(),
-        num_(0)
+        num_(0),
+        groups_()
         {
             // Empty.
         };
@@ -42,8 +45,11 @@ namespace jiminy
         ~MotorSharedDataHolder_t(void) = default;
 
         vectorN_t data_;                            ///< Buffer with current actual motor effort
+        vectorN_t state_;                           ///< Buffer with current internal continuous state of every motor
+        vectorN_t stateDerivative_;                 ///< Buffer with current derivative of the internal state of every motor
         std::vector<AbstractMotorBase *> motors_;   ///< Vector of pointers to the motors
         int32_t num_;                               ///< Number of motors
+        std::vector<std::vector<AbstractMotorBase *> > groups_;  ///< Motors grouped by type, the efforts of every motor of a group being computed at once
     };
 
     class AbstractMotorBase: public std::enable_shared_from_this<AbstractMotorBase>
@@ -151,6 +157,47 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         hresult_t setOptionsAll(configHolder_t const & motorOptions);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the size of the internal continuous state of the motor.
+        ///
+        /// \details    The internal state of every motor is appended to the state of the robot
+        ///             and integrated by the engine alongside the configuration and velocity.
+        ///             Its derivative must be computed by `computeEffort`. It is zero by default,
+        ///             namely the motor is purely algebraic.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual uint32_t getStateSize(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get stateIdx_.
+        ///
+        /// \details    It is the index of the internal state of the motor in the state buffer of
+        ///             every motor.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        int32_t const & getStateIdx(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the current internal state of the motor.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Ref<vectorN_t const> getState(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the current internal state of all the motors.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        vectorN_t const & getStateAll(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get the current derivative of the internal state of all the motors.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        vectorN_t const & getStateDerivativeAll(void) const;
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Set the internal state of all the motors.
+        ///
+        /// \remark     This method is not intended to be called manually. The engine is taking care
+        ///             of it before computing the motor efforts.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        hresult_t setStateAll(Eigen::Ref<vectorN_t const> const & x);
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief      Get isInitialized_.
         ///
@@ -270,6 +317,53 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////////////////////////////
         float64_t & data(void);
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get a reference to the last data buffer corresponding to the actual effort
+        ///             of every motor.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        vectorN_t & dataAll(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get a reference to the internal state of the motor.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Ref<vectorN_t> state(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Get a reference to the derivative of the internal state of the motor, which
+        ///             must be updated by `computeEffort`.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        Eigen::Ref<vectorN_t> stateDerivative(void);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Refresh the data shared by a group of motors of the same type.
+        ///
+        /// \details    It is called on the first motor of every group by `resetAll`, so that a motor
+        ///             type can lay out contiguously the parameters of every motor of the group.
+        ///
+        /// \param[in]  motors  Motors of the group, including this one
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t refreshGroup(std::vector<AbstractMotorBase *> const & motors);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Request every motor of a group of the same type to update its actual effort.
+        ///
+        /// \details    The default implementation calls `computeEffort` for each motor individually.
+        ///             Motor types can override it to evaluate every motor at once.
+        ///
+        /// \param[in]  motors   Motors of the group, including this one
+        /// \param[in]  t        Current time
+        /// \param[in]  q        Current configuration vector
+        /// \param[in]  v        Current velocity vector
+        /// \param[in]  a        Current acceleration vector
+        /// \param[in]  uCommand Current command effort vector
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual hresult_t computeEffortGroup(std::vector<AbstractMotorBase *> const & motors,
+                                             float64_t                   const & t,
+                                             Eigen::Ref<vectorN_t const> const & q,
+                                             Eigen::Ref<vectorN_t const> const & v,
+                                             Eigen::Ref<vectorN_t const> const & a,
+                                             vectorN_t                   const & uCommand);
+
     private:
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief    Attach the sensor to a robot
@@ -294,6 +388,7 @@ namespace jiminy
         Robot const * robot_;                       ///< Robot for which the command and internal dynamics
         std::string name_;                          ///< Name of the motor
         int32_t motorIdx_;                           ///< Index of the motor in the measurement buffer
+        int32_t stateIdx_;                           ///< Index of the internal state of the motor in the state buffer
         std::string jointName_;
         int32_t jointModelIdx_;
         joint_t jointType_;
@@ -14,6 +14,7 @@
 #define JIMINY_ABSTRACT_SENSOR_H
 
 #include "jiminy/core/telemetry/TelemetrySender.h"
+#include "jiminy/core/Utilities.h"
 #include "jiminy/core/Types.h"
 
 #include <boost/circular_buffer.hpp>
@@ -85,6 +86,7 @@ namespace jiminy
             config["bias"] = vectorN_t();
             config["delay"] = 0.0;
             config["delayInterpolationOrder"] = 0U;
+            config["updatePeriod"] = -1.0;
 
             return config;
         };
@@ -95,12 +97,14 @@ namespace jiminy
             vectorN_t const bias;       ///< Bias of the sensor
             float64_t const delay;      ///< Delay of the sensor
             uint32_t  const delayInterpolationOrder; ///< Order of the interpolation used to compute delayed sensor data. [0: Zero-order holder, 1: Linear interpolation]
+            float64_t const updatePeriod; ///< Update period of the sensor. Negative to use the one of the engine, zero for continuous update. It must be the same for every sensor of a given type.
 
             abstractSensorOptions_t(configHolder_t const & options) :
             noiseStd(boost::get<vectorN_t>(options.at("noiseStd"))),
             bias(boost::get<vectorN_t>(options.at("bias"))),
             delay(boost::get<float64_t>(options.at("delay"))),
-            delayInterpolationOrder(boost::get<uint32_t>(options.at("delayInterpolationOrder")))
+            delayInterpolationOrder(boost::get<uint32_t>(options.at("delayInterpolationOrder"))),
+            updatePeriod(boost::get<float64_t>(options.at("updatePeriod")))
             {
                 // Empty.
             }
@@ -426,6 +430,7 @@ namespace jiminy
         bool_t isTelemetryConfigured_;          ///< Flag to determine whether the telemetry of the sensor has been initialized or not
         Robot const * robot_;                   ///< Robot for which the command and internal dynamics
         std::string name_;                      ///< Name of the sensor
+        RandomStream generator_;                ///< Random number stream used to generate the measurement noise
 
     private:
         TelemetrySender telemetrySender_;       ///< Telemetry sender of the sensor used to register and update telemetry variables
@@ -61,6 +61,105 @@ namespace jiminy
 
         virtual hresult_t setOptions(configHolder_t const & motorOptions) final override;
 
+    private:
+        virtual hresult_t computeEffort(float64_t const & t,
+                                        float64_t const & q,
+                                        float64_t const & v,
+                                        float64_t const & a,
+                                        float64_t const & uCommand) final override;
+        virtual hresult_t refreshGroup(std::vector<AbstractMotorBase *> const & motors) final override;
+        virtual hresult_t computeEffortGroup(std::vector<AbstractMotorBase *> const & motors,
+                                             float64_t                   const & t,
+                                             Eigen::Ref<vectorN_t const> const & q,
+                                             Eigen::Ref<vectorN_t const> const & v,
+                                             Eigen::Ref<vectorN_t const> const & a,
+                                             vectorN_t                   const & uCommand) final override;
+
+    private:
+        std::unique_ptr<motorOptions_t const> motorOptions_;
+
+        /* Parameters of every motor of the group laid out contiguously, only used by the first motor
+           of the group. Disabled effort limits are infinite and disabled frictions are zero, so that
+           the efforts are computed by branch-free array expressions. */
+        std::vector<int32_t> groupMotorsIdx_;
+        std::vector<int32_t> groupVelocityIdx_;
+        vectorN_t groupEffortLimit_;
+        vectorN_t groupFrictionViscousPositive_;
+        vectorN_t groupFrictionViscousNegative_;
+        vectorN_t groupFrictionDryPositive_;
+        vectorN_t groupFrictionDryNegative_;
+        vectorN_t groupFrictionDrySlope_;
+        vectorN_t groupCommand_;                    ///< Buffer storing contiguously the command of every motor of the group
+        vectorN_t groupVelocity_;                   ///< Buffer storing contiguously the velocity of every motor of the group
+    };
+
+    class DcMotor : public AbstractMotorBase
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Dictionary gathering the configuration options shared between motors
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        virtual configHolder_t getDefaultMotorOptions(void) override
+        {
+            // Add extra options or update default values
+            configHolder_t config = AbstractMotorBase::getDefaultMotorOptions();
+
+            config["armatureResistance"] = 1.0;
+            config["armatureInductance"] = 1.0e-3;
+            config["torqueConstant"] = 0.1;
+            config["backEmfConstant"] = 0.1;
+            config["resistanceTemperatureCoefficient"] = 0.0039;
+            config["thermalResistance"] = 1.0;
+            config["thermalCapacitance"] = 100.0;
+
+            return config;
+        };
+
+        struct motorOptions_t : public abstractMotorOptions_t
+        {
+            float64_t const armatureResistance;                 ///< Resistance of the windings at ambient temperature. It is always positive.
+            float64_t const armatureInductance;                 ///< Inductance of the windings. It is always positive.
+            float64_t const torqueConstant;                     ///< Ratio between the effort and the current.
+            float64_t const backEmfConstant;                    ///< Ratio between the back electromotive force and the velocity.
+            float64_t const resistanceTemperatureCoefficient;   ///< Relative increase of the resistance of the windings per degree above ambient temperature.
+            float64_t const thermalResistance;                  ///< Thermal resistance between the windings and the environment. It is always positive.
+            float64_t const thermalCapacitance;                 ///< Thermal capacitance of the windings. It is always positive.
+
+            motorOptions_t(configHolder_t const & options) :
+            abstractMotorOptions_t(options),
+            armatureResistance(boost::get<float64_t>(options.at("armatureResistance"))),
+            armatureInductance(boost::get<float64_t>(options.at("armatureInductance"))),
+            torqueConstant(boost::get<float64_t>(options.at("torqueConstant"))),
+            backEmfConstant(boost::get<float64_t>(options.at("backEmfConstant"))),
+            resistanceTemperatureCoefficient(boost::get<float64_t>(options.at("resistanceTemperatureCoefficient"))),
+            thermalResistance(boost::get<float64_t>(options.at("thermalResistance"))),
+            thermalCapacitance(boost::get<float64_t>(options.at("thermalCapacitance")))
+            {
+                // Empty.
+            }
+        };
+
+    public:
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        /// \brief      Brushed DC motor, whose command is the voltage applied to the windings.
+        ///
+        /// \details    Its internal state is the current in the windings and their temperature
+        ///             rise above ambient temperature. The current follows the electrical dynamics
+        ///             including the back electromotive force, while the temperature follows a
+        ///             first-order thermal model heated by the Joule losses.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        DcMotor(std::string const & name);
+        virtual ~DcMotor(void) = default;
+
+        auto shared_from_this() { return shared_from(this); }
+        auto shared_from_this() const { return shared_from(this); }
+
+        hresult_t initialize(std::string const & jointName);
+
+        virtual hresult_t setOptions(configHolder_t const & motorOptions) final override;
+
+        virtual uint32_t getStateSize(void) const final override;
+
     private:
         virtual hresult_t computeEffort(float64_t const & t,
                                         float64_t const & q,
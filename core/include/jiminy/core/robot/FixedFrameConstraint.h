@@ -37,6 +37,9 @@ namespace jiminy
         FixedFrameConstraint(std::string const & frameName);
         virtual ~FixedFrameConstraint(void);
 
+        std::string const & getFrameName(void) const;
+        int32_t const & getFrameIdx(void) const;
+
         ///////////////////////////////////////////////////////////////////////////////////////////////
         /// \brief    Compute and return the jacobian of the constraint.
         ///
@@ -83,7 +86,7 @@ namespace jiminy
 
     private:
         std::string frameName_;     ///< Name of the frame on which the constraint operates.
-        int frameIdx_;              ///< Corresponding frame index.
+        int32_t frameIdx_;          ///< Corresponding frame index.
     };
 }
 
@@ -1,14 +1,74 @@
 #ifndef JIMINY_MODEL_H
 #define JIMINY_MODEL_H
 
+#include <deque>
+
 #include "pinocchio/multibody/model.hpp"
 #include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/model.hpp"
 
+#include "jiminy/core/Utilities.h"
 #include "jiminy/core/Types.h"
 
 
 namespace jiminy
 {
+    // Primitive shapes of the collision geometry. Meshes are not supported.
+    enum class collisionShape_t : uint8_t
+    {
+        SPHERE = 0,
+        BOX = 1,
+        CYLINDER = 2
+    };
+
+    struct collisionGeometry_t
+    {
+        std::string bodyName;           ///< Name of the body to which the geometry is attached
+        collisionShape_t shape;
+        vector3_t size;                 ///< Radius for spheres, half-extents for boxes, radius and half-length along z-axis for cylinders
+        pinocchio::SE3 placement;       ///< Placement of the geometry wrt the body frame
+        float64_t boundingRadius;       ///< Radius of the smallest sphere centered on the geometry enclosing it
+        std::vector<vector3_t> probePoints;  ///< Points of the surface tested against the other geometries, in local frame. Empty for spheres.
+        int32_t jointIdx;               ///< Index of the parent joint in the current model
+        int32_t jointRigidIdx;          ///< Index of the parent joint in the rigid model, used to identify adjacent bodies
+        pinocchio::SE3 jointPlacement;  ///< Placement of the geometry wrt the parent joint in the current model
+    };
+
+    /// \brief Immutable data of a model, which depends only on the URDF and a few options.
+    ///
+    /// \details It is shared by every model of the process loaded from the same URDF with
+    ///          the same options. It is not shared with other processes.
+    struct sharedModelData_t
+    {
+        std::string urdfData;
+        pinocchio::Model pncModelFull;
+        pinocchio::Model pncModelRigid;
+        pinocchio::Model pncModelFlexible;
+        std::vector<collisionGeometry_t> collisionGeometries;
+        std::vector<std::string> rigidJointsNames;
+        std::vector<std::string> flexibleJointsNames;
+        std::vector<int32_t> flexibleJointsModelIdx;
+        vectorN_t lockedConfigurationFull;
+    };
+
+    /// \brief Dynamics properties of the bodies of a model, randomly biased wrt their nominal value.
+    struct modelBias_t
+    {
+        pinocchio::container::aligned_vector<pinocchio::Inertia> inertias;  ///< Inertia of the bodies, ordered as the rigid joints
+        std::vector<vector3_t> relativePositions;                           ///< Position of the rigid joints wrt their parent
+    };
+
+    /// \brief Compute the signed distance of a point to the surface of a collision geometry.
+    ///
+    /// \param[in] geometry Collision geometry
+    /// \param[in] pos Position of the point in the local frame of the geometry
+    /// \param[out] normal Outward normal of the surface at the closest point, in local frame
+    ///
+    /// \return Signed distance, negative if the point is inside the geometry.
+    float64_t computeSignedDistance(collisionGeometry_t const & geometry,
+                                    vector3_t           const & pos,
+                                    vector3_t                 & normal);
+
     class Model
     {
     public:
@@ -22,6 +82,8 @@ namespace jiminy
             config["enableVelocityLimit"] = true;
             config["velocityLimitFromUrdf"] = true;
             config["velocityLimit"] = vectorN_t();
+            config["lockedJointsNames"] = std::vector<std::string>();
+            config["lockedJointsPositions"] = std::vector<vectorN_t>();
 
             return config;
         };
@@ -40,11 +102,21 @@ namespace jiminy
             return config;
         };
 
+        virtual configHolder_t getDefaultCacheOptions()
+        {
+            configHolder_t config;
+            config["enable"] = false;
+            config["directory"] = std::string();  // Empty to use '.cache/jiminy' in the user directory
+
+            return config;
+        };
+
         virtual configHolder_t getDefaultModelOptions()
         {
             configHolder_t config;
             config["dynamics"] = getDefaultDynamicsOptions();
             config["joints"] = getDefaultJointOptions();
+            config["cache"] = getDefaultCacheOptions();
 
             return config;
         };
@@ -58,6 +130,8 @@ namespace jiminy
             bool_t    const enableVelocityLimit;
             bool_t    const velocityLimitFromUrdf;
             vectorN_t const velocityLimit;
+            std::vector<std::string> const lockedJointsNames;       ///< Joints removed from the model, frozen at a fixed position
+            std::vector<vectorN_t>   const lockedJointsPositions;   ///< Configuration of each locked joint. Empty to use the neutral configuration.
 
             jointOptions_t(configHolder_t const & options) :
             enablePositionLimit(boost::get<bool_t>(options.at("enablePositionLimit"))),
@@ -66,7 +140,9 @@ namespace jiminy
             positionLimitMax(boost::get<vectorN_t>(options.at("positionLimitMax"))),
             enableVelocityLimit(boost::get<bool_t>(options.at("enableVelocityLimit"))),
             velocityLimitFromUrdf(boost::get<bool_t>(options.at("velocityLimitFromUrdf"))),
-            velocityLimit(boost::get<vectorN_t>(options.at("velocityLimit")))
+            velocityLimit(boost::get<vectorN_t>(options.at("velocityLimit"))),
+            lockedJointsNames(boost::get<std::vector<std::string> >(options.at("lockedJointsNames"))),
+            lockedJointsPositions(boost::get<std::vector<vectorN_t> >(options.at("lockedJointsPositions")))
             {
                 // Empty.
             }
@@ -93,14 +169,29 @@ namespace jiminy
             }
         };
 
+        struct cacheOptions_t
+        {
+            bool_t      const enable;       ///< Whether to load the processed models from a binary cache instead of parsing the URDF
+            std::string const directory;
+
+            cacheOptions_t(configHolder_t const & options) :
+            enable(boost::get<bool_t>(options.at("enable"))),
+            directory(boost::get<std::string>(options.at("directory")))
+            {
+                // Empty.
+            }
+        };
+
         struct modelOptions_t
         {
             dynamicsOptions_t const dynamics;
             jointOptions_t const joints;
+            cacheOptions_t const cache;
 
             modelOptions_t(configHolder_t const & options) :
             dynamics(boost::get<configHolder_t>(options.at("dynamics"))),
-            joints(boost::get<configHolder_t>(options.at("joints")))
+            joints(boost::get<configHolder_t>(options.at("joints"))),
+            cache(boost::get<configHolder_t>(options.at("cache")))
             {
                 // Empty.
             }
@@ -126,9 +217,25 @@ namespace jiminy
 
         /// This method are not intended to be called manually. The Engine is taking care of it.
         virtual void reset(void);
+        /// \brief Seed the random number streams of the model, each of them being identified
+        ///        by the given name and the origin of the randomness.
+        ///
+        /// \details The streams resume from their current position unless they are reset,
+        ///          so that successive simulations do not draw the same numbers.
+        virtual void seedRandomStreams(uint32_t    const & seed,
+                                       std::string const & streamName,
+                                       bool_t      const & resetStreams = true);
+        /// \brief Sample up front the biases of the dynamics properties of the next models.
+        ///
+        /// \details They are applied in order at the next resets instead of being sampled on the
+        ///          fly, using the same random number stream, so that the models are the same.
+        ///          The pending biases are discarded when the random number streams are reset.
+        hresult_t sampleModelsBiased(uint32_t const & nModels);
+        uint32_t getModelsBiasedPendingCount(void) const;
 
         bool_t const & getIsInitialized(void) const;
         std::string const & getUrdfPath(void) const;
+        std::string const & getUrdfData(void) const;
         bool_t const & getHasFreeflyer(void) const;
         // Getters without 'get' prefix for consistency with pinocchio C++ API
         int32_t const & nq(void) const;
@@ -137,6 +244,7 @@ namespace jiminy
 
         std::vector<std::string> const & getContactFramesNames(void) const;
         std::vector<int32_t> const & getContactFramesIdx(void) const;
+        std::vector<collisionGeometry_t> const & getCollisionGeometries(void) const;
         std::vector<std::string> const & getRigidJointsNames(void) const;
         std::vector<int32_t> const & getRigidJointsModelIdx(void) const;
         std::vector<int32_t> const & getRigidJointsPositionIdx(void) const;
@@ -148,6 +256,16 @@ namespace jiminy
         vectorN_t const & getPositionLimitMax(void) const;
         vectorN_t const & getVelocityLimit(void) const;
 
+        std::vector<int32_t> const & getBoundedJointsPositionIdx(void) const;
+        std::vector<int32_t> const & getBoundedJointsVelocityIdx(void) const;
+        vectorN_t const & getBoundedJointsPositionLimitMin(void) const;
+        vectorN_t const & getBoundedJointsPositionLimitMax(void) const;
+        vectorN_t const & getBoundedJointsVelocityLimit(void) const;
+        std::vector<int32_t> const & getFlexibleJointsPositionIdx(void) const;
+        std::vector<int32_t> const & getFlexibleJointsVelocityIdx(void) const;
+        matrixN_t const & getFlexibleJointsStiffness(void) const;
+        matrixN_t const & getFlexibleJointsDamping(void) const;
+
         std::vector<std::string> const & getPositionFieldnames(void) const;
         std::vector<std::string> const & getVelocityFieldnames(void) const;
         std::vector<std::string> const & getAccelerationFieldnames(void) const;
@@ -156,19 +274,77 @@ namespace jiminy
                                             vectorN_t       & xFlex) const;
         hresult_t getRigidStateFromFlexible(vectorN_t const & xFlex,
                                             vectorN_t       & xRigid) const;
+        /// \brief Get the configuration of the full model, namely including the locked joints,
+        ///        from the configuration of the rigid model.
+        hresult_t getFullPositionFromRigid(vectorN_t const & qRigid,
+                                           vectorN_t       & qFull) const;
+
+        /// \brief Compute the forward kinematics of the model, ie the placement, velocity and
+        ///        acceleration of every joint, then the placement of the frames.
+        ///
+        /// \details The computations are skipped if pncData_ is already up-to-date wrt the
+        ///          given state, so that every consumer shares a single kinematics pass.
+        ///          Only the frames set by `setKinematicsFramesIdx` are updated, unless
+        ///          `updateAllFrames` is true.
+        void computeForwardKinematics(Eigen::Ref<vectorN_t const> const & q,
+                                      Eigen::Ref<vectorN_t const> const & v,
+                                      Eigen::Ref<vectorN_t const> const & a,
+                                      bool_t                      const & updateAllFrames = true);
+        /// \brief Same as above, without updating the acceleration of the joints.
+        void computeForwardKinematics(Eigen::Ref<vectorN_t const> const & q,
+                                      Eigen::Ref<vectorN_t const> const & v,
+                                      bool_t                      const & updateAllFrames = true);
+        /// \brief Update the placement of every frame for the cached kinematics, if only the
+        ///        frames actually used by the simulation are up-to-date.
+        ///
+        /// \details It must be called before reading the placement of any other frame from
+        ///          pncData_ in the middle of a step, typically by continuous-time controllers.
+        void flushKinematicsFrames(void);
+        /// \brief Compute the jacobian of every joint, unless already up-to-date wrt the given configuration.
+        void computeJointJacobians(Eigen::Ref<vectorN_t const> const & q);
+        /// \brief Invalidate the cached kinematics.
+        ///
+        /// \details It must be called whenever pncData_ is altered by any other mean.
+        ///
+        /// \param[in] isAccelerationOnly Whether only the acceleration and jacobians of the joints have
+        ///                               been altered, which is the case of the dynamics algorithms
+        ///                               (rnea, aba, crba) evaluated for the cached configuration.
+        void invalidateKinematics(bool_t const & isAccelerationOnly = false);
+        /// \brief Set the frames whose placement is actually used during the simulation.
+        void setKinematicsFramesIdx(std::vector<int32_t> const & framesIdx);
 
     protected:
-        hresult_t loadUrdfModel(std::string const & urdfPath,
+        /// \brief Backup the state for which the kinematics has been computed, before computing
+        ///        it temporarily for another state.
+        void backupKinematics(void);
+        /// \brief Compute the kinematics for the state backed up, unless already up-to-date.
+        void restoreKinematics(void);
+        hresult_t loadUrdfModel(std::string const & urdfData,
                                 bool_t      const & hasFreeflyer);
+        virtual hresult_t initializeFromUrdfData(std::string const & urdfPath,
+                                                 std::string const & urdfData,
+                                                 bool_t      const & hasFreeflyer);
+        uint64_t getModelCacheKey(std::string const & urdfData,
+                                  bool_t      const & hasFreeflyer) const;
+        std::string getModelCachePath(uint64_t const & key) const;
+        hresult_t loadModelCache(std::string                        const & cachePath,
+                                 std::shared_ptr<sharedModelData_t const> & sharedData) const;
+        hresult_t saveModelCache(std::string       const & cachePath,
+                                 sharedModelData_t const & sharedData) const;
+        void setSharedModelData(std::shared_ptr<sharedModelData_t const> const & sharedData);
+        hresult_t generateModelReduced(void);
         hresult_t generateModelFlexible(void);
         hresult_t generateModelBiased(void);
+        void sampleModelBias(modelBias_t & modelBias);
         hresult_t refreshContactsProxies(void);
+        hresult_t refreshCollisionsProxies(void);
         virtual hresult_t refreshProxies(void);
 
     public:
         pinocchio::Model pncModel_;
         mutable pinocchio::Data pncData_;
-        pinocchio::Model pncModelRigidOrig_;
+        std::shared_ptr<pinocchio::Model const> pncModelFull_;       ///< Model loaded from the URDF, without any locked joint
+        std::shared_ptr<pinocchio::Model const> pncModelRigidOrig_;
         pinocchio::Data pncDataRigidOrig_;
         std::unique_ptr<modelOptions_t const> mdlOptions_;
         forceVector_t contactForces_;                       ///< Buffer storing the contact forces
@@ -176,11 +352,13 @@ namespace jiminy
     protected:
         bool_t isInitialized_;
         std::string urdfPath_;
+        std::shared_ptr<std::string const> urdfData_;      ///< Content of the URDF file, so that the model can be rebuilt without accessing it
         bool_t hasFreeflyer_;
         configHolder_t mdlOptionsHolder_;
 
         std::vector<std::string> contactFramesNames_;       ///< Name of the frames of the contact points of the robot
         std::vector<int32_t> contactFramesIdx_;             ///< Indices of the contact frames in the frame list of the robot
+        std::vector<collisionGeometry_t> collisionGeometries_;  ///< Collision geometry of the bodies, made of the primitive shapes of the URDF
         std::vector<std::string> rigidJointsNames_;         ///< Name of the actual joints of the robot, not taking into account the freeflyer
         std::vector<int32_t> rigidJointsModelIdx_;          ///< Index of the actual joints in the pinocchio robot
         std::vector<int32_t> rigidJointsPositionIdx_;       ///< All the indices of the actual joints in the configuration vector of the robot (ie including all the degrees of freedom)
@@ -192,12 +370,47 @@ namespace jiminy
         vectorN_t positionLimitMax_;                        ///< Lower position limit of the whole configuration vector (INF for non-physical joints, ie flexibility joints and freeflyer, if any)
         vectorN_t velocityLimit_;                           ///< Maximum absolute velocity of the whole velocity vector (INF for non-physical joints, ie flexibility joints and freeflyer, if any)
 
+        std::vector<int32_t> boundedJointsPositionIdx_;     ///< Indices in the configuration vector of the degrees of freedom of the rigid joints whose limits are enforced (ie having as many position and velocity coordinates)
+        std::vector<int32_t> boundedJointsVelocityIdx_;     ///< Indices in the velocity vector of the degrees of freedom of the rigid joints whose limits are enforced
+        vectorN_t boundedJointsPositionLimitMin_;           ///< Lower position limit of the bounded degrees of freedom, stored contiguously
+        vectorN_t boundedJointsPositionLimitMax_;           ///< Upper position limit of the bounded degrees of freedom, stored contiguously
+        vectorN_t boundedJointsVelocityLimit_;              ///< Maximum absolute velocity of the bounded degrees of freedom, stored contiguously
+        std::vector<int32_t> flexibleJointsPositionIdx_;    ///< Index of the first position coordinate of the enabled flexibility joints
+        std::vector<int32_t> flexibleJointsVelocityIdx_;    ///< Index of the first velocity coordinate of the enabled flexibility joints
+        matrixN_t flexibleJointsStiffness_;                 ///< Stiffness of the enabled flexibility joints, stored column-wise
+        matrixN_t flexibleJointsDamping_;                   ///< Damping of the enabled flexibility joints, stored column-wise
+
         std::vector<std::string> positionFieldnames_;       ///< Fieldnames of the elements in the configuration vector of the rigid robot
         std::vector<std::string> velocityFieldnames_;       ///< Fieldnames of the elements in the velocity vector of the rigid robot
         std::vector<std::string> accelerationFieldnames_;   ///< Fieldnames of the elements in the acceleration vector of the rigid robot
+        RandomStream generator_;                            ///< Random number stream used to bias the dynamics properties of the model
+
+    private:
+        void updateKinematicsFrames(bool_t const & updateAllFrames);
 
     private:
-        pinocchio::Model pncModelFlexibleOrig_;
+        std::shared_ptr<pinocchio::Model const> pncModelFlexibleOrig_;
+        std::shared_ptr<pinocchio::Model const> pncModelNominal_;  ///< Model from which pncModel_ has been copied, whose dynamics properties are nominal
+        std::vector<int32_t> biasedJointsModelIdx_;         ///< Index of the rigid joints in pncModel_, whose dynamics properties are biased
+        bool_t isModelBiased_;                              ///< Whether the dynamics properties of pncModel_ differ from the nominal ones
+        modelBias_t modelBias_;                             ///< Buffer storing the biases sampled on the fly
+        std::deque<modelBias_t> modelsBiasPending_;         ///< Biases sampled up front, to be applied at the next resets
+        vectorN_t lockedConfigurationFull_;                 ///< Configuration of the full model with the locked joints at their prescribed position
+        vectorN_t kinematicsQ_;                             ///< Configuration for which the kinematics has been computed
+        vectorN_t kinematicsV_;                             ///< Velocity for which the kinematics has been computed
+        vectorN_t kinematicsA_;                             ///< Acceleration for which the kinematics has been computed
+        vectorN_t jacobiansQ_;                              ///< Configuration for which the joint jacobians have been computed
+        bool_t isKinematicsValid_;                          ///< Whether the placement and velocity of the joints are up-to-date
+        bool_t isKinematicsAccelerationValid_;              ///< Whether the acceleration of the joints is up-to-date
+        bool_t areKinematicsFramesAllValid_;                ///< Whether the placement of every frame is up-to-date, not only the ones being used
+        bool_t areJointJacobiansValid_;                     ///< Whether the joint jacobians are up-to-date
+        std::vector<int32_t> kinematicsFramesIdx_;          ///< Indices of the frames whose placement is actually used
+        vectorN_t kinematicsQBackup_;                       ///< Configuration for which the kinematics has been backed up
+        vectorN_t kinematicsVBackup_;                       ///< Velocity for which the kinematics has been backed up
+        vectorN_t kinematicsABackup_;                       ///< Acceleration for which the kinematics has been backed up
+        bool_t isKinematicsValidBackup_;
+        bool_t isKinematicsAccelerationValidBackup_;
+        bool_t areKinematicsFramesAllValidBackup_;
         int32_t nq_;
         int32_t nv_;
         int32_t nx_;
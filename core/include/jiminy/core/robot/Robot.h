@@ -1,6 +1,8 @@
 #ifndef JIMINY_ROBOT_H
 #define JIMINY_ROBOT_H
 
+#include <unordered_set>
+
 #include "jiminy/core/robot/Model.h"
 #include "jiminy/core/Utilities.h"
 #include "jiminy/core/Types.h"
@@ -47,9 +49,6 @@ namespace jiminy
         Robot(void);
         virtual ~Robot(void);
 
-        hresult_t initialize(std::string const & urdfPath,
-                             bool_t      const & hasFreeflyer = true);
-
         hresult_t attachMotor(std::shared_ptr<AbstractMotorBase> motor);
         hresult_t getMotor(std::string const & motorName,
                            std::shared_ptr<AbstractMotorBase> & motor);
@@ -77,11 +76,46 @@ namespace jiminy
                                   vectorN_t                   const & u);
         vectorN_t const & getMotorsEfforts(void) const;
         float64_t const & getMotorEffort(std::string const & motorName) const;
+        int32_t getMotorsStateSize(void) const;
+        vectorN_t const & getMotorsState(void) const;
+        vectorN_t const & getMotorsStateDerivative(void) const;
+        hresult_t setMotorsState(Eigen::Ref<vectorN_t const> const & x);
         void setSensorsData(float64_t                   const & t,
                             Eigen::Ref<vectorN_t const> const & q,
                             Eigen::Ref<vectorN_t const> const & v,
                             Eigen::Ref<vectorN_t const> const & a,
                             vectorN_t                   const & u);
+        void setSensorsData(std::string                 const & sensorType,
+                            float64_t                   const & t,
+                            Eigen::Ref<vectorN_t const> const & q,
+                            Eigen::Ref<vectorN_t const> const & v,
+                            Eigen::Ref<vectorN_t const> const & a,
+                            vectorN_t                   const & u);
+
+        /// \brief Defer the update of the sensors of a given type until their data is actually needed.
+        ///
+        /// \details Only the input state is recorded. The sensors are evaluated by `flushSensorsData`.
+        ///          It falls back to immediate update for delayed sensors, since the whole history
+        ///          of the data is required to interpolate the measurement in such a case.
+        void setSensorsDataLazy(std::string                 const & sensorType,
+                                float64_t                   const & t,
+                                Eigen::Ref<vectorN_t const> const & q,
+                                Eigen::Ref<vectorN_t const> const & v,
+                                Eigen::Ref<vectorN_t const> const & a,
+                                vectorN_t                   const & u);
+
+        /// \brief Evaluate the sensors whose update has been deferred, if any.
+        ///
+        /// \details The kinematics is recomputed for the recorded state beforehand, since
+        ///          it may have been altered since then, but only if any of them is pending.
+        ///
+        /// \param[in] sensorType Type of the sensors to evaluate. Every type if empty.
+        void flushSensorsData(std::string const & sensorType = {});
+
+        /// \brief Evaluate the sensors of several types whose update has been deferred, if any.
+        ///
+        /// \details The kinematics is recomputed at most once for all of them.
+        void flushSensorsData(std::vector<std::string> const & sensorsTypes);
 
         /// \brief Add a kinematic constraint to the robot.
         ///
@@ -123,6 +157,9 @@ namespace jiminy
         /// \brief Returns true if at least one constraint is active on the robot.
         bool_t hasConstraint(void) const;
 
+        /// \brief Get the indices of the frames whose placement is used by the constraints.
+        std::vector<int32_t> getConstraintsFramesIdx(void) const;
+
         sensorsDataMap_t getSensorsData(void) const;
         Eigen::Ref<vectorN_t const> getSensorData(std::string const & sensorType,
                                                   std::string const & sensorName) const;
@@ -155,10 +192,30 @@ namespace jiminy
         hresult_t dumpOptions(std::string const & filepath) const;
         hresult_t loadOptions(std::string const & filepath);
 
+        /// \brief Serialize the whole configuration of the robot in a binary archive, namely
+        ///        the content of the URDF file, the contact points, the motors, the sensors,
+        ///        the constraints and the options.
+        ///
+        /// \details It is self-contained, so that the robot can be rebuilt from it without
+        ///          accessing the filesystem, typically to ship it to remote workers. Only
+        ///          the built-in motors, sensors and constraints are supported.
+        hresult_t dumpToBinary(std::string & data) const;
+        hresult_t loadFromBinary(std::string const & data);
+
         // Those methods are not intended to be called manually. The Engine is taking care of it.
         virtual void reset(void) override;
+        virtual void seedRandomStreams(uint32_t    const & seed,
+                                       std::string const & streamName,
+                                       bool_t      const & resetStreams = true) override;
         virtual hresult_t configureTelemetry(std::shared_ptr<TelemetryData> telemetryData,
                                              std::string const & objectPrefixName = "");
+        /// \brief Mark the telemetry as configured again, reusing the variables registered
+        ///        during the previous configuration. It is only valid if the fingerprint of
+        ///        the telemetry is unchanged since then.
+        void resumeTelemetry(void);
+        /// \brief Hash of the variables to register to the telemetry, and of the telemetry
+        ///        data to which the sensors are currently bound.
+        uint64_t getTelemetryFingerprint(void) const;
         void updateTelemetry(void);
         bool_t const & getIsTelemetryConfigured(void) const;
 
@@ -180,6 +237,9 @@ namespace jiminy
         bool_t const & getIsLocked(void) const;
 
     protected:
+        virtual hresult_t initializeFromUrdfData(std::string const & urdfPath,
+                                                 std::string const & urdfData,
+                                                 bool_t      const & hasFreeflyer) override;
         hresult_t refreshMotorsProxies(void);
         hresult_t refreshSensorsProxies(void);
         /// \brief Refresh the proxies of the kinematics constraints.
@@ -201,10 +261,22 @@ namespace jiminy
         matrixN_t constraintsJacobian_;                                             ///< Matrix holding the jacobian of the constraints.
         vectorN_t constraintsDrift_;                                                ///< Vector holding the drift of the constraints.
 
+    private:
+        /// \brief Evaluate the sensors of a given type at the state of their deferred update.
+        ///        The kinematics must have been restored beforehand.
+        void evaluateSensorsPending(std::string const & sensorType);
+
     private:
         MutexLocal mutexLocal_;
         std::shared_ptr<MotorSharedDataHolder_t> motorsSharedHolder_;
         std::unordered_map<std::string, std::shared_ptr<SensorSharedDataHolder_t> > sensorsSharedHolder_;
+        std::unordered_set<std::string> sensorsTypesPending_;                      ///< Type of the sensors whose update has been deferred
+        float64_t sensorsTimePending_;                                              ///< Time of the deferred update of the sensors
+        vectorN_t sensorsQPending_;                                                 ///< Configuration of the deferred update of the sensors
+        vectorN_t sensorsVPending_;                                                 ///< Velocity of the deferred update of the sensors
+        vectorN_t sensorsAPending_;                                                 ///< Acceleration of the deferred update of the sensors
+        vectorN_t sensorsUPending_;                                                 ///< Motor efforts of the deferred update of the sensors
+        std::vector<std::string> sensorsTypesLogged_;                               ///< Buffer holding the type of the deferred sensors to evaluate before logging
     };
 }
 
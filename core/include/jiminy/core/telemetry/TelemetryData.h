@@ -24,11 +24,13 @@ namespace jiminy
     std::string const START_CONSTANTS("StartConstants"); ///< Marker of the beginning the constants section.
     std::string const START_COLUMNS("StartColumns");     ///< Marker of the beginning the columns section.
     std::string const START_LINE_TOKEN("StartLine");     ///< Marker of the beginning of a line of data.
+    std::string const START_GROUP_LINE_TOKEN("GroupLine"); ///< Marker of the beginning of a line of data of a rate group. Same size as START_LINE_TOKEN.
+    std::string const RATE_GROUP("Global.RateGroup");    ///< Prefix of the constants describing the rate groups.
     std::string const START_DATA("StartData");           ///< Marker of the beginning of the data section.
 
-    std::size_t const CONSTANTS_MEM_SIZE = 16U * 1024U;
-    std::size_t const INTEGERS_MEM_SIZE  = 32U * 1024U;
-    std::size_t const FLOATS_MEM_SIZE    = 42U * 1024U;
+    std::size_t const CONSTANTS_MEM_SIZE = 16U * 1024U;  ///< Initial size of the constants memory, unless reserved otherwise.
+    std::size_t const INTEGERS_MEM_SIZE  = 32U * 1024U;  ///< Initial size of the integers memory, unless reserved otherwise.
+    std::size_t const FLOATS_MEM_SIZE    = 42U * 1024U;  ///< Initial size of the floats memory, unless reserved otherwise.
 
     struct memHeader
     {
@@ -41,6 +43,15 @@ namespace jiminy
         bool_t isRegisteringAvailable;  ///< True if registering is available, false otherwise.
     };
 
+    struct telemetryGroup_t
+    {
+        std::string name;                        ///< Name of the group.
+        uint32_t decimation;                     ///< Number of snapshots between two records of the group.
+        std::vector<std::string> fieldnames;     ///< Names, or prefixes of names, of the variables of the group.
+        std::vector<int32_t> integersPositions;  ///< Positions of the integer variables of the group. Set when locking the registration.
+        std::vector<int32_t> floatsPositions;    ///< Positions of the float variables of the group. Set when locking the registration.
+    };
+
     class MemoryBuffer
     {
     public:
@@ -100,6 +111,29 @@ namespace jiminy
             return hresult_t::SUCCESS;
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        /// \brief       Change the size of the memory.
+        /// \details     The content is preserved up to the lesser of the new
+        ///              and old sizes. The memory is left untouched on failure.
+        ///
+        /// \param  size  New size of the memory in bytes.
+        ///////////////////////////////////////////////////////////////////////
+        hresult_t resize(std::size_t size)
+        {
+            void * const memAddress = realloc(memAddress_, size);
+
+            if (memAddress == nullptr)
+            {
+                std::cout << "Error - MemoryBuffer::resize - Memory reallocation for the memory '" << name_ << "' failed." << std::endl;
+                return hresult_t::ERROR_GENERIC;
+            }
+
+            memAddress_ = memAddress;
+            size_ = size;
+
+            return hresult_t::SUCCESS;
+        };
+
         ///////////////////////////////////////////////////////////////////////
         /// \brief       Getter on the mapped shm.
         ///
@@ -135,18 +169,77 @@ namespace jiminy
         ////////////////////////////////////////////////////////////////////////
         void reset(void);
 
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Reserve the memory of the telemetry buffers up front.
+        /// \details The buffers grow on demand while registering, so it only avoids
+        ///          reallocations. The memory of the variables is split evenly
+        ///          between the names and the data. Reserved sizes are preserved
+        ///          when resetting the telemetry.
+        ///
+        /// \param[in] constantsMemSize  Size of the constants memory in bytes.
+        /// \param[in] integersMemSize   Size of the integers memory in bytes.
+        /// \param[in] floatsMemSize     Size of the floats memory in bytes.
+        ///
+        /// \return S_OK if successful, the corresponding telemetry error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t reserve(std::size_t const & constantsMemSize,
+                          std::size_t const & integersMemSize,
+                          std::size_t const & floatsMemSize);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Register a rate group, whose variables are recorded separately
+        ///        from the others and less often.
+        /// \details A variable belongs to the first group having a fieldname being
+        ///          a prefix of its name. It is resolved when locking the registration,
+        ///          so the groups are preserved when resetting the telemetry.
+        ///
+        /// \param[in] groupName   Name of the group.
+        /// \param[in] decimation  Number of snapshots between two records of the group.
+        /// \param[in] fieldnames  Names, or prefixes of names, of the variables of the group.
+        ///
+        /// \return S_OK if successful, the corresponding telemetry error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t registerGroup(std::string              const & groupName,
+                                uint32_t                 const & decimation,
+                                std::vector<std::string> const & fieldnames);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Remove every rate group.
+        ////////////////////////////////////////////////////////////////////////
+        void removeGroups(void);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the rate groups. The positions of their variables are only
+        ///        available once the registration is locked.
+        ////////////////////////////////////////////////////////////////////////
+        std::vector<telemetryGroup_t> const & getGroups(void) const;
+
         ////////////////////////////////////////////////////////////////////////
         /// \brief Register a new variable in for telemetry.
         /// \warning The only supported types are int32_t and float32_t.
         ///
+        /// \details The memory may be reallocated while registering, so that the
+        ///          variable is identified by its position in the data section
+        ///          rather than by its address.
+        ///
         /// \param[in]  variableNameIn       Name of the variable to register.
-        /// \param[out] positionInBufferOut  Pointer on the allocated buffer that will hold the variable.
+        /// \param[out] positionInBufferOut  Position of the variable in the data section.
         ///
         /// \return S_OK if successful, the corresponding telemetry error otherwise.
         ////////////////////////////////////////////////////////////////////////
         template <typename T>
-        hresult_t registerVariable(std::string const   & variableNameIn,
-                                   T                 * & positionInBufferOut);
+        hresult_t registerVariable(std::string const & variableNameIn,
+                                   int32_t           & positionInBufferOut);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Get the current address of the data section of a given type.
+        /// \warning The only supported types are int32_t and float32_t.
+        ///          The address is invalidated by any registration.
+        ///
+        /// \return Pointer to the first variable of the data section.
+        ////////////////////////////////////////////////////////////////////////
+        template <typename T>
+        T * getDataSection(void);
 
         ////////////////////////////////////////////////////////////////////////
         /// \brief Register a constant for the telemetry.
@@ -163,12 +256,17 @@ namespace jiminy
         /// \brief Format the telemetry header with the current recorded informations.
         /// \warning Calling this method will disable further registrations.
         ///
+        /// \details The memory is shrunk to the size actually used, so that the
+        ///          data sections are fixed afterward. The variables of the rate
+        ///          groups are resolved and recorded as constants beforehand.
+        ///
         /// \param[out] header  header to populate.
         ////////////////////////////////////////////////////////////////////////
-        void formatHeader(std::vector<char_t> & header) const;
+        void formatHeader(std::vector<char_t> & header);
 
         ////////////////////////////////////////////////////////////////////////
         /// \brief Get data information to use them.
+        /// \warning The addresses are only valid once the registration is locked.
         ///
         /// \param[out] intAddrOut    Pointer on the int data array.
         /// \param[out] intSize       Size of the int data array.
@@ -185,19 +283,55 @@ namespace jiminy
         /// \brief Register a new variable in for telemetry.
         ///
         /// \param[in]  header               Shared memory header where the variable shall be recorded to.
+        ///                                  It is updated if the memory is reallocated.
         /// \param[in]  variableNameIn       Name of the variable to register.
-        /// \param[out] positionInBufferOut  Pointer on the allocated buffer that will hold the variable.
+        /// \param[out] positionInBufferOut  Position of the variable in the data section.
         ///
         /// \return S_OK if successful, the corresponding telemetry error otherwise.
         ////////////////////////////////////////////////////////////////////////
         template <typename T>
-        hresult_t internalRegisterVariable(struct memHeader       *   header,
+        hresult_t internalRegisterVariable(struct memHeader       * & header,
                                            std::string      const   & variableNameIn,
-                                           T                      * & positionInBufferOut);
+                                           int32_t                  & positionInBufferOut);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Make sure there is enough space left to record a new entry.
+        /// \details The capacity of the sections too small is doubled until the
+        ///          entry fits, which reallocates the memory.
+        ///
+        /// \param header     Pointer to the shared memory header. It is updated if
+        ///                   the memory is reallocated.
+        /// \param nameSize   Size in bytes of the name of the entry, null-terminated.
+        /// \param dataSize   Size in bytes of the data of the entry.
+        ///
+        /// \return S_OK if successful, the corresponding telemetry error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t reserveEntry(struct memHeader       * & header,
+                               int64_t          const   & nameSize,
+                               int64_t          const   & dataSize);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Reallocate a shared memory with given capacities for its sections.
+        /// \details The entries already recorded are preserved, so the capacities
+        ///          must not be smaller than the sizes actually used.
+        ///
+        /// \param header        Pointer to the shared memory header. It is updated if
+        ///                      the memory is reallocated.
+        /// \param nameCapacity  Size in bytes of the naming section.
+        /// \param dataCapacity  Size in bytes of the data section.
+        ///
+        /// \return S_OK if successful, the corresponding telemetry error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t resizeMemory(struct memHeader       * & header,
+                               int64_t          const   & nameCapacity,
+                               int64_t          const   & dataCapacity);
 
         ////////////////////////////////////////////////////////////////////////
         /// \brief Search for an already registered entry into the shared memory.
         ///
+        /// \details The lookup is done in the hash index of the entries of the
+        ///          memory, instead of scanning the packed naming section.
+        ///
         /// \param header   Pointer to the shared memory header where to search for the entry.
         /// \param name     Name for the entry to search for.
         ///
@@ -206,6 +340,20 @@ namespace jiminy
         int32_t findEntry(struct memHeader       * header,
                           std::string      const & name);
 
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Add an entry to the hash index of a shared memory.
+        ///
+        /// \param header   Pointer to the shared memory header where the entry is recorded.
+        /// \param name     Name of the entry.
+        ///
+        /// \return The position of the entry.
+        ////////////////////////////////////////////////////////////////////////
+        int32_t addEntry(struct memHeader       * header,
+                         std::string      const & name);
+
+        std::unordered_map<std::string, int32_t> & getEntriesIndex(struct memHeader * header);
+        MemoryBuffer & getMemory(struct memHeader * header);
+
         MemoryBuffer constantsMem_;            ///< Memory to handle constants
         struct memHeader * constantsHeader_;   ///< Header of the constants
 
@@ -215,8 +363,18 @@ namespace jiminy
         MemoryBuffer floatsMem_;               ///< Memory to handle floats variables
         struct memHeader * floatsHeader_;      ///< Header of the floats
 
-        /// Local cache to avoid searching into the memory
-        std::unordered_map<std::string, void *> entriesMap_;
+        /// Position of the entries in the naming section of each memory, by name
+        std::unordered_map<std::string, int32_t> constantsIndex_;
+        std::unordered_map<std::string, int32_t> integersIndex_;
+        std::unordered_map<std::string, int32_t> floatsIndex_;
+
+        /// Rate groups, whose variables are recorded separately
+        std::vector<telemetryGroup_t> groups_;
+
+        /// Size of each memory when resetting the telemetry
+        std::size_t constantsMemSize_;
+        std::size_t integersMemSize_;
+        std::size_t floatsMemSize_;
     };
 } // namespace jiminy
 
@@ -14,27 +14,17 @@
 namespace jiminy
 {
     template <typename T>
-    hresult_t TelemetryData::internalRegisterVariable(struct memHeader       *   header,
+    hresult_t TelemetryData::internalRegisterVariable(struct memHeader       * & header,
                                                       std::string      const   & variableName,
-                                                      T                      * & positionInBufferOut)
+                                                      int32_t                  & positionInBufferOut)
     {
-        char_t * const memAddress = reinterpret_cast<char_t*>(header);
-
-        // Check in local cache
-        auto entry = entriesMap_.find(variableName);
-        if (entry != entriesMap_.end())
-        {
-            positionInBufferOut = static_cast<T*>(entry->second);
-            return hresult_t::SUCCESS;
-        }
+        hresult_t returnCode = hresult_t::SUCCESS;
 
         // Check in memory
-        int32_t positionInBuffer = findEntry(header, variableName);
+        int32_t const positionInBuffer = findEntry(header, variableName);
         if (positionInBuffer != -1)
         {
-            char_t * address = memAddress + header->startDataSection + sizeof(T) * static_cast<uint32_t>(positionInBuffer);
-            entriesMap_[variableName] = static_cast<void*>(address);
-            positionInBufferOut = static_cast<T*>(entriesMap_[variableName]);
+            positionInBufferOut = positionInBuffer;
             return hresult_t::SUCCESS;
         }
 
@@ -44,23 +34,38 @@ namespace jiminy
             return hresult_t::ERROR_GENERIC;
         }
 
-        if ((header->nextFreeNameOffset + static_cast<int64_t>(variableName.size()) + 1) >= header->startDataSection)
+        // Grow the memory if necessary. The header is updated accordingly.
+        returnCode = reserveEntry(header, static_cast<int64_t>(variableName.size()) + 1, sizeof(T));
+
+        if (returnCode == hresult_t::SUCCESS)
         {
-            std::cout << "Error - TelemetryData::updateValue - Unspecified error." << std::endl; //TODO: write an appropriate error message
-            return hresult_t::ERROR_GENERIC;
+            char_t * const memAddress = reinterpret_cast<char_t*>(header);
+            char_t * const namePos = memAddress + header->nextFreeNameOffset; // Compute record address
+            memcpy(namePos, variableName.data(), variableName.size());
+            namePos[variableName.size()] = '\0';
+            header->nextFreeNameOffset += variableName.size();
+            header->nextFreeNameOffset += 1U; // Null-terminated.
+
+            // The variables are stored in order of registration in the data section
+            positionInBufferOut = addEntry(header, variableName);
+            header->nextFreeDataOffset += sizeof(T);
         }
 
-        char_t * const namePos = memAddress + header->nextFreeNameOffset; // Compute record address
-        memcpy(namePos, variableName.data(), variableName.size());
-        header->nextFreeNameOffset += variableName.size();
-        header->nextFreeNameOffset += 1U; // Null-terminated.
+        return returnCode;
+    }
 
-        char_t * const dataPos = memAddress + header->nextFreeDataOffset;
-        entriesMap_[variableName] = static_cast<void*>(dataPos);
-        positionInBufferOut = static_cast<T*>(entriesMap_[variableName]);
-        header->nextFreeDataOffset += sizeof(T);
+    template<>
+    inline int32_t * TelemetryData::getDataSection<int32_t>(void)
+    {
+        return reinterpret_cast<int32_t *>(
+            reinterpret_cast<char_t *>(integersHeader_) + integersHeader_->startDataSection);
+    }
 
-        return hresult_t::SUCCESS;
+    template<>
+    inline float32_t * TelemetryData::getDataSection<float32_t>(void)
+    {
+        return reinterpret_cast<float32_t *>(
+            reinterpret_cast<char_t *>(floatsHeader_) + floatsHeader_->startDataSection);
     }
 } // namespace jiminy
 
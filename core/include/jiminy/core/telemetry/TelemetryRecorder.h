@@ -9,11 +9,11 @@
 #define JIMINY_TELEMETRY_RECORDER_H
 
 #include "jiminy/core/io/MemoryDevice.h"
+#include "jiminy/core/telemetry/TelemetryData.h"
 
 
 namespace jiminy
 {
-    class TelemetryData;
 
     ////////////////////////////////////////////////////////////////////////
     /// \class TelemetryRecorder
@@ -32,9 +32,20 @@ namespace jiminy
         /// \param[in] telmetryData Data to log.
         /// \param[in] timeUnit Unit with which the time will be logged
         ///                     (note that time is logged as an int).
+        /// \param[in] recordedBytesMax Memory budget of the recorded data, in bytes.
+        ///                             If positive, only the most recent snapshots
+        ///                             fitting in it are kept (flight recorder mode).
         ////////////////////////////////////////////////////////////////////////
         hresult_t initialize(TelemetryData       * telemetryData,
-                             float64_t     const & timeLoggingPrecision);
+                             float64_t     const & timeLoggingPrecision,
+                             int64_t       const & recordedBytesMax = 0);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Initialize the recorder again, keeping the header and the memory
+        ///        of the previous initialization, but clearing the recorded data.
+        /// \warning The layout of the telemetry data must be unchanged since then.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t restart(void);
 
         bool_t const & getIsInitialized(void);
 
@@ -49,6 +60,8 @@ namespace jiminy
 
         ////////////////////////////////////////////////////////////////////////
         /// \brief Create a new line in the record with the current telemetry data.
+        /// \details The variables of each rate group are recorded in a separate
+        ///          line, once every 'decimation' snapshots.
         ////////////////////////////////////////////////////////////////////////
         hresult_t flushDataSnapshot(float64_t const & timestamp);
 
@@ -56,6 +69,12 @@ namespace jiminy
         /// \brief Get access to the memory device holding the data
         ////////////////////////////////////////////////////////////////////////
         hresult_t writeDataBinary(std::string const & filename);
+
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief Parse the recorded data.
+        /// \details The lines of the rate groups are merged with the main ones,
+        ///          holding the last recorded value of their variables.
+        ////////////////////////////////////////////////////////////////////////
         static void getData(std::vector<std::string>                   & header,
                             std::vector<float64_t>                     & timestamps,
                             std::vector<std::vector<int32_t> >         & intData,
@@ -74,11 +93,28 @@ namespace jiminy
         /// \brief   Create a new file to continue the recording.
         /// \details Each chunk shall have a size defined by LARGE_LOG_SIZE_GB and shall
         ///          be suffixed by an increasing natural number.
+        ///          In flight recorder mode, the oldest chunk of data is recycled
+        ///          instead once the memory budget is reached.
         ///
         /// \return  SUCCESS if successful, the corresponding telemetry error otherwise.
         ////////////////////////////////////////////////////////////////////////
         hresult_t createNewChunk();
 
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief   Write a line gathering only some of the variables.
+        ///
+        /// \param[in] groupIdx           Index of the rate group, -1 for the main line.
+        /// \param[in] time               Time of the line, in time unit.
+        /// \param[in] integersPositions  Positions of the integer variables to write.
+        /// \param[in] floatsPositions    Positions of the float variables to write.
+        ///
+        /// \return  SUCCESS if successful, the corresponding telemetry error otherwise.
+        ////////////////////////////////////////////////////////////////////////
+        hresult_t writeLine(int32_t              const & groupIdx,
+                            int32_t              const & time,
+                            std::vector<int32_t> const & integersPositions,
+                            std::vector<int32_t> const & floatsPositions);
+
     private:
         ///////////////////////////////////////////////////////////////////////
         /// Private attributes
@@ -89,8 +125,10 @@ namespace jiminy
 
         int64_t recordedBytesLimits_;
         int64_t recordedBytesDataLine_;
+        int64_t recordedBytesLineMax_;      ///< Size in bytes of the largest line, rate groups included.
         int64_t recordedBytes_;             ///< Bytes recorded in the file.
         int64_t headerSize_;                ///< Size in byte of the header.
+        int64_t recordedBytesMax_;          ///< Memory budget of the recorded data in flight recorder mode, 0 if unbounded.
 
         char_t const * integersAddress_;    ///< Address of the integer data section.
         int64_t integerSectionSize_;        ///< Size in bytes of the integer data section.
@@ -98,6 +136,12 @@ namespace jiminy
         char_t const * floatsAddress_;      ///< Address of the float data section.
         int64_t floatSectionSize_;          ///< Size in byte of the float data section.
         float64_t timeLoggingPrecision_;    ///< Precision to use when logging the time.
+
+        std::vector<telemetryGroup_t> groups_;   ///< Rate groups, recorded separately.
+        std::vector<uint32_t> groupsCounters_;   ///< Number of snapshots since the last record of each rate group.
+        std::vector<int32_t> integersPositions_; ///< Positions of the integer variables not in any rate group.
+        std::vector<int32_t> floatsPositions_;   ///< Positions of the float variables not in any rate group.
+        std::vector<char_t> lineBuffer_;         ///< Buffer used to gather the variables of a line.
     };
 }
 
@@ -88,6 +88,13 @@ namespace jiminy
         ///////////////////////////////////////////////////////////////////////
         std::string const & getObjectName(void) const;
 
+        ////////////////////////////////////////////////////////////////////////
+        /// \brief     Get the telemetry data to which the object is configured.
+        ///
+        /// \return    Shared pointer to the telemetry instance, nullptr if not configured.
+        ///////////////////////////////////////////////////////////////////////
+        std::shared_ptr<TelemetryData> const & getTelemetryData(void) const;
+
         ////////////////////////////////////////////////////////////////////////
         /// \brief     Add an invariant header entry in the log file.
         ///
@@ -105,10 +112,10 @@ namespace jiminy
 
     private:
         std::shared_ptr<TelemetryData> telemetryData_;
-        /// \brief Associate int32_t variable position to their ID.
-        std::unordered_map<std::string, int32_t *> intBufferPosition_;
-        /// \brief Associate float32_t variable position to their ID.
-        std::unordered_map<std::string, float32_t *> floatBufferPosition_;
+        /// \brief Associate int32_t variable position in the data section to their ID.
+        std::unordered_map<std::string, int32_t> intBufferPosition_;
+        /// \brief Associate float32_t variable position in the data section to their ID.
+        std::unordered_map<std::string, int32_t> floatBufferPosition_;
     };
 } // End of jiminy namespace
 
@@ -10,6 +10,7 @@ namespace jiminy
     std::string const TELEMETRY_DELIMITER = ".";
     float64_t const TELEMETRY_DEFAULT_TIME_UNIT = 1e6; // Log the time rounded to the closest µs
     int64_t const TELEMETRY_MAX_BUFFER_SIZE = 256U * 1024U; // 256Ko
+    int64_t const TELEMETRY_FLIGHT_RECORDER_CHUNKS = 8; // At least 7/8 of the memory budget is holding data
 
     uint8_t const DELAY_MIN_BUFFER_RESERVE = 20U;
     uint8_t const DELAY_MAX_BUFFER_EXCEED = 20U;
@@ -18,4 +19,8 @@ namespace jiminy
     float64_t const SIMULATION_MAX_TIMESTEP = 5e-3;
     float64_t const SIMULATION_INITIAL_TIMESTEP = 1e-4;
     float64_t const STEPPER_MIN_TIMESTEP = 1e-10;
+
+    uint8_t const COLLISION_CYLINDER_RIM_POINTS = 8U;
+
+    uint32_t const MODEL_CACHE_VERSION = 2U;
 }
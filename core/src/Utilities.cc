@@ -3,6 +3,7 @@
 #include <numeric>     /* iota */
 #include <stdlib.h>     /* srand, rand */
 #include <random>
+#include <sstream>
 
 #ifndef _WIN32
 #include <pwd.h>
@@ -13,7 +14,13 @@
 #include <stdio.h>
 #endif
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
+
 #include "pinocchio/multibody/model.hpp"
+#include "pinocchio/serialization/eigen.hpp"
 #include "pinocchio/algorithm/frames.hpp"
 #include "pinocchio/algorithm/joint-configuration.hpp"
 
@@ -281,13 +288,7 @@ namespace jiminy
     template<>
     heatMapFunctor_t convertFromJson<heatMapFunctor_t>(Json::Value const & value)
     {
-        return {
-            heatMapFunctor_t(
-                [](vector3_t const & pos) -> std::pair <float64_t, vector3_t>
-                {
-                    return {0.0, (vector3_t() << 0.0, 0.0, 1.0).finished()};
-                })
-        };
+        return {heatMapFunctor_t(flatGround)};
     }
 
     template<>
@@ -414,58 +415,318 @@ namespace jiminy
         return returnCode;
     }
 
+    // ************** Binary serialization utilities ****************
+
+    namespace
+    {
+        void saveConfigHolder(boost::archive::binary_oarchive       & ar,
+                              configHolder_t                  const & config);
+
+        class SaveBoostVariantToBinary : public boost::static_visitor<>
+        {
+        public:
+            SaveBoostVariantToBinary(boost::archive::binary_oarchive & ar) :
+            ar_(ar)
+            {
+                // Empty on purpose
+            }
+
+            ~SaveBoostVariantToBinary(void) = default;
+
+            template <typename T>
+            void operator()(T const & value)
+            {
+                ar_ << value;
+            }
+
+            void operator()(heatMapFunctor_t const & value)
+            {
+                // Only the default flat ground is supported, since arbitrary functions cannot be serialized
+                auto const * const heatMapFct = value.target<decltype(&flatGround)>();
+                if (!heatMapFct || *heatMapFct != &flatGround)
+                {
+                    throw std::runtime_error("Custom heat map functors are not supported.");
+                }
+            }
+
+            void operator()(flexibilityConfig_t const & value)
+            {
+                ar_ << value.size();
+                for (flexibleJointData_t const & flexibleJoint : value)
+                {
+                    ar_ << flexibleJoint.jointName;
+                    ar_ << flexibleJoint.stiffness;
+                    ar_ << flexibleJoint.damping;
+                }
+            }
+
+            void operator()(configHolder_t const & value)
+            {
+                saveConfigHolder(ar_, value);
+            }
+
+        private:
+            boost::archive::binary_oarchive & ar_;
+        };
+
+        void saveConfigHolder(boost::archive::binary_oarchive       & ar,
+                              configHolder_t                  const & config)
+        {
+            SaveBoostVariantToBinary visitor(ar);
+            ar << config.size();
+            for (auto const & option : config)
+            {
+                int32_t const which = option.second.which();
+                ar << option.first;
+                ar << which;
+                boost::apply_visitor(visitor, option.second);
+            }
+        }
+
+        template<typename T>
+        void loadConfigField(boost::archive::binary_iarchive & ar,
+                             configField_t                   & field)
+        {
+            T value;
+            ar >> value;
+            field = std::move(value);
+        }
+
+        void loadConfigHolder(boost::archive::binary_iarchive & ar,
+                              configHolder_t                  & config)
+        {
+            std::size_t size;
+            ar >> size;
+            for (std::size_t i = 0; i < size; i++)
+            {
+                std::string key;
+                int32_t which;
+                ar >> key;
+                ar >> which;
+                configField_t & field = config[key];
+
+                // The indices must follow the order of the types of configField_t
+                switch (which)
+                {
+                case 0:
+                    loadConfigField<bool_t>(ar, field);
+                    break;
+                case 1:
+                    loadConfigField<uint32_t>(ar, field);
+                    break;
+                case 2:
+                    loadConfigField<int32_t>(ar, field);
+                    break;
+                case 3:
+                    loadConfigField<float64_t>(ar, field);
+                    break;
+                case 4:
+                    loadConfigField<std::string>(ar, field);
+                    break;
+                case 5:
+                    loadConfigField<vectorN_t>(ar, field);
+                    break;
+                case 6:
+                    loadConfigField<matrixN_t>(ar, field);
+                    break;
+                case 7:
+                    field = heatMapFunctor_t(flatGround);
+                    break;
+                case 8:
+                    loadConfigField<std::vector<std::string> >(ar, field);
+                    break;
+                case 9:
+                    loadConfigField<std::vector<vectorN_t> >(ar, field);
+                    break;
+                case 10:
+                    loadConfigField<std::vector<matrixN_t> >(ar, field);
+                    break;
+                case 11:
+                {
+                    std::size_t flexibilityConfigSize;
+                    ar >> flexibilityConfigSize;
+                    flexibilityConfig_t flexibilityConfig(flexibilityConfigSize);
+                    for (flexibleJointData_t & flexibleJoint : flexibilityConfig)
+                    {
+                        ar >> flexibleJoint.jointName;
+                        ar >> flexibleJoint.stiffness;
+                        ar >> flexibleJoint.damping;
+                    }
+                    field = std::move(flexibilityConfig);
+                    break;
+                }
+                case 12:
+                {
+                    configHolder_t subConfig;
+                    loadConfigHolder(ar, subConfig);
+                    field = std::move(subConfig);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Unknown type of option.");
+                }
+            }
+        }
+    }
+
+    hresult_t binaryDump(configHolder_t const & config,
+                         std::string          & data)
+    {
+        std::ostringstream stream;
+        try
+        {
+            boost::archive::binary_oarchive ar(stream, boost::archive::no_header);
+            saveConfigHolder(ar, config);
+        }
+        catch (std::exception const & e)
+        {
+            std::cout << "Error - binaryDump - Impossible to serialize the configuration. " << e.what() << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        data = stream.str();
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t binaryLoad(configHolder_t       & config,
+                         std::string    const & data)
+    {
+        try
+        {
+            std::istringstream stream(data);
+            boost::archive::binary_iarchive ar(stream, boost::archive::no_header);
+            config.clear();
+            loadConfigHolder(ar, config);
+        }
+        catch (std::exception const &)
+        {
+            std::cout << "Error - binaryLoad - Impossible to load the configuration. The data are corrupted." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     // ***************** Random number generator *****************
     // Based on Ziggurat generator by Marsaglia and Tsang (JSS, 2000)
 
-    std::mt19937 generator_;
-    std::uniform_real_distribution<float32_t> distUniform_(0.0,1.0);
+    namespace
+    {
+        struct zigguratTables_t
+        {
+            uint32_t kn[128];
+            float32_t fn[128];
+            float32_t wn[128];
+
+            zigguratTables_t(void) :
+            kn(),
+            fn(),
+            wn()
+            {
+                float64_t const m1 = 2147483648.0;
+                float64_t const vn = 9.91256303526217e-03;
+                float64_t dn = 3.442619855899;
+                float64_t tn = 3.442619855899;
 
-    uint32_t kn[128];
-    float32_t fn[128];
-    float32_t wn[128];
+                float64_t q = vn / exp (-0.5 * dn * dn);
 
-    void r4_nor_setup(void)
-    {
-        float64_t const m1 = 2147483648.0;
-        float64_t const vn = 9.91256303526217e-03;
-        float64_t dn = 3.442619855899;
-        float64_t tn = 3.442619855899;
+                kn[0] = static_cast<uint32_t>((dn / q) * m1);
+                kn[1] = 0;
 
-        float64_t q = vn / exp (-0.5 * dn * dn);
+                wn[0] = static_cast<float32_t>(q / m1);
+                wn[127] = static_cast<float32_t>(dn / m1);
 
-        kn[0] = static_cast<uint32_t>((dn / q) * m1);
-        kn[1] = 0;
+                fn[0] = 1.0f;
+                fn[127] = static_cast<float32_t>(exp(-0.5 * dn * dn));
 
-        wn[0] = static_cast<float32_t>(q / m1);
-        wn[127] = static_cast<float32_t>(dn / m1);
+                for (uint8_t i=126; 1 <= i; i--)
+                {
+                    dn = sqrt (-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+                    kn[i+1] = static_cast<uint32_t>((dn / tn) * m1);
+                    tn = dn;
+                    fn[i] = static_cast<float32_t>(exp(-0.5 * dn * dn));
+                    wn[i] = static_cast<float32_t>(dn / m1);
+                }
+            }
+        };
 
-        fn[0] = 1.0f;
-        fn[127] = static_cast<float32_t>(exp(-0.5 * dn * dn));
+        // The tables are constant, thus they can be shared safely between threads
+        zigguratTables_t const zigguratTables_;
 
-        for (uint8_t i=126; 1 <= i; i--)
+        // Finalizer of SplitMix64 (Steele et al., OOPSLA 2014)
+        uint64_t mix64(uint64_t z)
         {
-            dn = sqrt (-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
-            kn[i+1] = static_cast<uint32_t>((dn / tn) * m1);
-            tn = dn;
-            fn[i] = static_cast<float32_t>(exp(-0.5 * dn * dn));
-            wn[i] = static_cast<float32_t>(dn / m1);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
         }
+
+        // Default stream of the free functions
+        thread_local RandomStream generator_;
+    }
+
+    RandomStream::RandomStream(uint32_t const & seed,
+                               uint64_t const & streamId) :
+    key_(0U),
+    counter_(0U)
+    {
+        this->seed(seed, streamId);
     }
 
-    float32_t r4_uni(void)
+    RandomStream::RandomStream(uint32_t    const & seed,
+                               std::string const & streamName) :
+    RandomStream(seed, getStreamId(streamName))
     {
-        return distUniform_(generator_);
+        // Empty on purpose
     }
 
-    float32_t r4_nor(void)
+    void RandomStream::seed(uint32_t const & seed,
+                            uint64_t const & streamId)
     {
+        key_ = mix64(mix64(static_cast<uint64_t>(seed)) ^ streamId);
+        counter_ = 0U;
+    }
+
+    void RandomStream::seed(uint32_t    const & seed,
+                            std::string const & streamName)
+    {
+        this->seed(seed, getStreamId(streamName));
+    }
+
+    void RandomStream::setCounter(uint64_t const & counter)
+    {
+        counter_ = counter;
+    }
+
+    uint64_t const & RandomStream::getCounter(void) const
+    {
+        return counter_;
+    }
+
+    uint32_t RandomStream::operator()(void)
+    {
+        return static_cast<uint32_t>(mix64(key_ + (++counter_) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    float32_t RandomStream::uniform(void)
+    {
+        // Uniform in ]0, 1[, using the 24 most significant bits
+        return (static_cast<float32_t>((*this)() >> 8) + 0.5f) * 5.9604644775390625e-8f;
+    }
+
+    float32_t RandomStream::normal(void)
+    {
+        uint32_t const * const kn = zigguratTables_.kn;
+        float32_t const * const fn = zigguratTables_.fn;
+        float32_t const * const wn = zigguratTables_.wn;
+
         float32_t const r = 3.442620f;
         int32_t hz;
         uint32_t iz;
         float32_t x;
         float32_t y;
 
-        hz = static_cast<int32_t>(generator_());
+        hz = static_cast<int32_t>((*this)());
         iz = (hz & 127U);
 
         if (fabs(hz) < kn[iz])
@@ -480,8 +741,8 @@ namespace jiminy
                 {
                     while (true)
                     {
-                        x = - 0.2904764f * log(r4_uni());
-                        y = - log(r4_uni());
+                        x = - 0.2904764f * log(uniform());
+                        y = - log(uniform());
                         if (x * x <= y + y)
                         {
                             break;
@@ -500,12 +761,12 @@ namespace jiminy
 
                 x = static_cast<float32_t>(hz) * wn[iz];
 
-                if (fn[iz] + r4_uni() * (fn[iz-1] - fn[iz]) < exp (-0.5f * x * x))
+                if (fn[iz] + uniform() * (fn[iz-1] - fn[iz]) < exp (-0.5f * x * x))
                 {
                     return x;
                 }
 
-                hz = static_cast<int32_t>(generator_());
+                hz = static_cast<int32_t>((*this)());
                 iz = (hz & 127);
 
                 if (fabs(hz) < kn[iz])
@@ -516,37 +777,28 @@ namespace jiminy
         }
     }
 
-    // ************** Random number generator utilities ****************
-
-	void resetRandGenerators(uint32_t const & seed)
-	{
-		srand(seed); // Eigen relies on srand for genering random matrix
-        generator_.seed(seed);
-        r4_nor_setup();
-	}
-
-	float64_t randUniform(float64_t const & lo,
-	                      float64_t const & hi)
+    float64_t RandomStream::uniform(float64_t const & lo,
+                                    float64_t const & hi)
     {
-        return lo + r4_uni() * (hi - lo);
+        return lo + uniform() * (hi - lo);
     }
 
-	float64_t randNormal(float64_t const & mean,
-	                     float64_t const & std)
+    float64_t RandomStream::normal(float64_t const & mean,
+                                   float64_t const & std)
     {
-        return mean + r4_nor() * std;
+        return mean + normal() * std;
     }
 
-    vectorN_t randVectorNormal(uint32_t  const & size,
-                               float64_t const & mean,
-                               float64_t const & std)
+    vectorN_t RandomStream::normal(uint32_t  const & size,
+                                   float64_t const & mean,
+                                   float64_t const & std)
     {
         if (std > 0.0)
         {
             return vectorN_t::NullaryExpr(size,
-            [&mean, &std] (vectorN_t::Index const &) -> float64_t
+            [this, &mean, &std] (vectorN_t::Index const &) -> float64_t
             {
-                return randNormal(mean, std);
+                return normal(mean, std);
             });
         }
         else
@@ -555,29 +807,110 @@ namespace jiminy
         }
     }
 
+    vectorN_t RandomStream::normal(vectorN_t const & mean,
+                                   vectorN_t const & std)
+    {
+        return vectorN_t::NullaryExpr(std.size(),
+        [this, &mean, &std] (vectorN_t::Index const & i) -> float64_t
+        {
+            return normal(mean[i], std[i]);
+        });
+    }
+
+    vectorN_t RandomStream::normal(vectorN_t const & std)
+    {
+        return vectorN_t::NullaryExpr(std.size(),
+        [this, &std] (vectorN_t::Index const & i) -> float64_t
+        {
+            return normal(0.0, std[i]);
+        });
+    }
+
+    uint64_t computeHash(std::string const & data,
+                         uint64_t    const & seed)
+    {
+        // FNV-1a hash, which does not depend on the implementation of the standard library
+        uint64_t hash = seed;
+        for (char const & c : data)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    uint64_t computeHash(std::vector<std::string> const & data,
+                         uint64_t                 const & seed)
+    {
+        // The strings are null-terminated, so that the way they are split matters
+        uint64_t hash = seed;
+        for (std::string const & str : data)
+        {
+            hash = computeHash(str, hash);
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    uint64_t getStreamId(std::string const & streamName)
+    {
+        return computeHash(streamName);
+    }
+
+    // ************** Random number generator utilities ****************
+
+    void resetRandGenerators(uint32_t const & seed)
+    {
+        srand(seed); // Eigen relies on srand for genering random matrix
+        generator_.seed(seed, 0U);
+    }
+
+    float64_t randUniform(float64_t const & lo,
+                          float64_t const & hi)
+    {
+        return generator_.uniform(lo, hi);
+    }
+
+    float64_t randNormal(float64_t const & mean,
+                         float64_t const & std)
+    {
+        return generator_.normal(mean, std);
+    }
+
     vectorN_t randVectorNormal(uint32_t  const & size,
+                               float64_t const & mean,
                                float64_t const & std)
     {
-        return randVectorNormal(size, 0, std);
+        return generator_.normal(size, mean, std);
+    }
+
+    vectorN_t randVectorNormal(uint32_t  const & size,
+                               float64_t const & std)
+    {
+        return generator_.normal(size, 0.0, std);
     }
 
     vectorN_t randVectorNormal(vectorN_t const & mean,
                                vectorN_t const & std)
     {
-        return vectorN_t::NullaryExpr(std.size(),
-        [&mean, &std] (vectorN_t::Index const & i) -> float64_t
-        {
-            return randNormal(mean[i], std[i]);
-        });
+        return generator_.normal(mean, std);
     }
 
     vectorN_t randVectorNormal(vectorN_t const & std)
     {
-        return vectorN_t::NullaryExpr(std.size(),
-        [&std] (vectorN_t::Index const & i) -> float64_t
-        {
-            return randNormal(0, std[i]);
-        });
+        return generator_.normal(std);
+    }
+
+    // ********************** Time utilities ************************
+
+    int64_t timeToTick(float64_t const & t)
+    {
+        return static_cast<int64_t>(std::round(t / STEPPER_MIN_TIMESTEP));
+    }
+
+    float64_t tickToTime(int64_t const & tick)
+    {
+        return static_cast<float64_t>(tick) * STEPPER_MIN_TIMESTEP;
     }
 
     // ******************* Telemetry utilities **********************
@@ -1431,4 +1764,9 @@ namespace jiminy
             xIdx += xSize;
         }
     }
+
+    std::pair<float64_t, vector3_t> flatGround(vector3_t const & /* pos */)
+    {
+        return {0.0, vector3_t::UnitZ()};
+    }
 }
@@ -137,6 +137,32 @@ namespace jiminy
         return returnCode;
     }
 
+    void AbstractController::resumeTelemetry(void)
+    {
+        if (baseControllerOptions_->telemetryEnable)
+        {
+            isTelemetryConfigured_ = true;
+        }
+    }
+
+    uint64_t AbstractController::getTelemetryFingerprint(void) const
+    {
+        uintptr_t const telemetryDataAddress = reinterpret_cast<uintptr_t>(
+            telemetrySender_.getTelemetryData().get());
+        uint64_t fingerprint = computeHash(std::vector<std::string>{
+            std::to_string(baseControllerOptions_->telemetryEnable),
+            std::to_string(telemetryDataAddress)});
+        for (std::pair<std::string, float64_t const *> const & registeredVariable : registeredVariables_)
+        {
+            fingerprint = computeHash(registeredVariable.first + TELEMETRY_DELIMITER, fingerprint);
+        }
+        for (std::pair<std::string, std::string> const & registeredConstant : registeredConstants_)
+        {
+            fingerprint = computeHash(std::vector<std::string>{registeredConstant.first, registeredConstant.second}, fingerprint);
+        }
+        return fingerprint;
+    }
+
     hresult_t AbstractController::registerVariable(std::vector<std::string> const & fieldnames,
                                                    Eigen::Ref<vectorN_t>            values)
     {
@@ -123,9 +123,19 @@ namespace jiminy
     }
 
     hresult_t Engine::registerForceProfile(std::string           const & frameName,
-                                           forceProfileFunctor_t         forceFct)
+                                           forceProfileFunctor_t         forceFct,
+                                           float64_t             const & updatePeriod)
     {
-        return EngineMultiRobot::registerForceProfile("", frameName, forceFct);
+        return EngineMultiRobot::registerForceProfile("", frameName, forceFct, updatePeriod);
+    }
+
+    hresult_t Engine::registerForceProfile(std::string      const & frameName,
+                                           pinocchio::Force const & offset,
+                                           pinocchio::Force const & amplitude,
+                                           float64_t        const & frequency,
+                                           float64_t        const & phase)
+    {
+        return EngineMultiRobot::registerForceProfile("", frameName, offset, amplitude, frequency, phase);
     }
 
     bool_t const & Engine::getIsInitialized(void) const
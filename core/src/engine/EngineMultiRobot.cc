@@ -1,15 +1,22 @@
 #include <iostream>
 #include <cmath>
+#include <array>
+#include <numeric>
 #include <algorithm>
 
 #include "pinocchio/parsers/urdf.hpp"
-#include "pinocchio/algorithm/contact-dynamics.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/cholesky.hpp"
 
 #include "jiminy/core/io/FileDevice.h"
 #include "jiminy/core/telemetry/TelemetryData.h"
 #include "jiminy/core/telemetry/TelemetryRecorder.h"
 #include "jiminy/core/robot/AbstractMotor.h"
 #include "jiminy/core/robot/AbstractSensor.h"
+#include "jiminy/core/robot/BasicSensors.h"
 #include "jiminy/core/robot/Robot.h"
 #include "jiminy/core/control/AbstractController.h"
 #include "jiminy/core/Utilities.h"
@@ -40,6 +47,8 @@ namespace jiminy
         u = vectorN_t::Zero(robot_->nv());
         fExternal = forceVector_t(robot_->pncModel_.joints.size(),
                                     pinocchio::Force::Zero());
+        xMotor = robot_->getMotorsState();
+        xMotorDot = vectorN_t::Zero(robot_->getMotorsStateSize());
 
         isInitialized_ = true;
     }
@@ -56,6 +65,7 @@ namespace jiminy
     robot(std::move(robotIn)),
     controller(std::move(controllerIn)),
     callbackFct(std::move(callbackFctIn)),
+    isKinematic(false),
     positionFieldnames(),
     velocityFieldnames(),
     accelerationFieldnames(),
@@ -65,10 +75,16 @@ namespace jiminy
     state(),
     statePrev(),
     forcesProfile(),
+    forcesProfileNative(),
     forcesImpulse(),
-    forcesImpulseBreaks(),
-    forcesImpulseBreakNextIt(),
-    forcesImpulseActive()
+    forcesImpulseActive(),
+    controllerUpdatePeriod(0.0),
+    sensorsTypes(),
+    sensorsUpdatePeriod(),
+    jointsBoundedPosition(),
+    jointsBoundedVelocity(),
+    jointsBoundedEffort(),
+    trajectory()
     {
         state.initialize(robot.get());
         statePrev.initialize(robot.get());
@@ -99,10 +115,24 @@ namespace jiminy
     telemetrySender_(),
     telemetryData_(nullptr),
     telemetryRecorder_(nullptr),
+    telemetryFingerprint_(0U),
     stepper_(),
     stepperUpdatePeriod_(-1),
     stepperState_(),
-    forcesCoupling_()
+    forcesCoupling_(),
+    forcesCouplingNative_(),
+    forcesCouplingNativeValue_(),
+    interactionFrames_(),
+    interactionCells_(),
+    interactionPairs_(),
+    collisionBodies_(),
+    collisionSweepOrder_(),
+    collisionPairs_(),
+    collisionGroundCandidates_(),
+    timedEventsUser_(),
+    timedEvents_(),
+    sensorsTimedEvents_(),
+    isContactTimeStepping_(false)
     {
         // Initialize the configuration options to the default.
         setOptions(getDefaultEngineOptions());
@@ -147,6 +177,46 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    hresult_t EngineMultiRobot::addKinematicSystem(std::string const & systemName,
+                                                   std::shared_ptr<Robot> robot,
+                                                   vectorN_t const & times,
+                                                   matrixN_t const & positions)
+    {
+        if (!robot->getIsInitialized())
+        {
+            std::cout << "Error - EngineMultiRobot::addKinematicSystem - Robot not initialized." << std::endl;
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Make sure the trajectory is valid. Its dimension is checked at start, since the model may still change.
+        if (times.size() == 0 || times.size() != positions.cols())
+        {
+            std::cout << "Error - EngineMultiRobot::addKinematicSystem - The number of knots must be the same for the times and positions, and not zero." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        if (times.size() > 1 && (times.tail(times.size() - 1) - times.head(times.size() - 1)).minCoeff() < EPS)
+        {
+            std::cout << "Error - EngineMultiRobot::addKinematicSystem - The times of the knots must be strictly increasing." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // The callback of a kinematic system never stops the simulation
+        systemsDataHolder_.emplace_back(systemName,
+                                        std::move(robot),
+                                        nullptr,
+                                        [](float64_t const & t,
+                                           vectorN_t const & q,
+                                           vectorN_t const & v) -> bool_t
+                                        {
+                                            return true;
+                                        });
+        systemDataHolder_t & system = systemsDataHolder_.back();
+        system.isKinematic = true;
+        system.trajectory = kinematicTrajectory_t(times, positions);
+
+        return hresult_t::SUCCESS;
+    }
+
     hresult_t EngineMultiRobot::removeSystem(std::string const & systemName)
     {
         auto systemIt = std::find_if(systemsDataHolder_.begin(), systemsDataHolder_.end(),
@@ -181,6 +251,34 @@ namespace jiminy
                 force.systemIdx2--;
             }
         }
+        for (auto & force : forcesCouplingNative_)
+        {
+            if (force.systemIdx1 > systemIdx)
+            {
+                force.systemIdx1--;
+            }
+            if (force.systemIdx2 > systemIdx)
+            {
+                force.systemIdx2--;
+            }
+        }
+
+        // Remove the interaction frames of the system, then update the indices of the remaining ones
+        interactionFrames_.erase(
+            std::remove_if(interactionFrames_.begin(), interactionFrames_.end(),
+            [&systemName](auto const & frame)
+            {
+                return (frame.systemName == systemName);
+            }),
+            interactionFrames_.end()
+        );
+        for (auto & frame : interactionFrames_)
+        {
+            if (frame.systemIdx > systemIdx)
+            {
+                frame.systemIdx--;
+            }
+        }
 
         return hresult_t::SUCCESS;
     }
@@ -240,6 +338,78 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t EngineMultiRobot::addCouplingForce(std::string const & systemName1,
+                                                 std::string const & systemName2,
+                                                 std::string const & frameName1,
+                                                 std::string const & frameName2,
+                                                 float64_t   const & stiffness,
+                                                 float64_t   const & damping,
+                                                 float64_t   const & restLength,
+                                                 bool_t      const & isTether)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::addCouplingForce - A simulation is running. "\
+                         "Please stop it before registering new forces." << std::endl;
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            if (stiffness < 0.0 || damping < 0.0 || restLength < 0.0)
+            {
+                std::cout << "Error - EngineMultiRobot::addCouplingForce - The stiffness, damping and rest length must be positive." << std::endl;
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        systemDataHolder_t * system1;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getSystem(systemName1, system1);
+        }
+
+        systemDataHolder_t * system2;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getSystem(systemName2, system2);
+        }
+
+        int32_t frameIdx1;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getFrameIdx(system1->robot->pncModel_, frameName1, frameIdx1);
+        }
+
+        int32_t frameIdx2;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getFrameIdx(system2->robot->pncModel_, frameName2, frameIdx2);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            int32_t const systemIdx1 = std::distance(systemsDataHolder_.data(), system1);
+            int32_t const systemIdx2 = std::distance(systemsDataHolder_.data(), system2);
+            forcesCouplingNative_.emplace_back(systemName1,
+                                               systemIdx1,
+                                               systemName2,
+                                               systemIdx2,
+                                               frameName1,
+                                               frameIdx1,
+                                               frameName2,
+                                               frameIdx2,
+                                               stiffness,
+                                               damping,
+                                               restLength,
+                                               isTether);
+        }
+
+        return returnCode;
+    }
+
     hresult_t EngineMultiRobot::removeCouplingForces(std::string const & systemName1,
                                                      std::string const & systemName2)
     {
@@ -269,6 +439,15 @@ namespace jiminy
             }),
             forcesCoupling_.end()
         );
+        forcesCouplingNative_.erase(
+            std::remove_if(forcesCouplingNative_.begin(), forcesCouplingNative_.end(),
+            [&systemName1, &systemName2](auto const & force)
+            {
+                return (force.systemName1 == systemName1 &&
+                        force.systemName2 == systemName2);
+            }),
+            forcesCouplingNative_.end()
+        );
 
         return hresult_t::SUCCESS;
     }
@@ -295,6 +474,69 @@ namespace jiminy
             }),
             forcesCoupling_.end()
         );
+        forcesCouplingNative_.erase(
+            std::remove_if(forcesCouplingNative_.begin(), forcesCouplingNative_.end(),
+            [&systemName](auto const & force)
+            {
+                return (force.systemName1 == systemName ||
+                        force.systemName2 == systemName);
+            }),
+            forcesCouplingNative_.end()
+        );
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t EngineMultiRobot::addInteractionFrame(std::string const & systemName,
+                                                    std::string const & frameName)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::addInteractionFrame - A simulation is running. "\
+                         "Please stop it before registering new forces." << std::endl;
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        systemDataHolder_t * system;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getSystem(systemName, system);
+        }
+
+        int32_t frameIdx;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getFrameIdx(system->robot->pncModel_, frameName, frameIdx);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            int32_t const systemIdx = std::distance(systemsDataHolder_.data(), system);
+            interactionFrames_.emplace_back(systemName, systemIdx, frameName, frameIdx);
+        }
+
+        return returnCode;
+    }
+
+    hresult_t EngineMultiRobot::removeInteractionFrames(std::string const & systemName)
+    {
+        systemDataHolder_t * system;
+        hresult_t const returnCode = getSystem(systemName, system);
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            return returnCode;
+        }
+
+        interactionFrames_.erase(
+            std::remove_if(interactionFrames_.begin(), interactionFrames_.end(),
+            [&systemName](auto const & frame)
+            {
+                return (frame.systemName == systemName);
+            }),
+            interactionFrames_.end()
+        );
 
         return hresult_t::SUCCESS;
     }
@@ -311,6 +553,20 @@ namespace jiminy
 
         if (!isTelemetryConfigured_)
         {
+            // Clear the variables registered during the previous simulation, if any
+            telemetryData_->reset();
+            telemetryFingerprint_ = 0U;
+
+            // Reserve the memory of the telemetry up front, to avoid growing it while registering the variables
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                auto const & telemetryOptions = engineOptions_->telemetry;
+                returnCode = telemetryData_->reserve(
+                    telemetryOptions.constantsMemSize > 0U ? telemetryOptions.constantsMemSize : CONSTANTS_MEM_SIZE,
+                    telemetryOptions.integersMemSize > 0U ? telemetryOptions.integersMemSize : INTEGERS_MEM_SIZE,
+                    telemetryOptions.floatsMemSize > 0U ? telemetryOptions.floatsMemSize : FLOATS_MEM_SIZE);
+            }
+
             for (auto & system : systemsDataHolder_)
             {
                 // Generate the log fieldnames
@@ -376,7 +632,7 @@ namespace jiminy
                     }
                 }
 
-                if (returnCode == hresult_t::SUCCESS)
+                if (returnCode == hresult_t::SUCCESS && system.controller)
                 {
                     returnCode = system.controller->configureTelemetry(
                         telemetryData_, system.name);
@@ -397,17 +653,62 @@ namespace jiminy
         return returnCode;
     }
 
+    uint64_t EngineMultiRobot::getTelemetryFingerprint(void) const
+    {
+        uint64_t fingerprint = computeHash(std::vector<std::string>{
+            std::to_string(engineOptions_->telemetry.enableConfiguration),
+            std::to_string(engineOptions_->telemetry.enableVelocity),
+            std::to_string(engineOptions_->telemetry.enableAcceleration),
+            std::to_string(engineOptions_->telemetry.enableEffort),
+            std::to_string(engineOptions_->telemetry.enableEnergy),
+            std::to_string(engineOptions_->telemetry.timeUnit),
+            std::to_string(engineOptions_->telemetry.flightRecorderMemSize),
+            std::to_string(engineOptions_->telemetry.constantsMemSize),
+            std::to_string(engineOptions_->telemetry.integersMemSize),
+            std::to_string(engineOptions_->telemetry.floatsMemSize)});
+        for (auto const & system : systemsDataHolder_)
+        {
+            // Both the variables to register and the ones already registered are considered
+            fingerprint = computeHash(system.name + TELEMETRY_DELIMITER, fingerprint);
+            fingerprint = computeHash(system.positionFieldnames, fingerprint);
+            fingerprint = computeHash(system.velocityFieldnames, fingerprint);
+            fingerprint = computeHash(system.accelerationFieldnames, fingerprint);
+            fingerprint = computeHash(system.motorEffortFieldnames, fingerprint);
+            fingerprint = computeHash(system.energyFieldname + TELEMETRY_DELIMITER, fingerprint);
+            fingerprint = computeHash(system.robot->getPositionFieldnames(), fingerprint);
+            fingerprint = computeHash(system.robot->getVelocityFieldnames(), fingerprint);
+            fingerprint = computeHash(system.robot->getAccelerationFieldnames(), fingerprint);
+            fingerprint = computeHash(system.robot->getMotorEffortFieldnames(), fingerprint);
+            fingerprint = computeHash(std::to_string(system.robot->getTelemetryFingerprint()), fingerprint);
+            if (system.controller)
+            {
+                fingerprint = computeHash(std::to_string(system.controller->getTelemetryFingerprint()), fingerprint);
+            }
+        }
+
+        // The rate groups are resolved when the registration is locked
+        for (telemetryGroup_t const & group : telemetryData_->getGroups())
+        {
+            fingerprint = computeHash(group.name + "=" + std::to_string(group.decimation), fingerprint);
+            fingerprint = computeHash(group.fieldnames, fingerprint);
+        }
+
+        // Zero is reserved to indicate that no variable is registered
+        return std::max(fingerprint, uint64_t(1U));
+    }
+
     void EngineMultiRobot::updateTelemetry(void)
     {
         for (auto & system : systemsDataHolder_)
         {
-            // Compute the total energy of the system
+            // Compute the total energy of the system, reusing the kinematics if up-to-date
+            system.robot->computeForwardKinematics(system.state.q, system.state.v, false);
             float64_t energy = pinocchio_overload::kineticEnergy(
                 system.robot->pncModel_,
                 system.robot->pncData_,
                 system.state.q,
                 system.state.v,
-                true);
+                false);
             energy += pinocchio::potentialEnergy(
                 system.robot->pncModel_,
                 system.robot->pncData_,
@@ -440,7 +741,10 @@ namespace jiminy
                 telemetrySender_.updateValue(system.energyFieldname, energy);
             }
 
-            system.controller->updateTelemetry();
+            if (system.controller)
+            {
+                system.controller->updateTelemetry();
+            }
             system.robot->updateTelemetry();
         }
 
@@ -463,23 +767,36 @@ namespace jiminy
             for (auto & system : systemsDataHolder_)
             {
                 system.forcesImpulse.clear();
-                system.forcesImpulseBreaks.clear();
                 system.forcesImpulseActive.clear();
                 system.forcesProfile.clear();
+                system.forcesProfileNative.clear();
             }
         }
 
-        // Reset the random number generators
+        /* Seed the random number streams. Each system has its own streams, identified by
+           its name, so that the noise does not depend on the other systems, nor on the
+           scheduling of the engines running concurrently. They are seeded even if the
+           random numbers are not reset, since the streams of a system must never overlap,
+           but they resume from their current position in such a case. The global
+           generators are reset as well, since the user-defined controllers may rely on them. */
         if (resetRandomNumbers)
         {
             resetRandGenerators(engineOptions_->stepper.randomSeed);
         }
+        for (auto & system : systemsDataHolder_)
+        {
+            system.robot->seedRandomStreams(
+                engineOptions_->stepper.randomSeed, system.name, resetRandomNumbers);
+        }
 
         // Reset the internal state of the robot and controller
         for (auto & system : systemsDataHolder_)
         {
             system.robot->reset();
-            system.controller->reset();
+            if (system.controller)
+            {
+                system.controller->reset();
+            }
         }
     }
 
@@ -510,9 +827,15 @@ namespace jiminy
             returnCode = hresult_t::ERROR_INIT_FAILED;
         }
 
-        if (xInit.size() != systemsDataHolder_.size())
+        // The kinematic systems do not have any initial state, since it is prescribed by their trajectory
+        std::size_t const nSystemsDynamic = std::count_if(systemsDataHolder_.begin(), systemsDataHolder_.end(),
+                                                          [](auto const & system)
+                                                          {
+                                                              return !system.isKinematic;
+                                                          });
+        if (xInit.size() != nSystemsDynamic)
         {
-            std::cout << "Error - EngineMultiRobot::start - The number of initial state must match the number of systems." << std::endl;
+            std::cout << "Error - EngineMultiRobot::start - The number of initial state must match the number of non-kinematic systems." << std::endl;
             returnCode = hresult_t::ERROR_BAD_INPUT;
         }
 
@@ -521,6 +844,18 @@ namespace jiminy
         xInitOrdered.reserve(systemsDataHolder_.size());
         for (auto & system : systemsDataHolder_)
         {
+            if (system.isKinematic)
+            {
+                xInitOrdered.emplace_back();
+                if (system.trajectory.positions.rows() != system.robot->nq())
+                {
+                    std::cout << "Error - EngineMultiRobot::start - The size of the configurations of the trajectory is inconsistent "
+                                 "with model size for at least one kinematic system." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                }
+                continue;
+            }
+
             auto xInitIt = xInit.find(system.name);
             if (xInitIt == xInit.end())
             {
@@ -544,8 +879,11 @@ namespace jiminy
 
         for (auto & system : systemsDataHolder_)
         {
+            system.sensorsTypes.clear();
+            system.sensorsUpdatePeriod.clear();
             for (auto const & sensorGroup : system.robot->getSensors())
             {
+                float64_t sensorsUpdatePeriod = -1.0;
                 for (auto const & sensor : sensorGroup.second)
                 {
                     if (returnCode == hresult_t::SUCCESS)
@@ -556,6 +894,59 @@ namespace jiminy
                             returnCode = hresult_t::ERROR_INIT_FAILED;
                         }
                     }
+
+                    if (returnCode == hresult_t::SUCCESS)
+                    {
+                        // The sensors of a given type share their data, so they must be updated together
+                        float64_t const & updatePeriod = sensor->baseSensorOptions_->updatePeriod;
+                        if (sensor == *sensorGroup.second.begin())
+                        {
+                            sensorsUpdatePeriod = updatePeriod;
+                        }
+                        else if (std::abs(updatePeriod - sensorsUpdatePeriod) > EPS)
+                        {
+                            std::cout << "Error - EngineMultiRobot::start - The update period must be the same for every sensor of a given type." << std::endl;
+                            returnCode = hresult_t::ERROR_BAD_INPUT;
+                        }
+                    }
+                }
+
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    // Fallback to the update period of the engine if not specified
+                    if (sensorsUpdatePeriod < 0.0)
+                    {
+                        sensorsUpdatePeriod = engineOptions_->stepper.sensorsUpdatePeriod;
+                    }
+                    if (EPS < sensorsUpdatePeriod && sensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+                    {
+                        std::cout << "Error - EngineMultiRobot::start - Cannot simulate a discrete system with period smaller than";
+                        std::cout << SIMULATION_MIN_TIMESTEP << "s. Increase period or switch to continuous mode by setting period to zero." << std::endl;
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                    }
+                    system.sensorsTypes.push_back(sensorGroup.first);
+                    system.sensorsUpdatePeriod.push_back(sensorsUpdatePeriod);
+                }
+            }
+
+            if (returnCode == hresult_t::SUCCESS && system.isKinematic)
+            {
+                // Kinematic systems have no controller
+                system.controllerUpdatePeriod = 0.0;
+            }
+            else if (returnCode == hresult_t::SUCCESS)
+            {
+                // Fallback to the update period of the engine if not specified
+                system.controllerUpdatePeriod = system.controller->baseControllerOptions_->updatePeriod;
+                if (system.controllerUpdatePeriod < 0.0)
+                {
+                    system.controllerUpdatePeriod = engineOptions_->stepper.controllerUpdatePeriod;
+                }
+                if (EPS < system.controllerUpdatePeriod && system.controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+                {
+                    std::cout << "Error - EngineMultiRobot::start - Cannot simulate a discrete system with period smaller than";
+                    std::cout << SIMULATION_MIN_TIMESTEP << "s. Increase period or switch to continuous mode by setting period to zero." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
                 }
             }
 
@@ -600,6 +991,29 @@ namespace jiminy
                 system.state.initialize(system.robot.get());
                 system.statePrev.initialize(system.robot.get());
             }
+
+            if (returnCode == hresult_t::SUCCESS && system.isKinematic)
+            {
+                /* Compute the difference of configuration between successive knots of the
+                   trajectory, then the velocity at the knots by finite differences. */
+                pinocchio::Model const & pncModel = system.robot->pncModel_;
+                kinematicTrajectory_t & trajectory = system.trajectory;
+                int32_t const nKnots = trajectory.times.size();
+                trajectory.deltas.resize(pncModel.nv, std::max(nKnots - 1, 0));
+                for (int32_t i = 0; i < nKnots - 1; i++)
+                {
+                    trajectory.deltas.col(i) = pinocchio::difference(
+                        pncModel, trajectory.positions.col(i), trajectory.positions.col(i + 1));
+                }
+                trajectory.slopes = matrixN_t::Zero(pncModel.nv, nKnots);
+                for (int32_t i = 0; i < nKnots && nKnots > 1; i++)
+                {
+                    int32_t const iPrev = std::max(i - 1, 0);
+                    int32_t const iNext = std::min(i + 1, nKnots - 1);
+                    trajectory.slopes.col(i) = trajectory.deltas.middleCols(iPrev, iNext - iPrev).rowwise().sum()
+                                             / (trajectory.times[iNext] - trajectory.times[iPrev]);
+                }
+            }
         }
 
         if (returnCode == hresult_t::SUCCESS)
@@ -625,9 +1039,35 @@ namespace jiminy
                 stepper_ = stepper::EulerExplicit();
             }
 
+            /* The time-stepping contact scheme overwrites the ode solver, since the
+               contact impulses cannot be handled by a classic ode integrator. */
+            if (isContactTimeStepping_)
+            {
+                stepper_ = stepper::TimeStepping(
+                    [this](vectorN_t       & xIn,
+                           vectorN_t       & dxdtIn,
+                           float64_t const & tIn,
+                           float64_t const & dtIn)
+                    {
+                        this->computeTimeSteppingUpdate(tIn, dtIn, xIn, dxdtIn);
+                    }, engineOptions_->stepper.dtMax);
+            }
+
             // Set the initial time step
             float64_t const dt = SIMULATION_INITIAL_TIMESTEP;
 
+            // Append the initial internal state of the motors to the initial state of every system
+            for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
+            {
+                vectorN_t const & xMotorInit = systemsDataHolder_[i].robot->getMotorsState();
+                if (xMotorInit.size() > 0 && !systemsDataHolder_[i].isKinematic)
+                {
+                    vectorN_t & xInitSystem = xInitOrdered[i];
+                    xInitSystem.conservativeResize(xInitSystem.size() + xMotorInit.size());
+                    xInitSystem.tail(xMotorInit.size()) = xMotorInit;
+                }
+            }
+
             // Initialize the stepper state
             float64_t const t = 0.0;
             vectorN_t const xCat = cat(xInitOrdered);
@@ -646,6 +1086,22 @@ namespace jiminy
                             force.frameName2,
                             force.frameIdx2);
             }
+            for (auto & force : forcesCouplingNative_)
+            {
+                getFrameIdx(systemsDataHolder_[force.systemIdx1].robot->pncModel_,
+                            force.frameName1,
+                            force.frameIdx1);
+                getFrameIdx(systemsDataHolder_[force.systemIdx2].robot->pncModel_,
+                            force.frameName2,
+                            force.frameIdx2);
+            }
+            forcesCouplingNativeValue_.resize(forcesCouplingNative_.size(), pinocchio::Force::Zero());
+            for (auto & frame : interactionFrames_)
+            {
+                getFrameIdx(systemsDataHolder_[frame.systemIdx].robot->pncModel_,
+                            frame.frameName,
+                            frame.frameIdx);
+            }
 
             for (auto & system : systemsDataHolder_)
             {
@@ -656,6 +1112,12 @@ namespace jiminy
                                 force.frameName,
                                 force.frameIdx);
                 }
+                for (auto & force : system.forcesProfileNative)
+                {
+                    getFrameIdx(system.robot->pncModel_,
+                                force.frameName,
+                                force.frameIdx);
+                }
                 for (auto & force : system.forcesImpulse)
                 {
                     getFrameIdx(system.robot->pncModel_,
@@ -663,8 +1125,66 @@ namespace jiminy
                                 force.frameIdx);
                 }
 
-                // Initialize the impulse force breakpoint point iterator
-                system.forcesImpulseBreakNextIt = system.forcesImpulseBreaks.begin();
+                /* Register the frames whose placement is actually used by the simulation,
+                   so that only these ones are kept up-to-date during the integration. */
+                std::vector<int32_t> kinematicsFramesIdx = system.robot->getContactFramesIdx();
+                for (int32_t const & frameIdx : system.robot->getConstraintsFramesIdx())
+                {
+                    kinematicsFramesIdx.push_back(frameIdx);
+                }
+                for (auto const & force : system.forcesProfile)
+                {
+                    kinematicsFramesIdx.push_back(force.frameIdx);
+                }
+                for (auto const & force : system.forcesProfileNative)
+                {
+                    kinematicsFramesIdx.push_back(force.frameIdx);
+                }
+                for (auto const & force : system.forcesImpulse)
+                {
+                    kinematicsFramesIdx.push_back(force.frameIdx);
+                }
+                for (auto const & force : forcesCoupling_)
+                {
+                    if (force.systemName1 == system.name)
+                    {
+                        kinematicsFramesIdx.push_back(force.frameIdx1);
+                    }
+                    if (force.systemName2 == system.name)
+                    {
+                        kinematicsFramesIdx.push_back(force.frameIdx2);
+                    }
+                }
+                for (auto const & force : forcesCouplingNative_)
+                {
+                    if (force.systemName1 == system.name)
+                    {
+                        kinematicsFramesIdx.push_back(force.frameIdx1);
+                    }
+                    if (force.systemName2 == system.name)
+                    {
+                        kinematicsFramesIdx.push_back(force.frameIdx2);
+                    }
+                }
+                for (auto const & frame : interactionFrames_)
+                {
+                    if (frame.systemName == system.name)
+                    {
+                        kinematicsFramesIdx.push_back(frame.frameIdx);
+                    }
+                }
+                for (auto const & sensorGroup : system.robot->getSensors())
+                {
+                    for (auto const & sensor : sensorGroup.second)
+                    {
+                        auto const imuSensor = std::dynamic_pointer_cast<ImuSensor const>(sensor);
+                        if (imuSensor)
+                        {
+                            kinematicsFramesIdx.push_back(imuSensor->getFrameIdx());
+                        }
+                    }
+                }
+                system.robot->setKinematicsFramesIdx(kinematicsFramesIdx);
 
                 // Reset the active set of impulse forces
                 std::fill(system.forcesImpulseActive.begin(),
@@ -677,9 +1197,9 @@ namespace jiminy
                 vectorN_t const & a = system.state.a;
                 computeForwardKinematics(system, q, v, a);
 
-                // Make sure that the contact forces are bounded
+                // Make sure that the contact forces are bounded (penetration is allowed with the spring-damper model only)
                 auto const & contactFramesIdx = system.robot->getContactFramesIdx();
-                for (uint32_t i=0; i < contactFramesIdx.size(); i++)
+                for (uint32_t i=0; i < contactFramesIdx.size() && !isContactTimeStepping_; i++)
                 {
                     pinocchio::Force fextInFrame;
                     fextInFrame = computeContactDynamics(system, contactFramesIdx[i]);
@@ -692,19 +1212,32 @@ namespace jiminy
                     }
                     break;
                 }
+            }
 
-                // Activate every force impulse starting at t=0
-                auto forcesImpulseActiveIt = system.forcesImpulseActive.begin();
-                auto forcesImpulseIt = system.forcesImpulse.begin();
-                for ( ; forcesImpulseIt != system.forcesImpulse.end() ;
-                    forcesImpulseActiveIt++, forcesImpulseIt++)
+            // Gather the collision geometry of every system, if the collisions are enabled
+            collisionOptions_t const & collisionOptions = engineOptions_->collisions;
+            collisionBodies_.clear();
+            if (collisionOptions.enableGround || collisionOptions.enableSelf || collisionOptions.enableSystems)
+            {
+                for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
                 {
-                    if (forcesImpulseIt->t < STEPPER_MIN_TIMESTEP)
+                    auto const & geometries = systemsDataHolder_[i].robot->getCollisionGeometries();
+                    for (uint32_t j = 0; j < geometries.size(); j++)
                     {
-                        *forcesImpulseActiveIt = true;
+                        collisionBodies_.emplace_back(i, j);
                     }
                 }
             }
+            collisionSweepOrder_.resize(collisionBodies_.size());
+            std::iota(collisionSweepOrder_.begin(), collisionSweepOrder_.end(), 0);
+
+            // Find the candidate pairs of interaction frames and colliding bodies for the first step
+            updateInteractionPairs();
+            updateCollisionPairs(true);
+
+            // Schedule the timed events, then activate every force impulse starting at t=0
+            initializeTimedEvents();
+            processTimedEvents(t);
 
             // Compute the internal and external forces applied on every systems
             auto const xSplit = splitState(xCat);
@@ -726,12 +1259,19 @@ namespace jiminy
                 // Initialize the sensor data
                 system.robot->setSensorsData(t, q, v, a, uMotor);
 
+                // The acceleration of the kinematic systems is prescribed by their trajectory
+                if (system.isKinematic)
+                {
+                    continue;
+                }
+
                 // Compute the actual motor effort
                 computeCommand(system, t, q, v, uCommand);
 
-                // Compute the actual motor effort
+                // Compute the actual motor effort and the derivative of their internal state
                 system.robot->computeMotorsEfforts(t, q, v, a, uCommand);
                 uMotor = system.robot->getMotorsEfforts();
+                system.state.xMotorDot = system.robot->getMotorsStateDerivative();
 
                 // Compute the internal dynamics
                 computeInternalDynamics(system, t, q, v, uInternal);
@@ -762,11 +1302,47 @@ namespace jiminy
             syncStepperStateWithSystems();
         }
 
-        // Lock the telemetry. At this point it is no longer possible to register new variables.
-        configureTelemetry();
+        /* Reuse the variables registered during the previous simulation if they are unchanged,
+           so that only the recorded data are cleared. It avoids registering every variable
+           and formatting the header of the log again, which is costly for short simulations.
+           Note that the circular buffers of the sensors have already been reset at this point
+           along with the robot, whether or not the telemetry is reused. It is necessary anyway
+           since the data of the previous simulation must not leak through the sensor delay. */
+        uint64_t const telemetryFingerprint = getTelemetryFingerprint();
+        if (telemetryFingerprint == telemetryFingerprint_
+         && telemetryRecorder_->restart() == hresult_t::SUCCESS)
+        {
+            for (auto & system : systemsDataHolder_)
+            {
+                system.robot->resumeTelemetry();
+                if (system.controller)
+                {
+                    system.controller->resumeTelemetry();
+                }
+            }
+            isTelemetryConfigured_ = true;
+        }
+        else
+        {
+            // Lock the telemetry. At this point it is no longer possible to register new variables.
+            hresult_t telemetryReturnCode = configureTelemetry();
+
+            // Write the header: this locks the registration of new variables
+            if (telemetryReturnCode == hresult_t::SUCCESS)
+            {
+                telemetryReturnCode = telemetryRecorder_->initialize(
+                    telemetryData_.get(),
+                    engineOptions_->telemetry.timeUnit,
+                    engineOptions_->telemetry.flightRecorderMemSize);
+            }
 
-        // Write the header: this locks the registration of new variables
-        telemetryRecorder_->initialize(telemetryData_.get(), engineOptions_->telemetry.timeUnit);
+            /* Keep track of the variables that have been registered. Note that it must be done
+               after configuring the telemetry, since the senders are bound to it at this point. */
+            if (telemetryReturnCode == hresult_t::SUCCESS)
+            {
+                telemetryFingerprint_ = getTelemetryFingerprint();
+            }
+        }
 
         // Log current buffer content as first point of the log data.
         updateTelemetry();
@@ -818,6 +1394,7 @@ namespace jiminy
         }
 
         // Integration loop based on boost::numeric::odeint::detail::integrate_times
+        bool_t isSimulationFailed = false;
         while (returnCode == hresult_t::SUCCESS)
         {
             // Stop the simulation if the end time has been reached
@@ -846,6 +1423,7 @@ namespace jiminy
                 {
                     std::cout << "Simulation done: callback returned false." << std::endl;
                 }
+                isSimulationFailed = true;
                 break;
             }
 
@@ -857,6 +1435,7 @@ namespace jiminy
                 {
                     std::cout << "Simulation done: maximum number of integration steps exceeded." << std::endl;
                 }
+                isSimulationFailed = true;
                 break;
             }
 
@@ -871,11 +1450,19 @@ namespace jiminy
                 stepSize = min(engineOptions_->stepper.dtMax, tEnd - stepperState_.t);
             }
             returnCode = step(stepSize); // Automatic dt adjustment
+            isSimulationFailed = (returnCode != hresult_t::SUCCESS);
         }
 
         // Stop the simulation. New variables can be registered again, and the lock on the robot is released
         stop();
 
+        /* Dump the log if the simulation failed. It is especially useful in
+           flight recorder mode, since only the most recent data are kept. */
+        if (isSimulationFailed && !engineOptions_->telemetry.flightRecorderDumpPath.empty())
+        {
+            writeLogBinary(engineOptions_->telemetry.flightRecorderDumpPath);
+        }
+
         return returnCode;
     }
 
@@ -908,28 +1495,19 @@ namespace jiminy
                 return hresult_t::ERROR_BAD_INPUT;
             }
 
-            /* Set end time: The default step size is equal to the
-               controller update period if discrete-time, otherwise
-               it uses the sensor update period if discrete-time,
-               otherwise it uses the user-defined parameter dtMax. */
+            /* Set end time: The default step size is equal to the update period of
+               the fastest controller among all systems if discrete-time, otherwise it
+               uses the user-defined parameter dtMax. The update period of the sensors
+               is not considered, since they are not breakpoints for the stepper. */
             if (stepSize < EPS)
             {
-                float64_t const & controllerUpdatePeriod = engineOptions_->stepper.controllerUpdatePeriod;
-                if (controllerUpdatePeriod > EPS)
+                if (stepperUpdatePeriod_ > EPS)
                 {
-                    stepSize = controllerUpdatePeriod;
+                    stepSize = stepperUpdatePeriod_;
                 }
                 else
                 {
-                    float64_t const & sensorsUpdatePeriod = engineOptions_->stepper.sensorsUpdatePeriod;
-                    if (sensorsUpdatePeriod > EPS)
-                    {
-                        stepSize = sensorsUpdatePeriod;
-                    }
-                    else
-                    {
-                        stepSize = engineOptions_->stepper.dtMax;
-                    }
+                    stepSize = engineOptions_->stepper.dtMax;
                 }
             }
 
@@ -951,6 +1529,12 @@ namespace jiminy
             tEnd = stepperState_.t + stepSize_true;
             stepperState_.tError = (tEnd - stepperState_.t) - stepSize_true;
 
+            // Invalidate the cached kinematics, since the user may have altered it since the last step
+            for (auto & system : systemsDataHolder_)
+            {
+                system.robot->invalidateKinematics();
+            }
+
             // Get references to some internal stepper buffers
             float64_t & t = stepperState_.t;
             float64_t & dt = stepperState_.dt;
@@ -977,122 +1561,39 @@ namespace jiminy
                estimation of the optimal time step. */
             bool_t isBreakpointReached = false;
 
-            /* Flag monitoring if the dynamics has changed because of impulse
-               forces or the command (only in the case of discrete control).
-
-               `try_step(rhs, x, dxdt, t, dt)` method of error controlled boost
-               steppers leverage the FSAL (first same as last) principle. It is
-               implemented by considering at the value of (x, dxdt) in argument
-               have been initialized by the user with the system dynamics at
-               current time t. Thus, if the system dynamics is discontinuous,
-               one has to manually integrate up to t-, then update dxdt to take
-               into the acceleration at t+.
-
-               Note that ONLY the acceleration part of dxdt must be updated since
-               the  projection of the velocity on the state space is not supposed
-               to have changed, and on top of that tPrev is invalid at this point
-               because it has been updated just after the last successful step.
-
-               Note that the estimated dt is no longer very meaningful since the
-               dynamics has changed. Maybe dt should be reschedule... */
-            bool_t hasDynamicsChanged = false;
-
             // Perform the integration. Do not simulate extremely small time steps
             while (tEnd - t > STEPPER_MIN_TIMESTEP)
             {
                 float64_t tNext = t;
 
-                // Update the active set and get the next breakpoint of impulse forces
-                float64_t tForceImpulseNext = INF;
-                for (auto & system : systemsDataHolder_)
-                {
-                    /* Update the active set: activate an impulse force as soon as
-                       the current time gets close enough of the application time,
-                       and deactivate it once the following the same reasoning.
-
-                       Note that breakpoints at the begining and the end of every
-                       impulse force at already enforced, so that the forces
-                       cannot get activated/desactivate too late. */
-                    auto forcesImpulseActiveIt = system.forcesImpulseActive.begin();
-                    auto forcesImpulseIt = system.forcesImpulse.begin();
-                    for ( ; forcesImpulseIt != system.forcesImpulse.end() ;
-                        forcesImpulseActiveIt++, forcesImpulseIt++)
-                    {
-                        float64_t const & tForceImpulse = forcesImpulseIt->t;
-                        float64_t const & dtForceImpulse = forcesImpulseIt->dt;
-
-                        if (t > tForceImpulse - STEPPER_MIN_TIMESTEP)
-                        {
-                            *forcesImpulseActiveIt = true;
-                            hasDynamicsChanged = true;
-                        }
-                        if (t > tForceImpulse + dtForceImpulse - STEPPER_MIN_TIMESTEP)
-                        {
-                            *forcesImpulseActiveIt = false;
-                            hasDynamicsChanged = true;
-                        }
-                    }
-
-                    // Update the breakpoint time iterator if necessary
-                    auto & tBreakNextIt = system.forcesImpulseBreakNextIt;
-                    if (tBreakNextIt != system.forcesImpulseBreaks.end())
-                    {
-                        if (t > *tBreakNextIt - STEPPER_MIN_TIMESTEP)
-                        {
-                            // The current breakpoint is behind in time. Switching to the next one.
-                            tBreakNextIt++;
-                        }
-                    }
-
-                    // Get the next breakpoint time if any
-                    if (tBreakNextIt != system.forcesImpulseBreaks.end())
-                    {
-                        tForceImpulseNext = min(tForceImpulseNext, *tBreakNextIt);
-                    }
-                }
-
-                if (stepperUpdatePeriod_ > EPS)
-                {
-                    // Update the sensor data if necessary (only for finite update frequency)
-                    if (engineOptions_->stepper.sensorsUpdatePeriod > EPS)
-                    {
-                        float64_t const & sensorsUpdatePeriod = engineOptions_->stepper.sensorsUpdatePeriod;
-                        float64_t dtNextSensorsUpdatePeriod = sensorsUpdatePeriod - std::fmod(t, sensorsUpdatePeriod);
-                        if (dtNextSensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP
-                        || sensorsUpdatePeriod - dtNextSensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
-                        {
-                            for (auto & system : systemsDataHolder_)
-                            {
-                                vectorN_t const & q = system.state.q;
-                                vectorN_t const & v = system.state.v;
-                                vectorN_t const & a = system.state.a;
-                                vectorN_t const & uMotor = system.state.uMotor;
-                                system.robot->setSensorsData(t, q, v, a, uMotor);
-                            }
-                        }
-                    }
-
-                    // Update the controller command if necessary (only for finite update frequency)
-                    if (engineOptions_->stepper.controllerUpdatePeriod > EPS)
-                    {
-                        float64_t const & controllerUpdatePeriod = engineOptions_->stepper.controllerUpdatePeriod;
-                        float64_t dtNextControllerUpdatePeriod = controllerUpdatePeriod - std::fmod(t, controllerUpdatePeriod);
-                        if (dtNextControllerUpdatePeriod < SIMULATION_MIN_TIMESTEP
-                        || controllerUpdatePeriod - dtNextControllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
-                        {
-                            for (auto & system : systemsDataHolder_)
-                            {
-                                vectorN_t const & q = system.state.q;
-                                vectorN_t const & v = system.state.v;
-                                vectorN_t & uCommand = system.state.uCommand;
-                                computeCommand(system, t, q, v, uCommand);
-                            }
-                            hasDynamicsChanged = true;
-                        }
-                    }
-                }
-
-                // Fix the FSAL issue if the dynamics has changed
+                /* Process the events due at the current time, namely the activation and
+                   deactivation of the impulse forces and the discrete updates of the
+                   sensors and controllers. Note that breakpoints are enforced at the
+                   time of every event but the sensor updates, so they cannot be
+                   processed too late. The sensors are updated right after each step. */
+                bool_t const hasDynamicsChanged = processTimedEvents(t);
+
+                // Get the next breakpoint
+                float64_t const tEventNext = getTimedEventNext();
+
+                /* Fix the FSAL issue if the dynamics has changed because of impulse
+                   forces or the command (only in the case of discrete control).
+
+                   `try_step(rhs, x, dxdt, t, dt)` method of error controlled boost
+                   steppers leverage the FSAL (first same as last) principle. It is
+                   implemented by considering at the value of (x, dxdt) in argument
+                   have been initialized by the user with the system dynamics at
+                   current time t. Thus, if the system dynamics is discontinuous,
+                   one has to manually integrate up to t-, then update dxdt to take
+                   into the acceleration at t+.
+
+                   Note that ONLY the acceleration part of dxdt must be updated since
+                   the  projection of the velocity on the state space is not supposed
+                   to have changed, and on top of that tPrev is invalid at this point
+                   because it has been updated just after the last successful step.
+
+                   Note that the estimated dt is no longer very meaningful since the
+                   dynamics has changed. Maybe dt should be reschedule... */
                 if (hasDynamicsChanged)
                 {
                     computeSystemDynamics(t, x, dxdt);
@@ -1104,21 +1605,7 @@ namespace jiminy
                     /* Get the time of the next breakpoint for the ODE solver:
                        a breakpoint occurs if we reached tEnd, if an external force
                        is applied, or if we need to update the sensors / controller. */
-                    float64_t dtNextGlobal; // dt to apply for the next stepper step because of the various breakpoints
-                    float64_t dtNextUpdatePeriod = stepperUpdatePeriod_ - std::fmod(t, stepperUpdatePeriod_);
-                    if (dtNextUpdatePeriod < SIMULATION_MIN_TIMESTEP)
-                    {
-                        /* Step to reach next sensors/controller update is too short:
-                           skip one controller update and jump to the next one.
-                           Note that in this case, the sensors have already been
-                           updated in anticipation in previous loop. */
-                        dtNextGlobal = min(dtNextUpdatePeriod + stepperUpdatePeriod_,
-                                           tForceImpulseNext - t);
-                    }
-                    else
-                    {
-                        dtNextGlobal = min(dtNextUpdatePeriod, tForceImpulseNext - t);
-                    }
+                    float64_t dtNextGlobal = tEventNext - t; // dt to apply for the next stepper step because of the various breakpoints
 
                     /* Check if the next dt to about equal to the time difference
                        between the current time (it can only be smaller) and
@@ -1179,6 +1666,9 @@ namespace jiminy
                             // Increment the iteration counter only for successful steps
                             stepperState_.iter++;
 
+                            // Update the sensors whose update is due within the step
+                            processSensorsTimedEventsInStep(stepperState_.tPrev, t);
+
                             // Log every stepper state only if the user asked for
                             if (engineOptions_->stepper.logInternalStepperSteps)
                             {
@@ -1240,7 +1730,7 @@ namespace jiminy
                     dt = min(dt,
                              engineOptions_->stepper.dtMax,
                              tEnd - t,
-                             tForceImpulseNext - t);
+                             tEventNext - t);
 
                     /* A breakpoint has been reached dt has been decreased
                        wrt the largest possible dt within integration tol. */
@@ -1267,6 +1757,9 @@ namespace jiminy
                             // Increment the iteration counter
                             stepperState_.iter++;
 
+                            // Update the sensors whose update is due within the step
+                            processSensorsTimedEventsInStep(stepperState_.tPrev, t);
+
                             // Log every stepper state only if the user asked for
                             if (engineOptions_->stepper.logInternalStepperSteps)
                             {
@@ -1326,6 +1819,17 @@ namespace jiminy
             stepperState_.t = tEnd;
             stepperState_.dt = stepSize;
 
+            /* Update the placement of every frame for the final state, since only the ones
+               actually used are kept up-to-date during the integration. */
+            for (auto & system : systemsDataHolder_)
+            {
+                system.robot->computeForwardKinematics(system.state.q, system.state.v, true);
+            }
+
+            // Find the candidate pairs of interaction frames and colliding bodies for the next step
+            updateInteractionPairs();
+            updateCollisionPairs();
+
             // Monitor current iteration number, and log the current time, state, command, and sensors data
             if (!engineOptions_->stepper.logInternalStepperSteps)
             {
@@ -1352,15 +1856,292 @@ namespace jiminy
 
         /* Reset the telemetry. Note that calling ``stop` or `reset` does NOT clear
            the internal data buffer of telemetryRecorder_. Clearing is done at init
-           time, so that it remains accessible until the next initialization. */
+           time, so that it remains accessible until the next initialization. The
+           registered variables are kept, in case they can be reused at restart. */
         telemetryRecorder_->reset();
-        telemetryData_->reset();
 
         // Update some internal flags
         isTelemetryConfigured_ = false;
         isSimulationRunning_ = false;
     }
 
+    void EngineMultiRobot::initializeTimedEvents(void)
+    {
+        timedEvents_ = timedEventQueue_t();
+        sensorsTimedEvents_ = timedEventQueue_t();
+
+        // Schedule the start and end of every impulse force
+        for (uint32_t systemIdx = 0; systemIdx < systemsDataHolder_.size(); systemIdx++)
+        {
+            forceImpulseRegister_t const & forcesImpulse = systemsDataHolder_[systemIdx].forcesImpulse;
+            for (uint32_t forceIdx = 0; forceIdx < forcesImpulse.size(); forceIdx++)
+            {
+                forceImpulse_t const & force = forcesImpulse[forceIdx];
+                timedEvents_.emplace(timeToTick(force.t), timedEventType_t::FORCE_IMPULSE_START,
+                                     systemIdx, forceIdx, 0);
+                timedEvents_.emplace(timeToTick(force.t + force.dt), timedEventType_t::FORCE_IMPULSE_END,
+                                     systemIdx, forceIdx, 0);
+            }
+        }
+
+        /* Schedule the update of the sampled force profiles, starting at t=0. They are
+           breakpoints for the stepper, since the force is held constant in between. */
+        for (uint32_t systemIdx = 0; systemIdx < systemsDataHolder_.size(); systemIdx++)
+        {
+            forceProfileRegister_t const & forcesProfile = systemsDataHolder_[systemIdx].forcesProfile;
+            for (uint32_t forceIdx = 0; forceIdx < forcesProfile.size(); forceIdx++)
+            {
+                float64_t const & updatePeriod = forcesProfile[forceIdx].updatePeriod;
+                if (updatePeriod > EPS)
+                {
+                    int64_t const period = timeToTick(updatePeriod);
+                    timedEvents_.emplace(0, timedEventType_t::FORCE_PROFILE_UPDATE,
+                                         systemIdx, forceIdx, period);
+                }
+            }
+        }
+
+        // Schedule the user-defined events
+        for (uint32_t eventIdx = 0; eventIdx < timedEventsUser_.size(); eventIdx++)
+        {
+            timedEventUser_t const & eventUser = timedEventsUser_[eventIdx];
+            timedEvents_.emplace(timeToTick(eventUser.t), timedEventType_t::USER_EVENT,
+                                 -1, eventIdx, timeToTick(eventUser.period));
+        }
+
+        /* Schedule the discrete update of the sensors and controllers (only for finite update
+           frequency), independently for each system and type of sensors. Note that they have
+           already been updated at t=0 by `start`. The stepper must stop at least as often as
+           the fastest controller, since the command is held constant in between. On the
+           contrary, the sensors do not affect the dynamics, so they are not breakpoints. */
+        stepperUpdatePeriod_ = INF;
+        for (uint32_t systemIdx = 0; systemIdx < systemsDataHolder_.size(); systemIdx++)
+        {
+            systemDataHolder_t const & system = systemsDataHolder_[systemIdx];
+            for (uint32_t sensorTypeIdx = 0; sensorTypeIdx < system.sensorsTypes.size(); sensorTypeIdx++)
+            {
+                float64_t const & sensorsUpdatePeriod = system.sensorsUpdatePeriod[sensorTypeIdx];
+                if (sensorsUpdatePeriod > EPS)
+                {
+                    int64_t const period = timeToTick(sensorsUpdatePeriod);
+                    sensorsTimedEvents_.emplace(period, timedEventType_t::SENSORS_UPDATE,
+                                                systemIdx, sensorTypeIdx, period);
+                }
+            }
+            if (system.controllerUpdatePeriod > EPS)
+            {
+                int64_t const period = timeToTick(system.controllerUpdatePeriod);
+                timedEvents_.emplace(period, timedEventType_t::CONTROLLER_UPDATE,
+                                     systemIdx, -1, period);
+                stepperUpdatePeriod_ = std::min(stepperUpdatePeriod_, system.controllerUpdatePeriod);
+            }
+        }
+        if (std::isinf(stepperUpdatePeriod_))
+        {
+            // Fully continuous simulation: no need to stop the stepper
+            stepperUpdatePeriod_ = 0.0;
+        }
+    }
+
+    bool_t EngineMultiRobot::processTimedEvents(float64_t const & t)
+    {
+        bool_t hasDynamicsChanged = false;
+
+        /* Update the sensors first, so that the command is always computed based on up-to-date
+           sensor data. Only the updates due exactly at the current time are left at this point,
+           since the ones falling within a step are processed right after it. */
+        int64_t const tick = timeToTick(t);
+        while (!sensorsTimedEvents_.empty() && sensorsTimedEvents_.top().tick <= tick)
+        {
+            timedEvent_t event = sensorsTimedEvents_.top();
+            sensorsTimedEvents_.pop();
+
+            systemDataHolder_t & system = systemsDataHolder_[event.systemIdx];
+            system.robot->setSensorsData(system.sensorsTypes[event.idx],
+                                         t,
+                                         system.state.q,
+                                         system.state.v,
+                                         system.state.a,
+                                         system.state.uMotor);
+
+            event.tick += ((tick - event.tick) / event.period + 1) * event.period;
+            sensorsTimedEvents_.push(event);
+        }
+
+        /* Pop every due event. Only these ones are touched, whatever the total number of events.
+           At equal tick, they are processed by type, so that a force ends after it starts. */
+        while (!timedEvents_.empty() && timedEvents_.top().tick <= tick)
+        {
+            timedEvent_t event = timedEvents_.top();
+            timedEvents_.pop();
+
+            switch (event.type)
+            {
+            case timedEventType_t::FORCE_IMPULSE_START:
+                systemsDataHolder_[event.systemIdx].forcesImpulseActive[event.idx] = true;
+                hasDynamicsChanged = true;
+                break;
+            case timedEventType_t::FORCE_IMPULSE_END:
+                systemsDataHolder_[event.systemIdx].forcesImpulseActive[event.idx] = false;
+                hasDynamicsChanged = true;
+                break;
+            case timedEventType_t::CONTROLLER_UPDATE:
+            {
+                systemDataHolder_t & system = systemsDataHolder_[event.systemIdx];
+                computeCommand(system, t, system.state.q, system.state.v, system.state.uCommand);
+                hasDynamicsChanged = true;
+                break;
+            }
+            case timedEventType_t::FORCE_PROFILE_UPDATE:
+            {
+                // Sample the force profile, then hold it constant until the next update
+                systemDataHolder_t & system = systemsDataHolder_[event.systemIdx];
+                forceProfile_t & forceProfile = system.forcesProfile[event.idx];
+                forceProfile.forcePrev = forceProfile.forceFct(t, system.state.q, system.state.v);
+                hasDynamicsChanged = true;
+                break;
+            }
+            case timedEventType_t::USER_EVENT:
+                // The user is free to alter anything affecting the dynamics
+                timedEventsUser_[event.idx].eventFct(t);
+                hasDynamicsChanged = true;
+                break;
+            case timedEventType_t::SENSORS_UPDATE:
+            default:
+                break;
+            }
+
+            // Reschedule periodic events, skipping the periods already elapsed if any
+            if (event.period > 0)
+            {
+                event.tick += ((tick - event.tick) / event.period + 1) * event.period;
+                timedEvents_.push(event);
+            }
+        }
+
+        return hasDynamicsChanged;
+    }
+
+    void EngineMultiRobot::processSensorsTimedEventsInStep(float64_t const & tPrev,
+                                                           float64_t const & t)
+    {
+        // Nothing to do if no update is due strictly before the end of the step
+        int64_t const tick = timeToTick(t);
+        if (sensorsTimedEvents_.empty() || sensorsTimedEvents_.top().tick >= tick)
+        {
+            return;
+        }
+
+        while (!sensorsTimedEvents_.empty() && sensorsTimedEvents_.top().tick < tick)
+        {
+            timedEvent_t event = sensorsTimedEvents_.top();
+            sensorsTimedEvents_.pop();
+
+            // Interpolate the state of the system at the time of the update
+            systemDataHolder_t & system = systemsDataHolder_[event.systemIdx];
+            float64_t const tEvent = tickToTime(event.tick);
+            float64_t const ratio = std::max(0.0, std::min((tEvent - tPrev) / (t - tPrev), 1.0));
+            vectorN_t q(system.state.q.size());
+            pinocchio::interpolate(system.robot->pncModel_, system.statePrev.q, system.state.q, ratio, q);
+            vectorN_t const v = system.statePrev.v + ratio * (system.state.v - system.statePrev.v);
+            vectorN_t const a = system.statePrev.a + ratio * (system.state.a - system.statePrev.a);
+            vectorN_t const uMotor = system.statePrev.uMotor + ratio * (system.state.uMotor - system.statePrev.uMotor);
+
+            // The sensors read the kinematics of the robot, so it must be consistent with the interpolated state
+            system.robot->computeForwardKinematics(q, v, a, false);
+            system.robot->setSensorsData(system.sensorsTypes[event.idx], tEvent, q, v, a, uMotor);
+
+            event.tick += event.period;
+            sensorsTimedEvents_.push(event);
+        }
+
+        // Restore the kinematics of the robots at the end of the step
+        for (auto & system : systemsDataHolder_)
+        {
+            system.robot->computeForwardKinematics(system.state.q, system.state.v, system.state.a, false);
+        }
+    }
+
+    float64_t EngineMultiRobot::getTimedEventNext(void) const
+    {
+        if (timedEvents_.empty())
+        {
+            return INF;
+        }
+        return tickToTime(timedEvents_.top().tick);
+    }
+
+    hresult_t EngineMultiRobot::registerTelemetryGroup(std::string              const & groupName,
+                                                       uint32_t                 const & decimation,
+                                                       std::vector<std::string> const & fieldnames)
+    {
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::registerTelemetryGroup - A simulation is running. "\
+                         "Please stop it before registering new telemetry groups." << std::endl;
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return telemetryData_->registerGroup(groupName, decimation, fieldnames);
+    }
+
+    hresult_t EngineMultiRobot::removeTelemetryGroups(void)
+    {
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::removeTelemetryGroups - A simulation is running. "\
+                         "Please stop it before removing the telemetry groups." << std::endl;
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        telemetryData_->removeGroups();
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t EngineMultiRobot::registerTimedEvent(float64_t           const & t,
+                                                   timedEventFunctor_t         eventFct,
+                                                   float64_t           const & period)
+    {
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::registerTimedEvent - A simulation is running. "\
+                         "Please stop it before registering new events." << std::endl;
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        if (t < 0.0)
+        {
+            std::cout << "Error - EngineMultiRobot::registerTimedEvent - The time of the event must be positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        if (EPS < period && period < SIMULATION_MIN_TIMESTEP)
+        {
+            std::cout << "Error - EngineMultiRobot::registerTimedEvent - Cannot call an event with period smaller than ";
+            std::cout << SIMULATION_MIN_TIMESTEP << "s. Increase period or set it to zero for a one-time event." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        timedEventsUser_.emplace_back(t, std::move(eventFct), std::max(period, 0.0));
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t EngineMultiRobot::removeTimedEvents(void)
+    {
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::removeTimedEvents - A simulation is running. "\
+                         "Please stop it before removing the events." << std::endl;
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        timedEventsUser_.clear();
+
+        return hresult_t::SUCCESS;
+    }
+
     hresult_t EngineMultiRobot::registerForceImpulse(std::string      const & systemName,
                                                      std::string      const & frameName,
                                                      float64_t        const & t,
@@ -1397,8 +2178,6 @@ namespace jiminy
         if (returnCode == hresult_t::SUCCESS)
         {
             system->forcesImpulse.emplace_back(frameName, frameIdx, t, dt, F);
-            system->forcesImpulseBreaks.emplace(t);
-            system->forcesImpulseBreaks.emplace(t + dt);
             system->forcesImpulseActive.emplace_back(false);
         }
 
@@ -1407,7 +2186,8 @@ namespace jiminy
 
     hresult_t EngineMultiRobot::registerForceProfile(std::string           const & systemName,
                                                      std::string           const & frameName,
-                                                     forceProfileFunctor_t         forceFct)
+                                                     forceProfileFunctor_t         forceFct,
+                                                     float64_t             const & updatePeriod)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
@@ -1418,8 +2198,18 @@ namespace jiminy
             returnCode = hresult_t::ERROR_GENERIC;
         }
 
+        if (EPS < updatePeriod && updatePeriod < SIMULATION_MIN_TIMESTEP)
+        {
+            std::cout << "Error - EngineMultiRobot::registerForceProfile - Cannot sample a force profile with period smaller than ";
+            std::cout << SIMULATION_MIN_TIMESTEP << "s. Increase period or switch to continuous mode by setting period to zero." << std::endl;
+            returnCode = hresult_t::ERROR_BAD_INPUT;
+        }
+
         systemDataHolder_t * system;
-        returnCode = getSystem(systemName, system);
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getSystem(systemName, system);
+        }
 
         int32_t frameIdx;
         if (returnCode == hresult_t::SUCCESS)
@@ -1431,7 +2221,45 @@ namespace jiminy
         if (returnCode == hresult_t::SUCCESS)
         {
             system->forcesProfile.emplace_back(
-                frameName, frameIdx, std::move(forceFct));
+                frameName, frameIdx, std::move(forceFct), updatePeriod);
+        }
+
+        return returnCode;
+    }
+
+    hresult_t EngineMultiRobot::registerForceProfile(std::string      const & systemName,
+                                                     std::string      const & frameName,
+                                                     pinocchio::Force const & offset,
+                                                     pinocchio::Force const & amplitude,
+                                                     float64_t        const & frequency,
+                                                     float64_t        const & phase)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isSimulationRunning_)
+        {
+            std::cout << "Error - EngineMultiRobot::registerForceProfile - A simulation is running. "\
+                         "Please stop it before registering new forces." << std::endl;
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        systemDataHolder_t * system;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getSystem(systemName, system);
+        }
+
+        int32_t frameIdx;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = getFrameIdx(
+                system->robot->pncModel_, frameName, frameIdx);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            system->forcesProfileNative.emplace_back(
+                frameName, frameIdx, offset, amplitude, frequency, phase);
         }
 
         return returnCode;
@@ -1496,6 +2324,18 @@ namespace jiminy
 
         // Make sure the contacts options are fine
         configHolder_t contactsOptions = boost::get<configHolder_t>(engineOptions.at("contacts"));
+        std::string const & contactModel = boost::get<std::string>(contactsOptions.at("model"));
+        if (CONTACT_MODELS.find(contactModel) == CONTACT_MODELS.end())
+        {
+            std::cout << "Error - EngineMultiRobot::setOptions - The requested contact 'model' is not available." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        uint32_t const & pgsIterMax = boost::get<uint32_t>(contactsOptions.at("pgsIterMax"));
+        if (pgsIterMax < 1U)
+        {
+            std::cout << "Error - EngineMultiRobot::setOptions - The contacts option 'pgsIterMax' must be strictly positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
         float64_t const & frictionStictionVel =
             boost::get<float64_t>(contactsOptions.at("frictionStictionVel"));
         if (frictionStictionVel < 0.0)
@@ -1518,10 +2358,37 @@ namespace jiminy
             return hresult_t::ERROR_BAD_INPUT;
         }
 
-        // Make sure the joints options are fine
-        configHolder_t jointsOptions = boost::get<configHolder_t>(engineOptions.at("joints"));
-        float64_t const & jointsTransitionPositionEps =
-            boost::get<float64_t>(jointsOptions.at("transitionPositionEps"));
+        // Make sure the interactions options are fine
+        configHolder_t interactionsOptions = boost::get<configHolder_t>(engineOptions.at("interactions"));
+        float64_t const & interactionsCutoffRadius =
+            boost::get<float64_t>(interactionsOptions.at("cutoffRadius"));
+        if (interactionsCutoffRadius < EPS)
+        {
+            std::cout << "Error - EngineMultiRobot::setOptions - The interactions option 'cutoffRadius' must be strictly positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        float64_t const & interactionsBroadphaseMargin =
+            boost::get<float64_t>(interactionsOptions.at("broadphaseMargin"));
+        if (interactionsBroadphaseMargin < 0.0)
+        {
+            std::cout << "Error - EngineMultiRobot::setOptions - The interactions option 'broadphaseMargin' must be positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Make sure the collisions options are fine
+        configHolder_t collisionsOptions = boost::get<configHolder_t>(engineOptions.at("collisions"));
+        float64_t const & collisionsBroadphaseMargin =
+            boost::get<float64_t>(collisionsOptions.at("broadphaseMargin"));
+        if (collisionsBroadphaseMargin < 0.0)
+        {
+            std::cout << "Error - EngineMultiRobot::setOptions - The collisions option 'broadphaseMargin' must be positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // Make sure the joints options are fine
+        configHolder_t jointsOptions = boost::get<configHolder_t>(engineOptions.at("joints"));
+        float64_t const & jointsTransitionPositionEps =
+            boost::get<float64_t>(jointsOptions.at("transitionPositionEps"));
         if (jointsTransitionPositionEps < EPS)
         {
             std::cout << "Error - EngineMultiRobot::setOptions - The joints option 'transitionPositionEps' must be strictly positive." << std::endl;
@@ -1535,18 +2402,15 @@ namespace jiminy
             return hresult_t::ERROR_BAD_INPUT;
         }
 
-        // Compute the breakpoints' period (for command or observation) during the integration loop
-        if (sensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
-        {
-            stepperUpdatePeriod_ = controllerUpdatePeriod;
-        }
-        else if (controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+        /* Compute the breakpoints' period (for command only, the sensors are not breakpoints) during
+           the integration loop. It is updated at start based on the update period of every system. */
+        if (controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
         {
-            stepperUpdatePeriod_ = sensorsUpdatePeriod;
+            stepperUpdatePeriod_ = 0.0;
         }
         else
         {
-            stepperUpdatePeriod_ = std::min(sensorsUpdatePeriod, controllerUpdatePeriod);
+            stepperUpdatePeriod_ = controllerUpdatePeriod;
         }
 
         // Make sure the user-defined gravity force has the right dimension
@@ -1564,6 +2428,9 @@ namespace jiminy
         // Create a fast struct accessor
         engineOptions_ = std::make_unique<engineOptions_t const>(engineOptionsHolder_);
 
+        // Cache the contact model to avoid string comparisons in the integration loop
+        isContactTimeStepping_ = (engineOptions_->contacts.model == "time_stepping");
+
         return hresult_t::SUCCESS;
     }
 
@@ -1629,7 +2496,22 @@ namespace jiminy
     // ================ Core physics utilities ================
     // ========================================================
 
-    template<template<typename> class F = type_identity>
+    /* The state of the kinematic systems is not part of the stepper state. The read-only
+       views refer to the state prescribed by their trajectory instead, whereas the writable
+       ones are empty, since there is nothing to integrate. */
+    Eigen::Ref<vectorN_t const> getKinematicStateRef(vectorN_t const & val,
+                                                     vectorN_t const & kinematicVal)
+    {
+        return kinematicVal;
+    }
+
+    Eigen::Ref<vectorN_t> getKinematicStateRef(vectorN_t       & val,
+                                               vectorN_t const & kinematicVal)
+    {
+        return val.segment(0, 0);
+    }
+
+    template<template<typename> class F>
     stateSplitRef_t<F> splitStateImpl(std::vector<systemDataHolder_t> const & systemsData,
                                       typename F<vectorN_t>::type & val)
     {
@@ -1642,12 +2524,45 @@ namespace jiminy
         uint32_t xIdx = 0U;
         for (auto const & system : systemsData)
         {
+            if (system.isKinematic)
+            {
+                valSplit.first.emplace_back(getKinematicStateRef(val, system.state.q));
+                valSplit.second.emplace_back(getKinematicStateRef(val, system.state.v));
+                continue;
+            }
+
             int32_t const & nq = system.robot->nq();
             int32_t const & nv = system.robot->nv();
             int32_t const & nx = system.robot->nx();
             valSplit.first.emplace_back(val.segment(xIdx, nq));
             valSplit.second.emplace_back(val.segment(xIdx + nq,  nv));
-            xIdx += nx;
+            xIdx += nx + system.robot->getMotorsStateSize();
+        }
+
+        return valSplit;
+    }
+
+    template<template<typename> class F = type_identity>
+    motorsStateSplitRef_t<F> splitMotorsStateImpl(std::vector<systemDataHolder_t> const & systemsData,
+                                                  typename F<vectorN_t>::type & val)
+    {
+        motorsStateSplitRef_t<F> valSplit;
+        valSplit.reserve(systemsData.size());
+
+        // The internal state of the motors is appended to the state of each system
+        uint32_t xIdx = 0U;
+        for (auto const & system : systemsData)
+        {
+            if (system.isKinematic)
+            {
+                valSplit.emplace_back(val.segment(xIdx, 0));
+                continue;
+            }
+
+            int32_t const & nx = system.robot->nx();
+            int32_t const nxMotor = system.robot->getMotorsStateSize();
+            valSplit.emplace_back(val.segment(xIdx + nx, nxMotor));
+            xIdx += nx + nxMotor;
         }
 
         return valSplit;
@@ -1660,7 +2575,17 @@ namespace jiminy
 
     stateSplitRef_t<> EngineMultiRobot::splitState(vectorN_t & val) const
     {
-        return splitStateImpl<>(systemsDataHolder_, val);
+        return splitStateImpl<type_identity>(systemsDataHolder_, val);
+    }
+
+    motorsStateSplitRef_t<std::add_const> EngineMultiRobot::splitMotorsState(vectorN_t const & val) const
+    {
+        return splitMotorsStateImpl<std::add_const>(systemsDataHolder_, val);
+    }
+
+    motorsStateSplitRef_t<> EngineMultiRobot::splitMotorsState(vectorN_t & val) const
+    {
+        return splitMotorsStateImpl<>(systemsDataHolder_, val);
     }
 
     void EngineMultiRobot::syncStepperStateWithSystems(void)
@@ -1676,11 +2601,30 @@ namespace jiminy
         for ( ; systemIt != systemsDataHolder_.end();
              systemIt++, qSplitIt++, vSplitIt++, qDotSplitIt++, aSplitIt++)
         {
+            // The kinematic systems are not part of the stepper state
+            if (systemIt->isKinematic)
+            {
+                continue;
+            }
+
             *qSplitIt = systemIt->state.q;
             *vSplitIt = systemIt->state.v;
             *qDotSplitIt = systemIt->state.qDot;
             *aSplitIt = systemIt->state.a;
         }
+
+        auto xMotorSplit = splitMotorsState(stepperState_.x);
+        auto xMotorDotSplit = splitMotorsState(stepperState_.dxdt);
+        for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
+        {
+            if (systemsDataHolder_[i].isKinematic)
+            {
+                continue;
+            }
+
+            xMotorSplit[i] = systemsDataHolder_[i].state.xMotor;
+            xMotorDotSplit[i] = systemsDataHolder_[i].state.xMotorDot;
+        }
     }
 
     void EngineMultiRobot::syncSystemsStateWithStepper(void)
@@ -1696,20 +2640,85 @@ namespace jiminy
         for ( ; systemIt != systemsDataHolder_.end();
              systemIt++, qSplitIt++, vSplitIt++, qDotSplitIt++, aSplitIt++)
         {
+            // The state of the kinematic systems is prescribed by their trajectory
+            if (systemIt->isKinematic)
+            {
+                computeKinematicTrajectory(*systemIt, stepperState_.t);
+                continue;
+            }
+
             systemIt->state.q = *qSplitIt;
             systemIt->state.v = *vSplitIt;
             systemIt->state.qDot = *qDotSplitIt;
             systemIt->state.a = *aSplitIt;
         }
+
+        auto xMotorSplit = splitMotorsState(stepperState_.x);
+        auto xMotorDotSplit = splitMotorsState(stepperState_.dxdt);
+        for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
+        {
+            if (systemsDataHolder_[i].isKinematic)
+            {
+                continue;
+            }
+
+            systemsDataHolder_[i].state.xMotor = xMotorSplit[i];
+            systemsDataHolder_[i].state.xMotorDot = xMotorDotSplit[i];
+        }
+    }
+
+    void EngineMultiRobot::computeKinematicTrajectory(systemDataHolder_t       & system,
+                                                      float64_t          const & t)
+    {
+        pinocchio::Model const & pncModel = system.robot->pncModel_;
+        kinematicTrajectory_t const & trajectory = system.trajectory;
+        vectorN_t const & times = trajectory.times;
+        int32_t const nKnots = times.size();
+        systemState_t & state = system.state;
+
+        // Hold the configuration out of the time range of the trajectory
+        if (t <= times[0] || t >= times[nKnots - 1])
+        {
+            state.q = trajectory.positions.col((t <= times[0]) ? 0 : nKnots - 1);
+            state.v.setZero();
+            state.a.setZero();
+            state.qDot.setZero();
+            return;
+        }
+
+        // Find the segment of the trajectory
+        int32_t const i = std::distance(times.data(), std::upper_bound(times.data(), times.data() + nKnots, t)) - 1;
+        float64_t const h = times[i + 1] - times[i];
+        float64_t const s = (t - times[i]) / h;
+
+        // Evaluate the cubic Hermite basis functions, and their derivatives wrt time
+        float64_t const s2 = s * s;
+        float64_t const s3 = s2 * s;
+        std::array<float64_t, 3> const basisSlope1 {{h * (s3 - 2 * s2 + s), 3 * s2 - 4 * s + 1, (6 * s - 4) / h}};
+        std::array<float64_t, 3> const basisDelta {{-2 * s3 + 3 * s2, (-6 * s2 + 6 * s) / h, (-12 * s + 6) / (h * h)}};
+        std::array<float64_t, 3> const basisSlope2 {{h * (s3 - s2), 3 * s2 - 2 * s, (6 * s - 2) / h}};
+
+        // Interpolate in tangent space, starting from the configuration of the previous knot
+        auto const evaluate =
+            [&](uint8_t const & order) -> vectorN_t
+            {
+                return basisSlope1[order] * trajectory.slopes.col(i)
+                     + basisDelta[order] * trajectory.deltas.col(i)
+                     + basisSlope2[order] * trajectory.slopes.col(i + 1);
+            };
+        state.q = pinocchio::integrate(pncModel, trajectory.positions.col(i), evaluate(0));
+        state.v = evaluate(1);
+        state.a = evaluate(2);
+        computePositionDerivative(pncModel, state.q, state.v, state.qDot, SIMULATION_MIN_TIMESTEP);
     }
 
-    void EngineMultiRobot::computeForwardKinematics(systemDataHolder_t       & system,
-                                                    vectorN_t          const & q,
-                                                    vectorN_t          const & v,
-                                                    vectorN_t          const & a)
+    void EngineMultiRobot::computeForwardKinematics(systemDataHolder_t                & system,
+                                                    Eigen::Ref<vectorN_t const> const & q,
+                                                    Eigen::Ref<vectorN_t const> const & v,
+                                                    Eigen::Ref<vectorN_t const> const & a,
+                                                    bool_t                      const & updateAllFrames)
     {
-        pinocchio::forwardKinematics(system.robot->pncModel_, system.robot->pncData_, q, v, a);
-        pinocchio::updateFramePlacements(system.robot->pncModel_, system.robot->pncData_);
+        system.robot->computeForwardKinematics(q, v, a, updateAllFrames);
     }
 
     pinocchio::Force EngineMultiRobot::computeContactDynamics(systemDataHolder_t const & system,
@@ -1719,8 +2728,6 @@ namespace jiminy
            It must then be converted into a force onto the parent joint.
            /!\ Note that the contact dynamics depends only on kinematics data. /!\ */
 
-        contactOptions_t const & contactOptions_ = engineOptions_->contacts;
-
         matrix3_t const & tformFrameRot = system.robot->pncData_.oMf[frameIdx].rotation();
         vector3_t const & posFrame = system.robot->pncData_.oMf[frameIdx].translation();
 
@@ -1738,57 +2745,67 @@ namespace jiminy
             vector3_t const motionFrame = pinocchio::getFrameVelocity(
                 system.robot->pncModel_, system.robot->pncData_, frameIdx).linear();
             vector3_t const vFrameInWorld = tformFrameRot * motionFrame;
-            float64_t const vDepth = vFrameInWorld.dot(nGround);
+            fextInWorld = computeContactForce(depth, nGround, vFrameInWorld);
+        }
+        else
+        {
+            fextInWorld.setZero();
+        }
 
-            // Compute normal force
-            float64_t fextNormal = 0.0;
-            if (vDepth < 0.0)
-            {
-                fextNormal -= contactOptions_.damping * vDepth;
-            }
-            fextNormal -= contactOptions_.stiffness * depth;
-            fextInWorld = fextNormal * nGround;
+        return {fextInWorld, vector3_t::Zero()};
+    }
 
-            // Compute friction forces
-            vector3_t const vTangential = vFrameInWorld - vDepth * nGround;
-            float64_t const vNorm = vTangential.norm();
+    vector3_t EngineMultiRobot::computeContactForce(float64_t const & depth,
+                                                    vector3_t const & normal,
+                                                    vector3_t const & velocity) const
+    {
+        contactOptions_t const & contactOptions_ = engineOptions_->contacts;
 
-            float64_t frictionCoeff = 0.0;
-            if (vNorm > contactOptions_.frictionStictionVel)
-            {
-                if (vNorm < (1.0 + contactOptions_.frictionStictionRatio) * contactOptions_.frictionStictionVel)
-                {
-                    float64_t const vRatio = vNorm / contactOptions_.frictionStictionVel;
-                    frictionCoeff = (contactOptions_.frictionDry * ((1.0 + contactOptions_.frictionStictionRatio) - vRatio)
-                                  - contactOptions_.frictionViscous * (1.0 - vRatio)) / contactOptions_.frictionStictionRatio;
-                }
-                else
-                {
-                    frictionCoeff = contactOptions_.frictionViscous;
-                }
-            }
-            else
+        // Compute normal force
+        float64_t const vDepth = velocity.dot(normal);
+        float64_t fextNormal = 0.0;
+        if (vDepth < 0.0)
+        {
+            fextNormal -= contactOptions_.damping * vDepth;
+        }
+        fextNormal -= contactOptions_.stiffness * depth;
+        vector3_t fextInWorld = fextNormal * normal;
+
+        // Compute friction forces
+        vector3_t const vTangential = velocity - vDepth * normal;
+        float64_t const vNorm = vTangential.norm();
+
+        float64_t frictionCoeff = 0.0;
+        if (vNorm > contactOptions_.frictionStictionVel)
+        {
+            if (vNorm < (1.0 + contactOptions_.frictionStictionRatio) * contactOptions_.frictionStictionVel)
             {
                 float64_t const vRatio = vNorm / contactOptions_.frictionStictionVel;
-                frictionCoeff = contactOptions_.frictionDry * vRatio;
+                frictionCoeff = (contactOptions_.frictionDry * ((1.0 + contactOptions_.frictionStictionRatio) - vRatio)
+                              - contactOptions_.frictionViscous * (1.0 - vRatio)) / contactOptions_.frictionStictionRatio;
             }
-            float64_t const fextTangential = frictionCoeff * fextNormal;
-            fextInWorld += -fextTangential * vTangential;
-
-            // Add blending factor
-            if (contactOptions_.transitionEps > EPS)
+            else
             {
-                float64_t const blendingFactor = -depth / contactOptions_.transitionEps;
-                float64_t const blendingLaw = std::tanh(2 * blendingFactor);
-                fextInWorld *= blendingLaw;
+                frictionCoeff = contactOptions_.frictionViscous;
             }
         }
         else
         {
-            fextInWorld.setZero();
+            float64_t const vRatio = vNorm / contactOptions_.frictionStictionVel;
+            frictionCoeff = contactOptions_.frictionDry * vRatio;
         }
+        float64_t const fextTangential = frictionCoeff * fextNormal;
+        fextInWorld += -fextTangential * vTangential;
 
-        return {fextInWorld, vector3_t::Zero()};
+        // Add blending factor
+        if (contactOptions_.transitionEps > EPS)
+        {
+            float64_t const blendingFactor = -depth / contactOptions_.transitionEps;
+            float64_t const blendingLaw = std::tanh(2 * blendingFactor);
+            fextInWorld *= blendingLaw;
+        }
+
+        return fextInWorld;
     }
 
     void EngineMultiRobot::computeCommand(systemDataHolder_t                & system,
@@ -1800,6 +2817,26 @@ namespace jiminy
         // Reinitialize the external forces
         u.setZero();
 
+        // Evaluate the sensors whose update has been deferred, only for the types read by the controller
+        std::vector<std::string> const & sensorsTypesRead = system.controller->baseControllerOptions_->sensorsTypesRead;
+        if (sensorsTypesRead.empty())
+        {
+            system.robot->flushSensorsData();
+        }
+        else
+        {
+            system.robot->flushSensorsData(sensorsTypesRead);
+        }
+
+        /* Update the placement of every frame at the breakpoints of the controller, since it
+           may read any of them. It is not done in continuous control, so that the evaluations
+           of the dynamics keep updating only the frames used by the simulation. The controller
+           must flush the other frames on demand in such a case. */
+        if (system.controllerUpdatePeriod >= SIMULATION_MIN_TIMESTEP)
+        {
+            system.robot->computeForwardKinematics(q, v, true);
+        }
+
         // Command the command
         system.controller->computeCommand(t, q, v, u);
     }
@@ -1818,93 +2855,74 @@ namespace jiminy
 
         // Define some proxies
         auto const & jointOptions = engineOptions_->joints;
-        pinocchio::Model const & pncModel = system.robot->pncModel_;
-
-        // Enforce the position limit for the rigid joints only (TODO: Add support of spherical and planar joints)
-        if (system.robot->mdlOptions_->joints.enablePositionLimit)
-        {
-            vectorN_t const & positionLimitMin = system.robot->getPositionLimitMin();
-            vectorN_t const & positionLimitMax = system.robot->getPositionLimitMax();
-            for (int32_t const & rigidIdx : system.robot->getRigidJointsModelIdx())
+        bool_t const & enablePositionLimit = system.robot->mdlOptions_->joints.enablePositionLimit;
+        bool_t const & enableVelocityLimit = system.robot->mdlOptions_->joints.enableVelocityLimit;
+
+        /* Enforce the position and velocity limits of the rigid joints. The bounded degrees of
+           freedom are gathered in contiguous buffers, so that the bound forces of every joint
+           are evaluated at once by branch-free array expressions, then scattered back. */
+        std::vector<int32_t> const & boundedPositionIdx = system.robot->getBoundedJointsPositionIdx();
+        std::vector<int32_t> const & boundedVelocityIdx = system.robot->getBoundedJointsVelocityIdx();
+        uint32_t const nBounded = boundedPositionIdx.size();
+        if ((enablePositionLimit || enableVelocityLimit) && nBounded > 0U)
+        {
+            vectorN_t & qBounded = system.jointsBoundedPosition;
+            vectorN_t & vBounded = system.jointsBoundedVelocity;
+            vectorN_t & uBounded = system.jointsBoundedEffort;
+            qBounded.resize(nBounded);  // No-op if the size does not change
+            vBounded.resize(nBounded);
+            uBounded.resize(nBounded);
+            for (uint32_t i = 0; i < nBounded; i++)
             {
-                uint32_t const & positionIdx = pncModel.joints[rigidIdx].idx_q();
-                uint32_t const & velocityIdx = pncModel.joints[rigidIdx].idx_v();
-                int32_t const & jointDof = pncModel.joints[rigidIdx].nq();
-                for (int32_t j = 0; j < jointDof; j++)
-                {
-                    float64_t const & qJoint = q[positionIdx + j];
-                    float64_t const & vJoint = v[velocityIdx + j];
-                    float64_t const & qJointMin = positionLimitMin[positionIdx + j];
-                    float64_t const & qJointMax = positionLimitMax[positionIdx + j];
-
-                    float64_t qJointError = 0.0;
-                    float64_t vJointError = 0.0;
-                    if (qJoint > qJointMax)
-                    {
-                        qJointError = qJoint - qJointMax;
-                        vJointError = std::max(vJoint, 0.0);
-                    }
-                    else if (qJoint < qJointMin)
-                    {
-                        qJointError = qJoint - qJointMin;
-                        vJointError = std::min(vJoint, 0.0);
-                    }
-                    float64_t const blendingFactor = std::abs(qJointError - jointOptions.transitionPositionEps *
-                        std::tanh(qJointError / jointOptions.transitionPositionEps));
-                    float64_t const forceJoint = - jointOptions.boundStiffness * qJointError
-                                                 - jointOptions.boundDamping * blendingFactor * vJointError;
-
-                    u[velocityIdx + j] += forceJoint;
-                }
+                qBounded[i] = q[boundedPositionIdx[i]];
+                vBounded[i] = v[boundedVelocityIdx[i]];
             }
-        }
+            uBounded.setZero();
 
-        // Enforce the velocity limit (do not support spherical joints)
-        if (system.robot->mdlOptions_->joints.enableVelocityLimit)
-        {
-            vectorN_t const & velocityLimitMax = system.robot->getVelocityLimit();
-            for (int32_t const & rigidIdx : system.robot->getRigidJointsModelIdx())
+            if (enablePositionLimit)
             {
-                uint32_t const & velocityIdx = pncModel.joints[rigidIdx].idx_v();
-                uint32_t const & jointDof = pncModel.joints[rigidIdx].nq();
-                for (uint32_t j = 0; j < jointDof; j++)
-                {
-                    float64_t const & vJoint = v[velocityIdx + j];
-                    float64_t const & vJointMin = -velocityLimitMax[velocityIdx + j];
-                    float64_t const & vJointMax = velocityLimitMax[velocityIdx + j];
+                // At most one of the two terms is non-zero, since the lower bound is below the upper one
+                auto const qJointError =
+                    (qBounded.array() - system.robot->getBoundedJointsPositionLimitMax().array()).max(0.0)
+                  + (qBounded.array() - system.robot->getBoundedJointsPositionLimitMin().array()).min(0.0);
+                // The velocity is only damped if going further out of the bounds
+                auto const vJointError = (qJointError * vBounded.array() > 0.0).select(vBounded.array(), 0.0);
+                auto const blendingFactor = (qJointError - jointOptions.transitionPositionEps *
+                    (qJointError / jointOptions.transitionPositionEps).tanh()).abs();
+                uBounded.array() -= jointOptions.boundStiffness * qJointError
+                                  + jointOptions.boundDamping * blendingFactor * vJointError;
+            }
 
-                    float64_t vJointError = 0.0;
-                    if (vJoint > vJointMax)
-                    {
-                        vJointError = vJoint - vJointMax;
-                    }
-                    else if (vJoint < vJointMin)
-                    {
-                        vJointError = vJoint - vJointMin;
-                    }
-                    float64_t forceJoint = - jointOptions.boundDamping *
-                        std::tanh(vJointError / jointOptions.transitionVelocityEps);
+            if (enableVelocityLimit)
+            {
+                vectorN_t const & vJointMax = system.robot->getBoundedJointsVelocityLimit();
+                auto const vJointError = (vBounded.array() - vJointMax.array()).max(0.0)
+                                       + (vBounded.array() + vJointMax.array()).min(0.0);
+                uBounded.array() -= jointOptions.boundDamping *
+                    (vJointError / jointOptions.transitionVelocityEps).tanh();
+            }
 
-                    u[velocityIdx + j] += forceJoint;
-                }
+            for (uint32_t i = 0; i < nBounded; i++)
+            {
+                u[boundedVelocityIdx[i]] += uBounded[i];
             }
         }
 
         // Compute the flexibilities (only support joint_t::SPHERICAL so far)
-        Robot::dynamicsOptions_t const & mdlDynOptions = system.robot->mdlOptions_->dynamics;
-        std::vector<int32_t> const & flexibilityIdx = system.robot->getFlexibleJointsModelIdx();
-        for (uint32_t i=0; i<flexibilityIdx.size(); ++i)
+        std::vector<int32_t> const & flexibilityPositionIdx = system.robot->getFlexibleJointsPositionIdx();
+        std::vector<int32_t> const & flexibilityVelocityIdx = system.robot->getFlexibleJointsVelocityIdx();
+        matrixN_t const & flexibilityStiffness = system.robot->getFlexibleJointsStiffness();
+        matrixN_t const & flexibilityDamping = system.robot->getFlexibleJointsDamping();
+        for (uint32_t i=0; i<flexibilityPositionIdx.size(); ++i)
         {
-            uint32_t const & positionIdx = pncModel.joints[flexibilityIdx[i]].idx_q();
-            uint32_t const & velocityIdx = pncModel.joints[flexibilityIdx[i]].idx_v();
-            vectorN_t const & stiffness = mdlDynOptions.flexibilityConfig[i].stiffness;
-            vectorN_t const & damping = mdlDynOptions.flexibilityConfig[i].damping;
+            int32_t const & positionIdx = flexibilityPositionIdx[i];
+            int32_t const & velocityIdx = flexibilityVelocityIdx[i];
 
             float64_t theta;
-            quaternion_t const quat(q.segment<4>(positionIdx).data()); // Only way to initialize with [x,y,z,w] order
-            vectorN_t const axis = pinocchio::quaternion::log3(quat, theta);
-            u.segment<3>(velocityIdx).array() += - stiffness.array() * axis.array()
-                - damping.array() * v.segment<3>(velocityIdx).array();
+            Eigen::Map<quaternion_t const> const quat(q.segment<4>(positionIdx).data()); // Only way to initialize with [x,y,z,w] order
+            vector3_t const axis = pinocchio::quaternion::log3(quat, theta);
+            u.segment<3>(velocityIdx).array() += - flexibilityStiffness.col(i).array() * axis.array()
+                - flexibilityDamping.col(i).array() * v.segment<3>(velocityIdx).array();
         }
     }
 
@@ -1914,9 +2932,11 @@ namespace jiminy
                                                  Eigen::Ref<vectorN_t const> const & v,
                                                  forceVector_t                     & fext)
     {
-        // Compute the contact forces
+        /* Compute the contact forces.
+           Note that they are computed by the time-stepping scheme itself at
+           velocity-level if enabled, since they are impulses in such a case. */
         std::vector<int32_t> const & contactFramesIdx = system.robot->getContactFramesIdx();
-        for (uint32_t i=0; i < contactFramesIdx.size(); i++)
+        for (uint32_t i=0; i < contactFramesIdx.size() && !isContactTimeStepping_; i++)
         {
             // Compute force in the contact frame.
             int32_t const & frameIdx = contactFramesIdx[i];
@@ -1955,14 +2975,69 @@ namespace jiminy
         {
             int32_t const & frameIdx = forceProfile.frameIdx;
             int32_t const & parentIdx = system.robot->pncModel_.frames[frameIdx].parent;
-            forceProfileFunctor_t const & forceFct = forceProfile.forceFct;
 
-            pinocchio::Force const force = forceFct(t, q, v);
+            // Sampled profiles are updated by the timed events only
+            pinocchio::Force force;
+            if (forceProfile.updatePeriod > EPS)
+            {
+                force = forceProfile.forcePrev;
+            }
+            else
+            {
+                forceProfileFunctor_t const & forceFct = forceProfile.forceFct;
+                force = forceFct(t, q, v);
+            }
+            fext[parentIdx] += computeFrameForceOnParentJoint(
+                system.robot->pncModel_, system.robot->pncData_, frameIdx, force);
+        }
+
+        // Add the effect of native external force profiles
+        for (auto const & forceProfile : system.forcesProfileNative)
+        {
+            int32_t const & frameIdx = forceProfile.frameIdx;
+            int32_t const & parentIdx = system.robot->pncModel_.frames[frameIdx].parent;
+
+            float64_t const ratio = std::sin(2 * M_PI * forceProfile.frequency * t + forceProfile.phase);
+            pinocchio::Force const force(forceProfile.offset.toVector()
+                                       + ratio * forceProfile.amplitude.toVector());
             fext[parentIdx] += computeFrameForceOnParentJoint(
                 system.robot->pncModel_, system.robot->pncData_, frameIdx, force);
         }
     }
 
+    pinocchio::Force EngineMultiRobot::computeCouplingForceNative(forceCouplingNative_t const & force) const
+    {
+        // Define some proxies
+        Robot const & robot1 = *systemsDataHolder_[force.systemIdx1].robot;
+        Robot const & robot2 = *systemsDataHolder_[force.systemIdx2].robot;
+        pinocchio::SE3 const & transform1 = robot1.pncData_.oMf[force.frameIdx1];
+        pinocchio::SE3 const & transform2 = robot2.pncData_.oMf[force.frameIdx2];
+
+        // Compute the direction and length of the line going through both frames
+        vector3_t dir = transform2.translation() - transform1.translation();
+        float64_t const length = dir.norm();
+        if (length < EPS || (force.isTether && length < force.restLength))
+        {
+            return pinocchio::Force::Zero();
+        }
+        dir /= length;
+
+        // Compute the relative velocity of both frames along this line, in world frame
+        vector3_t const velocity1 = transform1.rotation() * pinocchio::getFrameVelocity(
+            robot1.pncModel_, robot1.pncData_, force.frameIdx1).linear();
+        vector3_t const velocity2 = transform2.rotation() * pinocchio::getFrameVelocity(
+            robot2.pncModel_, robot2.pncData_, force.frameIdx2).linear();
+        float64_t const lengthDot = (velocity2 - velocity1).dot(dir);
+
+        // Compute the force applied by the second system on the first one
+        float64_t intensity = force.stiffness * (length - force.restLength) + force.damping * lengthDot;
+        if (force.isTether)
+        {
+            intensity = std::max(intensity, 0.0);
+        }
+        return pinocchio::Force(intensity * dir, vector3_t::Zero());
+    }
+
     void EngineMultiRobot::computeInternalForces(float64_t                       const & t,
                                                  stateSplitRef_t<std::add_const> const & xSplit)
     {
@@ -1991,6 +3066,374 @@ namespace jiminy
             fext2[parentIdx2] += computeFrameForceOnParentJoint(
                 system2.robot->pncModel_, system2.robot->pncData_, frameIdx2, -force);
         }
+
+        /* Compute the native coupling forces of every system at once. They only depend
+           on the kinematics, so they are independent of each other and can be evaluated
+           in any order, before being applied on the systems. */
+        for (uint32_t i = 0; i < forcesCouplingNative_.size(); i++)
+        {
+            forcesCouplingNativeValue_[i] = computeCouplingForceNative(forcesCouplingNative_[i]);
+        }
+        for (uint32_t i = 0; i < forcesCouplingNative_.size(); i++)
+        {
+            forceCouplingNative_t const & forceCoupling = forcesCouplingNative_[i];
+            pinocchio::Force const & force = forcesCouplingNativeValue_[i];
+            systemDataHolder_t & system1 = systemsDataHolder_[forceCoupling.systemIdx1];
+            systemDataHolder_t & system2 = systemsDataHolder_[forceCoupling.systemIdx2];
+            int32_t const & frameIdx1 = forceCoupling.frameIdx1;
+            int32_t const & frameIdx2 = forceCoupling.frameIdx2;
+
+            int32_t const & parentIdx1 = system1.robot->pncModel_.frames[frameIdx1].parent;
+            system1.state.fExternal[parentIdx1] += computeFrameForceOnParentJoint(
+                system1.robot->pncModel_, system1.robot->pncData_, frameIdx1, force);
+            int32_t const & parentIdx2 = system2.robot->pncModel_.frames[frameIdx2].parent;
+            system2.state.fExternal[parentIdx2] += computeFrameForceOnParentJoint(
+                system2.robot->pncModel_, system2.robot->pncData_, frameIdx2, -force);
+        }
+
+        // Compute the short-range interaction forces between the frames of every system
+        computeInteractionForces();
+
+        // Compute the contact forces of the colliding bodies
+        computeCollisionForces();
+    }
+
+    void EngineMultiRobot::updateInteractionPairs(void)
+    {
+        /* Hash the interaction frames in a uniform grid whose cells are larger than the
+           cutoff radius, so that interacting frames are necessarily in adjacent cells.
+           The margin makes the candidate pairs valid over a whole step. Each cell index
+           is stored on 21 bits, adjacent cells included. */
+        int64_t const cellOffset = 1LL << 20;
+        int64_t const cellIdxMax = cellOffset - 2;
+        interactionOptions_t const & options = engineOptions_->interactions;
+        float64_t const cellSize = options.cutoffRadius + options.broadphaseMargin;
+        auto const cellKey =
+            [cellOffset](int64_t const & ix, int64_t const & iy, int64_t const & iz) -> int64_t
+            {
+                return ((ix + cellOffset) << 42) | ((iy + cellOffset) << 21) | (iz + cellOffset);
+            };
+
+        /* The cell indices are clamped, so that they always fit in the key. The farthest
+           cells are merged in such a case, which only adds candidate pairs that are then
+           discarded based on their actual distance. A non-finite position is clamped too. */
+        auto const getCellIdx =
+            [cellSize, cellIdxMax](float64_t const & pos) -> int64_t
+            {
+                float64_t const cellIdx = std::floor(pos / cellSize);
+                if (!(cellIdx > static_cast<float64_t>(-cellIdxMax)))
+                {
+                    return -cellIdxMax;
+                }
+                if (cellIdx > static_cast<float64_t>(cellIdxMax))
+                {
+                    return cellIdxMax;
+                }
+                return static_cast<int64_t>(cellIdx);
+            };
+
+        std::vector<std::array<int64_t, 3> > cellsIdx;
+        cellsIdx.reserve(interactionFrames_.size());
+        interactionCells_.clear();
+        for (uint32_t i = 0; i < interactionFrames_.size(); i++)
+        {
+            interactionFrame_t const & frame = interactionFrames_[i];
+            vector3_t const & pos = systemsDataHolder_[frame.systemIdx].robot->pncData_.oMf[frame.frameIdx].translation();
+            std::array<int64_t, 3> const cellIdx {{getCellIdx(pos[0]), getCellIdx(pos[1]), getCellIdx(pos[2])}};
+            cellsIdx.push_back(cellIdx);
+            interactionCells_.emplace_back(cellKey(cellIdx[0], cellIdx[1], cellIdx[2]), i);
+        }
+        std::sort(interactionCells_.begin(), interactionCells_.end());
+
+        // Gather the pairs of frames of different systems in the same or adjacent cells
+        interactionPairs_.clear();
+        for (uint32_t i = 0; i < interactionFrames_.size(); i++)
+        {
+            std::array<int64_t, 3> const & cellIdx = cellsIdx[i];
+            for (int64_t dx = -1; dx <= 1; dx++)
+            {
+                for (int64_t dy = -1; dy <= 1; dy++)
+                {
+                    for (int64_t dz = -1; dz <= 1; dz++)
+                    {
+                        int64_t const key = cellKey(cellIdx[0] + dx, cellIdx[1] + dy, cellIdx[2] + dz);
+                        auto cellIt = std::lower_bound(interactionCells_.begin(), interactionCells_.end(),
+                                                       std::make_pair(key, static_cast<int32_t>(i + 1)));
+                        for ( ; cellIt != interactionCells_.end() && cellIt->first == key; cellIt++)
+                        {
+                            int32_t const & j = cellIt->second;
+                            if (interactionFrames_[i].systemIdx != interactionFrames_[j].systemIdx)
+                            {
+                                interactionPairs_.emplace_back(i, j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void EngineMultiRobot::computeInteractionForces(void)
+    {
+        interactionOptions_t const & options = engineOptions_->interactions;
+        for (auto const & interactionPair : interactionPairs_)
+        {
+            interactionFrame_t const & frame1 = interactionFrames_[interactionPair.first];
+            interactionFrame_t const & frame2 = interactionFrames_[interactionPair.second];
+            systemDataHolder_t & system1 = systemsDataHolder_[frame1.systemIdx];
+            systemDataHolder_t & system2 = systemsDataHolder_[frame2.systemIdx];
+            pinocchio::SE3 const & transform1 = system1.robot->pncData_.oMf[frame1.frameIdx];
+            pinocchio::SE3 const & transform2 = system2.robot->pncData_.oMf[frame2.frameIdx];
+
+            // Compute the distance between both frames, and skip them if they are too far
+            vector3_t dir = transform2.translation() - transform1.translation();
+            float64_t const length = dir.norm();
+            if (length < EPS || length > options.cutoffRadius)
+            {
+                continue;
+            }
+            dir /= length;
+
+            // Compute the relative velocity of both frames along the line going through them
+            vector3_t const velocity1 = transform1.rotation() * pinocchio::getFrameVelocity(
+                system1.robot->pncModel_, system1.robot->pncData_, frame1.frameIdx).linear();
+            vector3_t const velocity2 = transform2.rotation() * pinocchio::getFrameVelocity(
+                system2.robot->pncModel_, system2.robot->pncData_, frame2.frameIdx).linear();
+            float64_t const lengthDot = (velocity2 - velocity1).dot(dir);
+
+            // The force smoothly vanishes at the cutoff radius
+            float64_t const ratio = 1.0 - std::pow(length / options.cutoffRadius, 2);
+            float64_t const intensity = (options.stiffness * (length - options.restLength)
+                                       + options.damping * lengthDot) * ratio * ratio;
+            pinocchio::Force const force(intensity * dir, vector3_t::Zero());
+
+            // Apply the force on the first frame, and the opposite on the second one
+            int32_t const & parentIdx1 = system1.robot->pncModel_.frames[frame1.frameIdx].parent;
+            system1.state.fExternal[parentIdx1] += computeFrameForceOnParentJoint(
+                system1.robot->pncModel_, system1.robot->pncData_, frame1.frameIdx, force);
+            int32_t const & parentIdx2 = system2.robot->pncModel_.frames[frame2.frameIdx].parent;
+            system2.state.fExternal[parentIdx2] += computeFrameForceOnParentJoint(
+                system2.robot->pncModel_, system2.robot->pncData_, frame2.frameIdx, -force);
+        }
+    }
+
+    void EngineMultiRobot::updateCollisionPairs(bool_t const & isForced)
+    {
+        collisionOptions_t const & options = engineOptions_->collisions;
+
+        // Compute the center of the geometries, and check whether any of them has moved significantly
+        bool_t isBroadphaseValid = !isForced;
+        std::vector<vector3_t> centers;
+        centers.reserve(collisionBodies_.size());
+        for (collisionBody_t const & body : collisionBodies_)
+        {
+            Robot const & robot = *systemsDataHolder_[body.systemIdx].robot;
+            collisionGeometry_t const & geometry = robot.getCollisionGeometries()[body.geometryIdx];
+            centers.push_back((robot.pncData_.oMi[geometry.jointIdx] * geometry.jointPlacement).translation());
+            isBroadphaseValid &= (centers.back() - body.centerRef).norm() < 0.5 * options.broadphaseMargin;
+        }
+        if (isBroadphaseValid)
+        {
+            return;
+        }
+
+        // Update the bounding boxes, inflated by half of the margin on each side
+        for (uint32_t i = 0; i < collisionBodies_.size(); i++)
+        {
+            collisionBody_t & body = collisionBodies_[i];
+            Robot const & robot = *systemsDataHolder_[body.systemIdx].robot;
+            float64_t const radius = robot.getCollisionGeometries()[body.geometryIdx].boundingRadius
+                                   + 0.5 * options.broadphaseMargin;
+            body.centerRef = centers[i];
+            body.lowerBound = centers[i] - vector3_t::Constant(radius);
+            body.upperBound = centers[i] + vector3_t::Constant(radius);
+        }
+
+        /* Sort the bodies along x-axis. Insertion sort is used on purpose, since the order
+           barely changes from one update to the next, so that it is linear in practice. */
+        for (uint32_t i = 1; i < collisionSweepOrder_.size(); i++)
+        {
+            int32_t const bodyIdx = collisionSweepOrder_[i];
+            float64_t const & lowerBound = collisionBodies_[bodyIdx].lowerBound[0];
+            uint32_t j = i;
+            for ( ; j > 0 && collisionBodies_[collisionSweepOrder_[j - 1]].lowerBound[0] > lowerBound; j--)
+            {
+                collisionSweepOrder_[j] = collisionSweepOrder_[j - 1];
+            }
+            collisionSweepOrder_[j] = bodyIdx;
+        }
+
+        // Sweep along x-axis, then prune the pairs whose bounding boxes do not overlap along the other axes
+        collisionPairs_.clear();
+        for (uint32_t i = 0; i < collisionSweepOrder_.size(); i++)
+        {
+            collisionBody_t const & body1 = collisionBodies_[collisionSweepOrder_[i]];
+            for (uint32_t j = i + 1; j < collisionSweepOrder_.size(); j++)
+            {
+                collisionBody_t const & body2 = collisionBodies_[collisionSweepOrder_[j]];
+                if (body2.lowerBound[0] > body1.upperBound[0])
+                {
+                    break;
+                }
+                if ((body2.lowerBound.tail<2>().array() > body1.upperBound.tail<2>().array()).any()
+                 || (body1.lowerBound.tail<2>().array() > body2.upperBound.tail<2>().array()).any())
+                {
+                    continue;
+                }
+
+                // Filter the pairs of bodies depending on the options
+                if (body1.systemIdx == body2.systemIdx)
+                {
+                    if (!options.enableSelf)
+                    {
+                        continue;
+                    }
+
+                    /* Discard the geometries of the same body or of adjacent bodies, since they
+                       are overlapping by design most of the time. */
+                    Robot const & robot = *systemsDataHolder_[body1.systemIdx].robot;
+                    int32_t const & jointIdx1 = robot.getCollisionGeometries()[body1.geometryIdx].jointRigidIdx;
+                    int32_t const & jointIdx2 = robot.getCollisionGeometries()[body2.geometryIdx].jointRigidIdx;
+                    if (jointIdx1 == jointIdx2
+                     || static_cast<int32_t>(robot.pncModelRigidOrig_->parents[jointIdx1]) == jointIdx2
+                     || static_cast<int32_t>(robot.pncModelRigidOrig_->parents[jointIdx2]) == jointIdx1)
+                    {
+                        continue;
+                    }
+                }
+                else if (!options.enableSystems)
+                {
+                    continue;
+                }
+
+                collisionPairs_.emplace_back(collisionSweepOrder_[i], collisionSweepOrder_[j]);
+            }
+        }
+
+        // Gather the bodies close to the ground
+        collisionGroundCandidates_.clear();
+        if (options.enableGround)
+        {
+            for (uint32_t i = 0; i < collisionBodies_.size(); i++)
+            {
+                collisionBody_t const & body = collisionBodies_[i];
+                auto ground = engineOptions_->world.groundProfile(body.centerRef);
+                float64_t const & zGround = std::get<float64_t>(ground);
+                vector3_t & nGround = std::get<vector3_t>(ground);
+                nGround.normalize();
+                float64_t const height = (body.centerRef[2] - zGround) * nGround[2];
+                if (height < body.centerRef[2] - body.lowerBound[2])
+                {
+                    collisionGroundCandidates_.push_back(i);
+                }
+            }
+        }
+    }
+
+    void EngineMultiRobot::computeCollisionForces(void)
+    {
+        /* Apply a force on a body at a given point, both in world frame, and return the
+           velocity of the body at this point in world frame. */
+        auto const getPointVelocity =
+            [](Robot const & robot, int32_t const & jointIdx, vector3_t const & pos) -> vector3_t
+            {
+                pinocchio::SE3 const & transformJoint = robot.pncData_.oMi[jointIdx];
+                vector3_t const posLocal = transformJoint.rotation().transpose() * (pos - transformJoint.translation());
+                pinocchio::Motion const & motionJoint = robot.pncData_.v[jointIdx];
+                return transformJoint.rotation() * (motionJoint.linear() + motionJoint.angular().cross(posLocal));
+            };
+        auto const applyPointForce =
+            [](systemDataHolder_t & system, int32_t const & jointIdx,
+               vector3_t const & pos, vector3_t const & force)
+            {
+                pinocchio::SE3 const & transformJoint = system.robot->pncData_.oMi[jointIdx];
+                vector3_t const posLocal = transformJoint.rotation().transpose() * (pos - transformJoint.translation());
+                vector3_t const forceLocal = transformJoint.rotation().transpose() * force;
+                system.state.fExternal[jointIdx] += pinocchio::Force(forceLocal, posLocal.cross(forceLocal));
+            };
+
+        // Collisions between the bodies and the ground
+        for (int32_t const & bodyIdx : collisionGroundCandidates_)
+        {
+            collisionBody_t const & body = collisionBodies_[bodyIdx];
+            systemDataHolder_t & system = systemsDataHolder_[body.systemIdx];
+            collisionGeometry_t const & geometry = system.robot->getCollisionGeometries()[body.geometryIdx];
+            pinocchio::SE3 const transform = system.robot->pncData_.oMi[geometry.jointIdx] * geometry.jointPlacement;
+
+            // The spheres are handled through their center, every other geometry through their probe points
+            float64_t const radius = (geometry.shape == collisionShape_t::SPHERE) ? geometry.size[0] : 0.0;
+            std::vector<vector3_t> const centerPoint {vector3_t::Zero()};
+            std::vector<vector3_t> const & probePoints =
+                (geometry.shape == collisionShape_t::SPHERE) ? centerPoint : geometry.probePoints;
+            for (vector3_t const & probePoint : probePoints)
+            {
+                vector3_t const pos = transform.rotation() * probePoint + transform.translation();
+                auto ground = engineOptions_->world.groundProfile(pos);
+                float64_t const & zGround = std::get<float64_t>(ground);
+                vector3_t & nGround = std::get<vector3_t>(ground);
+                nGround.normalize();
+                float64_t const depth = (pos[2] - zGround) * nGround[2] - radius; // First-order projection (exact assuming flat surface)
+                if (depth < 0.0)
+                {
+                    vector3_t const posContact = pos - radius * nGround;
+                    vector3_t const velocity = getPointVelocity(*system.robot, geometry.jointIdx, posContact);
+                    vector3_t const force = computeContactForce(depth, nGround, velocity);
+                    applyPointForce(system, geometry.jointIdx, posContact, force);
+                }
+            }
+        }
+
+        // Collisions between the bodies themselves
+        for (auto const & collisionPair : collisionPairs_)
+        {
+            for (uint8_t k = 0; k < 2; k++)
+            {
+                /* The probe points of the first body are tested against the surface of the second
+                   one, then the other way around. A sphere being fully described by its center,
+                   it is tested through its center only, so that the second pass is redundant for
+                   a pair of spheres. */
+                collisionBody_t const & body1 = collisionBodies_[(k == 0) ? collisionPair.first : collisionPair.second];
+                collisionBody_t const & body2 = collisionBodies_[(k == 0) ? collisionPair.second : collisionPair.first];
+                systemDataHolder_t & system1 = systemsDataHolder_[body1.systemIdx];
+                systemDataHolder_t & system2 = systemsDataHolder_[body2.systemIdx];
+                collisionGeometry_t const & geometry1 = system1.robot->getCollisionGeometries()[body1.geometryIdx];
+                collisionGeometry_t const & geometry2 = system2.robot->getCollisionGeometries()[body2.geometryIdx];
+                bool_t const isSphere1 = (geometry1.shape == collisionShape_t::SPHERE);
+                bool_t const isSphere2 = (geometry2.shape == collisionShape_t::SPHERE);
+                if (isSphere1 && isSphere2 && k == 1)
+                {
+                    continue;
+                }
+
+                pinocchio::SE3 const transform1 = system1.robot->pncData_.oMi[geometry1.jointIdx] * geometry1.jointPlacement;
+                pinocchio::SE3 const transform2 = system2.robot->pncData_.oMi[geometry2.jointIdx] * geometry2.jointPlacement;
+                float64_t const radius = isSphere1 ? geometry1.size[0] : 0.0;
+                std::vector<vector3_t> const centerPoint {vector3_t::Zero()};
+                std::vector<vector3_t> const & probePoints = isSphere1 ? centerPoint : geometry1.probePoints;
+                for (vector3_t const & probePoint : probePoints)
+                {
+                    // Compute the penetration of the probe point in the second body
+                    vector3_t const pos = transform1.rotation() * probePoint + transform1.translation();
+                    vector3_t normalLocal;
+                    vector3_t const posLocal = transform2.rotation().transpose() * (pos - transform2.translation());
+                    float64_t const depth = computeSignedDistance(geometry2, posLocal, normalLocal) - radius;
+                    if (depth >= 0.0)
+                    {
+                        continue;
+                    }
+
+                    // Apply the contact force on the first body, and the opposite on the second one
+                    vector3_t const normal = transform2.rotation() * normalLocal;
+                    vector3_t const posContact = pos - radius * normal;
+                    vector3_t const velocity =
+                        getPointVelocity(*system1.robot, geometry1.jointIdx, posContact)
+                      - getPointVelocity(*system2.robot, geometry2.jointIdx, posContact);
+                    vector3_t const force = computeContactForce(depth, normal, velocity);
+                    applyPointForce(system1, geometry1.jointIdx, posContact, force);
+                    applyPointForce(system2, geometry2.jointIdx, posContact, -force);
+                }
+            }
+        }
     }
 
     void EngineMultiRobot::computeAllForces(float64_t                       const & t,
@@ -2040,6 +3483,8 @@ namespace jiminy
         // Split the input state and derivative (by reference)
         auto xSplit = splitState(xCat);
         auto dxdtSplit = splitState(dxdtCat);
+        auto xMotorSplit = splitMotorsState(xCat);
+        auto xMotorDotSplit = splitMotorsState(dxdtCat);
 
         // Update the kinematics of each system
         auto systemIt = systemsDataHolder_.begin();
@@ -2048,12 +3493,19 @@ namespace jiminy
         for ( ; systemIt != systemsDataHolder_.end();
              systemIt++, qSplitIt++, vSplitIt++)
         {
+            /* Evaluate the trajectory of the kinematic systems at the current time.
+               Note that their state split refers to their own state buffers. */
+            if (systemIt->isKinematic)
+            {
+                computeKinematicTrajectory(*systemIt, t);
+            }
+
             // Define some proxies
             Eigen::Ref<vectorN_t const> const & q = *qSplitIt;
             Eigen::Ref<vectorN_t const> const & v = *vSplitIt;
-            vectorN_t const & aPrev = systemIt->statePrev.a;
+            vectorN_t const & aPrev = systemIt->isKinematic ? systemIt->state.a : systemIt->statePrev.a;
 
-            computeForwardKinematics(*systemIt, q, v, aPrev);
+            computeForwardKinematics(*systemIt, q, v, aPrev, false);
         }
 
         /* Compute the internal and external forces applied on every systems.
@@ -2067,14 +3519,19 @@ namespace jiminy
         vSplitIt = xSplit.second.begin();
         auto qDotSplitIt = dxdtSplit.first.begin();
         auto aSplitIt = dxdtSplit.second.begin();
+        auto xMotorSplitIt = xMotorSplit.begin();
+        auto xMotorDotSplitIt = xMotorDotSplit.begin();
         for ( ; systemIt != systemsDataHolder_.end();
-             systemIt++, qSplitIt++, vSplitIt++, qDotSplitIt++, aSplitIt++)
+             systemIt++, qSplitIt++, vSplitIt++, qDotSplitIt++, aSplitIt++,
+             xMotorSplitIt++, xMotorDotSplitIt++)
         {
             // Define some proxies
             Eigen::Ref<vectorN_t const> const & q = *qSplitIt;
             Eigen::Ref<vectorN_t const> const & v = *vSplitIt;
             Eigen::Ref<vectorN_t> & qDot = *qDotSplitIt;
             Eigen::Ref<vectorN_t> & a = *aSplitIt;
+            Eigen::Ref<vectorN_t const> const & xMotor = *xMotorSplitIt;
+            Eigen::Ref<vectorN_t> & xMotorDot = *xMotorDotSplitIt;
             vectorN_t & u = systemIt->state.u;
             vectorN_t & uCommand = systemIt->state.uCommand;
             vectorN_t & uMotor = systemIt->state.uMotor;
@@ -2086,22 +3543,43 @@ namespace jiminy
             /* Update the sensor data if necessary (only for infinite update frequency).
                Note that it is impossible to have access to the current accelerations
                and efforts since they depend on the sensor values themselves. */
-            if (engineOptions_->stepper.sensorsUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+            for (uint32_t sensorTypeIdx = 0; sensorTypeIdx < systemIt->sensorsTypes.size(); sensorTypeIdx++)
+            {
+                if (systemIt->sensorsUpdatePeriod[sensorTypeIdx] < SIMULATION_MIN_TIMESTEP)
+                {
+                    if (engineOptions_->stepper.sensorsLazyEvaluation)
+                    {
+                        systemIt->robot->setSensorsDataLazy(
+                            systemIt->sensorsTypes[sensorTypeIdx], t, q, v, aPrev, uMotorPrev);
+                    }
+                    else
+                    {
+                        systemIt->robot->setSensorsData(
+                            systemIt->sensorsTypes[sensorTypeIdx], t, q, v, aPrev, uMotorPrev);
+                    }
+                }
+            }
+
+            // The motion of the kinematic systems is prescribed, so there is nothing else to compute
+            if (systemIt->isKinematic)
             {
-                systemIt->robot->setSensorsData(t, q, v, aPrev, uMotorPrev);
+                continue;
             }
 
             /* Update the controller command if necessary (only for infinite update frequency).
                Make sure that the sensor state has been updated beforehand. */
-            if (engineOptions_->stepper.controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
+            if (systemIt->controllerUpdatePeriod < SIMULATION_MIN_TIMESTEP)
             {
                 computeCommand(*systemIt, t, q, v, uCommand);
             }
 
-            /* Compute the actual motor effort.
+            /* Compute the actual motor effort, along with the derivative of the internal
+               state of the motors, which is integrated alongside the state of the system.
                Note that it is impossible to have access to the current accelerations. */
+            systemIt->robot->setMotorsState(xMotor);
             systemIt->robot->computeMotorsEfforts(t, q, v, aPrev, uCommand);
             uMotor = systemIt->robot->getMotorsEfforts();
+            xMotorDot = systemIt->robot->getMotorsStateDerivative();
 
             /* Compute the internal dynamics.
                Make sure that the sensor state has been updated beforehand since
@@ -2129,6 +3607,229 @@ namespace jiminy
         }
     }
 
+    void EngineMultiRobot::computeTimeSteppingUpdate(float64_t const & t,
+                                                     float64_t const & dt,
+                                                     vectorN_t       & xCat,
+                                                     vectorN_t       & dxdtCat)
+    {
+        // Split the input state and derivative (by reference)
+        auto xSplit = splitState(xCat);
+        auto dxdtSplit = splitState(dxdtCat);
+        auto xMotorSplit = splitMotorsState(xCat);
+        auto xMotorDotSplit = splitMotorsState(dxdtCat);
+
+        // Predict the configuration at mid-step using the current velocity
+        vectorN_t xMidCat = xCat;
+        auto xMidSplit = splitState(xMidCat);
+        for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
+        {
+            if (systemsDataHolder_[i].isKinematic)
+            {
+                continue;
+            }
+
+            pinocchio::integrate(systemsDataHolder_[i].robot->pncModel_,
+                                 xSplit.first[i],
+                                 xSplit.second[i] * (dt / 2),
+                                 xMidSplit.first[i]);
+        }
+
+        /* Compute the smooth dynamics at mid-step, namely every force but the contact ones.
+           It also updates the kinematics at mid-step, which is used to detect the contacts. */
+        computeSystemDynamics(t + dt / 2, xMidCat, dxdtCat);
+
+        auto systemIt = systemsDataHolder_.begin();
+        auto qSplitIt = xSplit.first.begin();
+        auto vSplitIt = xSplit.second.begin();
+        auto qMidSplitIt = xMidSplit.first.begin();
+        auto qDotSplitIt = dxdtSplit.first.begin();
+        auto aSplitIt = dxdtSplit.second.begin();
+        for ( ; systemIt != systemsDataHolder_.end();
+             systemIt++, qSplitIt++, vSplitIt++, qMidSplitIt++, qDotSplitIt++, aSplitIt++)
+        {
+            // Define some proxies
+            pinocchio::Model const & pncModel = systemIt->robot->pncModel_;
+            Eigen::Ref<vectorN_t> & q = *qSplitIt;
+            Eigen::Ref<vectorN_t> & v = *vSplitIt;
+            Eigen::Ref<vectorN_t> const & qMid = *qMidSplitIt;
+            Eigen::Ref<vectorN_t> & qDot = *qDotSplitIt;
+            Eigen::Ref<vectorN_t> & a = *aSplitIt;
+
+            // The kinematic systems are not part of the stepper state
+            if (systemIt->isKinematic)
+            {
+                continue;
+            }
+
+            // Compute the velocity at the end of the step, without then with contact impulses
+            vectorN_t vNext = v + dt * a;
+            computeContactImpulses(*systemIt, qMid, dt, vNext);
+
+            // Update the configuration using the velocity at the end of the step
+            vectorN_t const qPrev = q;
+            pinocchio::integrate(pncModel, qMid, vNext * (dt / 2), q);
+
+            // Store the mean derivative over the step, so that it can be logged
+            qDot = (q - qPrev) / dt;
+            a = (vNext - v) / dt;
+            v = vNext;
+        }
+
+        // Update the internal state of the motors using their derivative at mid-step
+        for (uint32_t i = 0; i < systemsDataHolder_.size(); i++)
+        {
+            xMotorSplit[i] += dt * xMotorDotSplit[i];
+        }
+    }
+
+    void EngineMultiRobot::computeContactImpulses(systemDataHolder_t                & system,
+                                                  Eigen::Ref<vectorN_t const> const & q,
+                                                  float64_t                   const & dt,
+                                                  vectorN_t                         & v)
+    {
+        /* Compute the contact impulses enforcing non-penetration and Coulomb friction at
+           velocity-level, by solving the resulting NCP using projected Gauss-Seidel.
+           The Coulomb friction coefficient is 'frictionDry'. The bilateral kinematic
+           constraints are appended as unbounded rows, so that they are not violated by
+           the impulses. It assumes that the kinematics has already been updated. */
+
+        contactOptions_t const & contactOptions = engineOptions_->contacts;
+        pinocchio::Model const & pncModel = system.robot->pncModel_;
+        pinocchio::Data & pncData = system.robot->pncData_;
+
+        // Reset the contact forces
+        for (pinocchio::Force & fextInFrame : system.robot->contactForces_)
+        {
+            fextInFrame.setZero();
+        }
+
+        // Gather the contact points penetrating the ground, along with their local contact basis
+        std::vector<int32_t> const & contactFramesIdx = system.robot->getContactFramesIdx();
+        std::vector<uint32_t> contactsActiveIdx;
+        std::vector<matrix3_t> contactsBasis;
+        for (uint32_t i=0; i < contactFramesIdx.size(); i++)
+        {
+            vector3_t const & posFrame = pncData.oMf[contactFramesIdx[i]].translation();
+            auto ground = engineOptions_->world.groundProfile(posFrame);
+            float64_t const & zGround = std::get<float64_t>(ground);
+            vector3_t & nGround = std::get<vector3_t>(ground);
+            nGround.normalize();
+            float64_t const depth = (posFrame(2) - zGround) * nGround(2); // First-order projection (exact assuming flat surface)
+            if (depth < 0.0)
+            {
+                matrix3_t basis;
+                basis.col(0) = nGround;
+                basis.col(1) = nGround.unitOrthogonal();
+                basis.col(2) = nGround.cross(basis.col(1));
+                contactsActiveIdx.push_back(i);
+                contactsBasis.push_back(basis);
+            }
+        }
+
+        // Nothing to do if no contact is active. The constraints are already enforced by the dynamics.
+        if (contactsActiveIdx.empty())
+        {
+            return;
+        }
+
+        // Stack the contact jacobians in their local basis, followed by the kinematic constraints
+        uint32_t const nContacts = contactsActiveIdx.size();
+        uint32_t const nConstraints = system.robot->hasConstraint() ?
+            system.robot->getConstraintsJacobian().rows() : 0U;
+        uint32_t const nRows = 3U * nContacts + nConstraints;
+        matrixN_t J = matrixN_t::Zero(nRows, pncModel.nv);
+        matrixN_t frameJacobian = matrixN_t::Zero(6, pncModel.nv);
+        system.robot->computeJointJacobians(q);
+        for (uint32_t k=0; k < nContacts; k++)
+        {
+            int32_t const & frameIdx = contactFramesIdx[contactsActiveIdx[k]];
+            frameJacobian.setZero();
+            getFrameJacobian(pncModel, pncData, frameIdx, pinocchio::LOCAL, frameJacobian);
+            J.middleRows(3U * k, 3U) = contactsBasis[k].transpose() *
+                pncData.oMf[frameIdx].rotation() * frameJacobian.topRows<3>();
+        }
+        if (nConstraints > 0U)
+        {
+            J.bottomRows(nConstraints) = system.robot->getConstraintsJacobian();
+        }
+
+        // Compute the inverse of the mass matrix times the transposed jacobian, adding rotor inertia
+        pinocchio_overload::crba(pncModel, pncData, q);
+        system.robot->invalidateKinematics(true);
+        pinocchio::cholesky::decompose(pncModel, pncData);
+        matrixN_t MinvJt = J.transpose();
+        pinocchio::cholesky::solve(pncModel, pncData, MinvJt);
+
+        // Compute the Delassus matrix, slightly damped to handle redundant contacts
+        matrixN_t W = J * MinvJt;
+        W.diagonal().array() += CONSTRAINT_INVERSION_DAMPING;
+
+        // Precompute the inverse of the tangential blocks
+        std::vector<Eigen::Matrix<float64_t, 2, 2> > WTangentialInv(nContacts);
+        for (uint32_t k=0; k < nContacts; k++)
+        {
+            WTangentialInv[k] = W.block<2, 2>(3U * k + 1U, 3U * k + 1U).inverse();
+        }
+
+        // Solve the NCP using projected Gauss-Seidel
+        vectorN_t const vRelFree = J * v;
+        vectorN_t impulse = vectorN_t::Zero(nRows);
+        for (uint32_t iter = 0; iter < contactOptions.pgsIterMax; iter++)
+        {
+            float64_t impulseDeltaMax = 0.0;
+
+            for (uint32_t k=0; k < nContacts; k++)
+            {
+                uint32_t const rowIdx = 3U * k;
+                vector3_t vRel = vRelFree.segment<3>(rowIdx) + W.middleRows(rowIdx, 3U) * impulse;
+                vector3_t const impulsePrev = impulse.segment<3>(rowIdx);
+
+                // Normal impulse: non-penetration at the end of the step
+                float64_t const impulseNormal = std::max(
+                    impulsePrev[0] - vRel[0] / W(rowIdx, rowIdx), 0.0);
+                vRel.tail<2>() += W.block<2, 1>(rowIdx + 1U, rowIdx) * (impulseNormal - impulsePrev[0]);
+
+                // Tangential impulse: sticking, projected onto the Coulomb friction disk
+                Eigen::Matrix<float64_t, 2, 1> impulseTangential =
+                    impulsePrev.tail<2>() - WTangentialInv[k] * vRel.tail<2>();
+                float64_t const impulseTangentialMax = contactOptions.frictionDry * impulseNormal;
+                float64_t const impulseTangentialNorm = impulseTangential.norm();
+                if (impulseTangentialNorm > impulseTangentialMax)
+                {
+                    impulseTangential *= impulseTangentialMax / impulseTangentialNorm;
+                }
+
+                impulse[rowIdx] = impulseNormal;
+                impulse.segment<2>(rowIdx + 1U) = impulseTangential;
+                impulseDeltaMax = std::max(impulseDeltaMax,
+                    (impulse.segment<3>(rowIdx) - impulsePrev).cwiseAbs().maxCoeff());
+            }
+
+            for (uint32_t rowIdx = 3U * nContacts; rowIdx < nRows; rowIdx++)
+            {
+                float64_t const impulseDelta =
+                    - (vRelFree[rowIdx] + W.row(rowIdx).dot(impulse)) / W(rowIdx, rowIdx);
+                impulse[rowIdx] += impulseDelta;
+                impulseDeltaMax = std::max(impulseDeltaMax, std::abs(impulseDelta));
+            }
+
+            if (impulseDeltaMax < contactOptions.pgsTolAbs)
+            {
+                break;
+            }
+        }
+
+        // Apply the impulses
+        v += MinvJt * impulse;
+
+        // Store the contact forces, as the mean force over the step in world frame
+        for (uint32_t k=0; k < nContacts; k++)
+        {
+            pinocchio::Force & fextInFrame = system.robot->contactForces_[contactsActiveIdx[k]];
+            fextInFrame.linear() = contactsBasis[k] * impulse.segment<3>(3U * k) / dt;
+        }
+    }
+
     // ===================================================================
     // ================ Log reading and writing utilities ================
     // ===================================================================
@@ -2249,15 +3950,27 @@ namespace jiminy
                 headerBuffer.push_back(subHeaderBuffer);
             }
 
-            // Get the names of the logged variables
-            while (std::getline(myFile, subHeaderBuffer, '\0').good() &&
-                   subHeaderBuffer != (START_DATA + START_LINE_TOKEN))
+            /* Get the names of the logged variables, until the marker of the data section.
+               It is directly followed by the first line of data, which may be the one of a
+               rate group, and whose content is arbitrary since the oldest lines may have
+               been dropped in flight recorder mode. So only the marker itself is matched. */
+            headerSize = -1;
+            while (true)
             {
-                // Do nothing
+                int64_t const posField = myFile.tellg();
+                if (!std::getline(myFile, subHeaderBuffer, '\0'))
+                {
+                    break;
+                }
+                if (subHeaderBuffer.compare(0, START_DATA.size(), START_DATA) == 0)
+                {
+                    headerSize = posField + START_DATA.size();
+                    break;
+                }
             }
 
             // Make sure the log file is not corrupted
-            if (!myFile.good())
+            if (headerSize < 0 || headerBuffer.size() < 2)
             {
                 std::cout << "Error - EngineMultiRobot::parseLogBinary - Corrupted log file." << std::endl;
                 return hresult_t::ERROR_BAD_INPUT;
@@ -2274,7 +3987,6 @@ namespace jiminy
             // Deduce the parameters required to parse the whole binary log file
             integerSectionSize = (NumIntEntries - 1) * sizeof(int32_t); // Remove Global.Time
             floatSectionSize = NumFloatEntries * sizeof(float32_t);
-            headerSize = ((int32_t) myFile.tellg()) - START_LINE_TOKEN.size() - 1;
 
             // Close the file
             myFile.close();
@@ -2327,59 +4039,56 @@ namespace jiminy
     {
         if (system.robot->hasConstraint())
         {
+            /* Solve the constrained dynamics using the Schur complement of the KKT system:
+                 M a = u - nle + J_ext^T fext + J^T lambda,   J a = - drift
+               The sparse Cholesky factorization of the mass matrix exploiting the kinematic
+               tree structure is computed once, and reused both for the unconstrained
+               acceleration and the Schur complement J M^{-1} J^T. */
+
+            pinocchio::Model const & pncModel = system.robot->pncModel_;
+            pinocchio::Data & pncData = system.robot->pncData_;
+
             // Compute kinematic constraints.
             system.robot->computeConstraints(q, v);
+            matrixN_t const & constraintsJacobian = system.robot->getConstraintsJacobian();
+            vectorN_t const & constraintsDrift = system.robot->getConstraintsDrift();
 
-            // Project external forces from cartesian space to joint space.
-            vectorN_t uTotal = u;
-            matrixN_t jointJacobian = matrixN_t::Zero(6, system.robot->pncModel_.nv);
-            for (int i = 1; i < system.robot->pncModel_.njoints; i++)
-            {
-                jointJacobian.setZero();
-                pinocchio::getJointJacobian(system.robot->pncModel_,
-                                            system.robot->pncData_,
-                                            i,
-                                            pinocchio::LOCAL,
-                                            jointJacobian);
-                uTotal += jointJacobian.transpose() * fext[i].toVector();
-            }
-            // Compute non-linear effects.
-            pinocchio::nonLinearEffects(system.robot->pncModel_,
-                                        system.robot->pncData_,
-                                        q,
-                                        v);
-
-            // Compute inertia matrix, adding rotor inertia.
-            pinocchio::crba(system.robot->pncModel_,
-                            system.robot->pncData_,
-                            q);
-            for (int i = 1; i < system.robot->pncModel_.njoints; i++)
-            {
-                // Only support inertia for 1DoF joints.
-                if (system.robot->pncModel_.joints[i].nv() == 1)
-                {
-                    int jointIdx = system.robot->pncModel_.joints[i].idx_v();
-                    system.robot->pncData_.M(jointIdx, jointIdx) +=
-                            system.robot->pncModel_.rotorInertia[jointIdx];
-                }
-            }
+            /* Compute the non-linear effects, taking into account the external forces,
+               by running rnea with zero acceleration. It avoids having to project the
+               external forces using the jacobian of every joint. */
+            vectorN_t a = u - pinocchio::rnea(pncModel, pncData, q, v,
+                                              vectorN_t::Zero(pncModel.nv), fext);
+
+            // Compute inertia matrix, adding rotor inertia, and its sparse factorization.
+            pinocchio_overload::crba(pncModel, pncData, q);
+            pinocchio::cholesky::decompose(pncModel, pncData);
+
+            // Compute the unconstrained acceleration.
+            pinocchio::cholesky::solve(pncModel, pncData, a);
+
+            // Compute the Schur complement, slightly damped to handle redundant constraints.
+            matrixN_t MinvJt = constraintsJacobian.transpose();
+            pinocchio::cholesky::solve(pncModel, pncData, MinvJt);
+            matrixN_t schurComplement = constraintsJacobian * MinvJt;
+            schurComplement.diagonal().array() += CONSTRAINT_INVERSION_DAMPING;
+
+            // Compute the constraint forces, then the constrained acceleration.
+            vectorN_t const lambda = schurComplement.ldlt().solve(
+                - constraintsDrift - constraintsJacobian * a);
+            a.noalias() += MinvJt * lambda;
+
+            // The acceleration of the joints is no longer consistent with the cached kinematics
+            system.robot->invalidateKinematics(true);
 
-            // Call forward dynamics.
-            return pinocchio::forwardDynamics(system.robot->pncModel_,
-                                              system.robot->pncData_,
-                                              q,
-                                              v,
-                                              uTotal,
-                                              system.robot->getConstraintsJacobian(),
-                                              system.robot->getConstraintsDrift(),
-                                              CONSTRAINT_INVERSION_DAMPING,
-                                              false);
+            return a;
         }
         else
         {
             // No kinematic constraint: run aba algorithm.
-            return pinocchio_overload::aba(
+            vectorN_t a = pinocchio_overload::aba(
                 system.robot->pncModel_, system.robot->pncData_, q, v, u, fext);
+            system.robot->invalidateKinematics(true);
+            return a;
         }
     }
 }
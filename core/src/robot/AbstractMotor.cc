@@ -1,3 +1,6 @@
+#include <typeinfo>
+#include <algorithm>
+
 #include "jiminy/core/robot/Robot.h"
 #include "jiminy/core/Utilities.h"
 
@@ -14,6 +17,7 @@ namespace jiminy
     robot_(nullptr),
     name_(name),
     motorIdx_(-1),
+    stateIdx_(0),
     jointName_(),
     jointModelIdx_(-1),
     jointType_(joint_t::NONE),
@@ -59,6 +63,9 @@ namespace jiminy
         sharedHolder_->motors_.push_back(this);
         ++sharedHolder_->num_;
 
+        // The groups of motors must be regenerated
+        sharedHolder_->groups_.clear();
+
         // Update the flag
         isAttached_ = true;
 
@@ -93,6 +100,7 @@ namespace jiminy
         // Remove the motor to the shared memory
         sharedHolder_->motors_.erase(sharedHolder_->motors_.begin() + motorIdx_);
         --sharedHolder_->num_;
+        sharedHolder_->groups_.clear();
 
         // Clear the references to the robot and shared data
         robot_ = nullptr;
@@ -115,6 +123,45 @@ namespace jiminy
             // Refresh proxies that are robot-dependent
             motor->refreshProxies();
         }
+
+        // Lay out contiguously the internal state of every motor, then reset it
+        int32_t stateIdx = 0;
+        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        {
+            motor->stateIdx_ = stateIdx;
+            stateIdx += motor->getStateSize();
+        }
+        sharedHolder_->state_.setZero(stateIdx);
+        sharedHolder_->stateDerivative_.setZero(stateIdx);
+
+        // Group the motors by type, then refresh the data shared by each group
+        sharedHolder_->groups_.clear();
+        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        {
+            auto groupIt = std::find_if(sharedHolder_->groups_.begin(),
+                                        sharedHolder_->groups_.end(),
+                                        [motor](auto const & group)
+                                        {
+                                            return typeid(*group.front()) == typeid(*motor);
+                                        });
+            if (groupIt != sharedHolder_->groups_.end())
+            {
+                groupIt->push_back(motor);
+            }
+            else
+            {
+                sharedHolder_->groups_.emplace_back(1U, motor);
+            }
+        }
+        for (auto const & group : sharedHolder_->groups_)
+        {
+            if (group.front()->refreshGroup(group) != hresult_t::SUCCESS)
+            {
+                // Fallback to individual evaluation
+                sharedHolder_->groups_.clear();
+                break;
+            }
+        }
     }
 
     hresult_t AbstractMotorBase::setOptions(configHolder_t const & motorOptions)
@@ -223,6 +270,59 @@ namespace jiminy
         return sharedHolder_->data_[motorIdx_];
     }
 
+    vectorN_t & AbstractMotorBase::dataAll(void)
+    {
+        return sharedHolder_->data_;
+    }
+
+    Eigen::Ref<vectorN_t> AbstractMotorBase::state(void)
+    {
+        return sharedHolder_->state_.segment(stateIdx_, getStateSize());
+    }
+
+    Eigen::Ref<vectorN_t> AbstractMotorBase::stateDerivative(void)
+    {
+        return sharedHolder_->stateDerivative_.segment(stateIdx_, getStateSize());
+    }
+
+    uint32_t AbstractMotorBase::getStateSize(void) const
+    {
+        return 0U;
+    }
+
+    int32_t const & AbstractMotorBase::getStateIdx(void) const
+    {
+        return stateIdx_;
+    }
+
+    Eigen::Ref<vectorN_t const> AbstractMotorBase::getState(void) const
+    {
+        return sharedHolder_->state_.segment(stateIdx_, getStateSize());
+    }
+
+    vectorN_t const & AbstractMotorBase::getStateAll(void) const
+    {
+        return sharedHolder_->state_;
+    }
+
+    vectorN_t const & AbstractMotorBase::getStateDerivativeAll(void) const
+    {
+        return sharedHolder_->stateDerivative_;
+    }
+
+    hresult_t AbstractMotorBase::setStateAll(Eigen::Ref<vectorN_t const> const & x)
+    {
+        if (x.size() != sharedHolder_->state_.size())
+        {
+            std::cout << "Error - AbstractMotorBase::setStateAll - The size of the state is inconsistent with the internal state of the motors." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        sharedHolder_->state_ = x;
+
+        return hresult_t::SUCCESS;
+    }
+
     float64_t const & AbstractMotorBase::get(void) const
     {
         return sharedHolder_->data_[motorIdx_];
@@ -298,16 +398,22 @@ namespace jiminy
         return rotorInertia_;
     }
 
-    hresult_t AbstractMotorBase::computeEffortAll(float64_t                   const & t,
-                                                  Eigen::Ref<vectorN_t const> const & q,
-                                                  Eigen::Ref<vectorN_t const> const & v,
-                                                  Eigen::Ref<vectorN_t const> const & a,
-                                                  vectorN_t                   const & uCommand)
+    hresult_t AbstractMotorBase::refreshGroup(std::vector<AbstractMotorBase *> const & motors)
+    {
+        // Nothing to do by default
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t AbstractMotorBase::computeEffortGroup(std::vector<AbstractMotorBase *> const & motors,
+                                                    float64_t                   const & t,
+                                                    Eigen::Ref<vectorN_t const> const & q,
+                                                    Eigen::Ref<vectorN_t const> const & v,
+                                                    Eigen::Ref<vectorN_t const> const & a,
+                                                    vectorN_t                   const & uCommand)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
-        // Compute the motors' output
-        for (AbstractMotorBase * motor : sharedHolder_->motors_)
+        for (AbstractMotorBase * motor : motors)
         {
             if (returnCode == hresult_t::SUCCESS)
             {
@@ -322,4 +428,32 @@ namespace jiminy
 
         return returnCode;
     }
+
+    hresult_t AbstractMotorBase::computeEffortAll(float64_t                   const & t,
+                                                  Eigen::Ref<vectorN_t const> const & q,
+                                                  Eigen::Ref<vectorN_t const> const & v,
+                                                  Eigen::Ref<vectorN_t const> const & a,
+                                                  vectorN_t                   const & uCommand)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        // Compute the motors' output, one group of motors of the same type at a time
+        if (!sharedHolder_->groups_.empty())
+        {
+            for (auto const & group : sharedHolder_->groups_)
+            {
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    returnCode = group.front()->computeEffortGroup(group, t, q, v, a, uCommand);
+                }
+            }
+        }
+        else
+        {
+            // The motors have not been grouped yet, so evaluate them individually
+            returnCode = AbstractMotorBase::computeEffortGroup(sharedHolder_->motors_, t, q, v, a, uCommand);
+        }
+
+        return returnCode;
+    }
 }
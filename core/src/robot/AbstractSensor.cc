@@ -13,6 +13,7 @@ namespace jiminy
     isTelemetryConfigured_(false),
     robot_(nullptr),
     name_(name),
+    generator_(),
     telemetrySender_()
     {
         // Initialize the options
@@ -72,7 +73,7 @@ namespace jiminy
         // Add white noise
         if (baseSensorOptions_->noiseStd.size())
         {
-            get() += randVectorNormal(baseSensorOptions_->noiseStd);
+            get() += generator_.normal(baseSensorOptions_->noiseStd);
         }
 
         // Add bias
@@ -12,7 +12,17 @@ namespace jiminy
 {
     SimpleMotor::SimpleMotor(std::string const & name) :
     AbstractMotorBase(name),
-    motorOptions_(nullptr)
+    motorOptions_(nullptr),
+    groupMotorsIdx_(),
+    groupVelocityIdx_(),
+    groupEffortLimit_(),
+    groupFrictionViscousPositive_(),
+    groupFrictionViscousNegative_(),
+    groupFrictionDryPositive_(),
+    groupFrictionDryNegative_(),
+    groupFrictionDrySlope_(),
+    groupCommand_(),
+    groupVelocity_()
     {
         /* AbstractMotorBase constructor calls the base implementations of
            the virtual methods since the derived class is not available at
@@ -129,4 +139,202 @@ namespace jiminy
 
         return hresult_t::SUCCESS;
     }
+
+    hresult_t SimpleMotor::refreshGroup(std::vector<AbstractMotorBase *> const & motors)
+    {
+        uint32_t const nMotors = motors.size();
+        groupMotorsIdx_.resize(nMotors);
+        groupVelocityIdx_.resize(nMotors);
+        groupEffortLimit_.resize(nMotors);
+        groupFrictionViscousPositive_.resize(nMotors);
+        groupFrictionViscousNegative_.resize(nMotors);
+        groupFrictionDryPositive_.resize(nMotors);
+        groupFrictionDryNegative_.resize(nMotors);
+        groupFrictionDrySlope_.resize(nMotors);
+        groupCommand_.resize(nMotors);
+        groupVelocity_.resize(nMotors);
+
+        for (uint32_t i = 0; i < nMotors; i++)
+        {
+            SimpleMotor const * motor = static_cast<SimpleMotor const *>(motors[i]);
+            if (!motor->isInitialized_)
+            {
+                std::cout << "Error - SimpleMotor::refreshGroup - Motor not initialized." << std::endl;
+                return hresult_t::ERROR_INIT_FAILED;
+            }
+
+            motorOptions_t const & options = *motor->motorOptions_;
+            groupMotorsIdx_[i] = motor->getIdx();
+            groupVelocityIdx_[i] = motor->getJointVelocityIdx();
+            groupEffortLimit_[i] = options.enableEffortLimit ? motor->getEffortLimit() : INF;
+            if (options.enableFriction)
+            {
+                groupFrictionViscousPositive_[i] = options.frictionViscousPositive;
+                groupFrictionViscousNegative_[i] = options.frictionViscousNegative;
+                groupFrictionDryPositive_[i] = options.frictionDryPositive;
+                groupFrictionDryNegative_[i] = options.frictionDryNegative;
+                groupFrictionDrySlope_[i] = options.frictionDrySlope;
+            }
+            else
+            {
+                groupFrictionViscousPositive_[i] = 0.0;
+                groupFrictionViscousNegative_[i] = 0.0;
+                groupFrictionDryPositive_[i] = 0.0;
+                groupFrictionDryNegative_[i] = 0.0;
+                groupFrictionDrySlope_[i] = 0.0;
+            }
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t SimpleMotor::computeEffortGroup(std::vector<AbstractMotorBase *> const & motors,
+                                              float64_t                   const & t,
+                                              Eigen::Ref<vectorN_t const> const & q,
+                                              Eigen::Ref<vectorN_t const> const & v,
+                                              Eigen::Ref<vectorN_t const> const & a,
+                                              vectorN_t                   const & uCommand)
+    {
+        // Fallback to individual evaluation if the layout of the group is outdated
+        if (groupMotorsIdx_.size() != motors.size())
+        {
+            return AbstractMotorBase::computeEffortGroup(motors, t, q, v, a, uCommand);
+        }
+
+        // Gather the command and velocity of every motor
+        uint32_t const nMotors = groupMotorsIdx_.size();
+        for (uint32_t i = 0; i < nMotors; i++)
+        {
+            groupCommand_[i] = uCommand[groupMotorsIdx_[i]];
+            groupVelocity_[i] = v[groupVelocityIdx_[i]];
+        }
+
+        // Enforce the effort limits, then add friction
+        auto const vMotor = groupVelocity_.array();
+        auto const isVelocityPositive = vMotor > 0.0;
+        groupCommand_.array() = groupCommand_.array().max(-groupEffortLimit_.array()).min(groupEffortLimit_.array())
+            + isVelocityPositive.select(groupFrictionViscousPositive_.array(), groupFrictionViscousNegative_.array()) * vMotor
+            + isVelocityPositive.select(groupFrictionDryPositive_.array(), groupFrictionDryNegative_.array())
+                * (groupFrictionDrySlope_.array() * vMotor).tanh();
+
+        // Scatter the actual efforts
+        vectorN_t & uMotor = dataAll();
+        for (uint32_t i = 0; i < nMotors; i++)
+        {
+            uMotor[groupMotorsIdx_[i]] = groupCommand_[i];
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    DcMotor::DcMotor(std::string const & name) :
+    AbstractMotorBase(name),
+    motorOptions_(nullptr)
+    {
+        /* AbstractMotorBase constructor calls the base implementations of
+           the virtual methods since the derived class is not available at
+           this point. Thus it must be called explicitly in the constructor. */
+        setOptions(getDefaultMotorOptions());
+    }
+
+    hresult_t DcMotor::initialize(std::string const & jointName)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!isAttached_)
+        {
+            std::cout << "Error - DcMotor::initialize - Motor not attached to any robot. Impossible to initialize it." << std::endl;
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            jointName_ = jointName;
+            isInitialized_ = true;
+            returnCode = refreshProxies();
+        }
+
+        if (returnCode != hresult_t::SUCCESS)
+        {
+            isInitialized_ = false;
+        }
+
+        return returnCode;
+    }
+
+    hresult_t DcMotor::setOptions(configHolder_t const & motorOptions)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        returnCode = AbstractMotorBase::setOptions(motorOptions);
+
+        // Check if the electrical and thermal parameters make sense
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            for (std::string const & field : {"armatureResistance", "armatureInductance",
+                                              "thermalResistance", "thermalCapacitance"})
+            {
+                if (boost::get<float64_t>(motorOptions.at(field)) < EPS)
+                {
+                    std::cout << "Error - DcMotor::setOptions - '" << field << "' must be strictly positive." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                }
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            motorOptions_ = std::make_unique<motorOptions_t const>(motorOptions);
+        }
+
+        return returnCode;
+    }
+
+    uint32_t DcMotor::getStateSize(void) const
+    {
+        // Current in the windings and their temperature rise above ambient temperature
+        return 2U;
+    }
+
+    hresult_t DcMotor::computeEffort(float64_t const & t,
+                                     float64_t const & q,
+                                     float64_t const & v,
+                                     float64_t const & a,
+                                     float64_t const & uCommand)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - DcMotor::computeEffort - Motor not initialized. Impossible to compute actual motor effort." << std::endl;
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // Define some proxies
+        Eigen::Ref<vectorN_t> x = state();
+        Eigen::Ref<vectorN_t> xDot = stateDerivative();
+        float64_t const & current = x[0];
+        float64_t const & temperature = x[1];
+
+        // The resistance of the windings increases with their temperature
+        float64_t const resistance = motorOptions_->armatureResistance
+            * (1.0 + motorOptions_->resistanceTemperatureCoefficient * temperature);
+
+        // Electrical dynamics, the command being the voltage applied to the windings
+        xDot[0] = (uCommand - resistance * current - motorOptions_->backEmfConstant * v)
+            / motorOptions_->armatureInductance;
+
+        // Thermal dynamics, heated by the Joule losses and cooled by the environment
+        xDot[1] = (resistance * current * current - temperature / motorOptions_->thermalResistance)
+            / motorOptions_->thermalCapacitance;
+
+        // The effort is proportional to the current
+        data() = motorOptions_->torqueConstant * current;
+
+        // Enforce the effort limits
+        if (motorOptions_->enableEffortLimit)
+        {
+            data() = clamp(data(), -getEffortLimit(), getEffortLimit());
+        }
+
+        return hresult_t::SUCCESS;
+    }
 }
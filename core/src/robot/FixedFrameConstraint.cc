@@ -18,6 +18,16 @@ namespace jiminy
         // Empty on purpose
     }
 
+    std::string const & FixedFrameConstraint::getFrameName(void) const
+    {
+        return frameName_;
+    }
+
+    int32_t const & FixedFrameConstraint::getFrameIdx(void) const
+    {
+        return frameIdx_;
+    }
+
     matrixN_t const & FixedFrameConstraint::getJacobian(Eigen::Ref<vectorN_t const> const & q)
     {
         jacobian_.setZero();
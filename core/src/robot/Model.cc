@@ -1,12 +1,29 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <exception>
+#include <algorithm>
+#include <mutex>
+#include <map>
+
+#include <urdf_parser/urdf_parser.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
 
 #include "pinocchio/parsers/urdf.hpp"
+#include "pinocchio/serialization/model.hpp"
+#include "pinocchio/serialization/eigen.hpp"
+#include "pinocchio/serialization/se3.hpp"
 #include "pinocchio/algorithm/joint-configuration.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
 #include "pinocchio/algorithm/frames.hpp"
+#include "pinocchio/algorithm/jacobian.hpp"
+#include "pinocchio/algorithm/model.hpp"
 
 #include "jiminy/core/Utilities.h"
 #include "jiminy/core/Constants.h"
@@ -14,21 +31,143 @@
 #include "jiminy/core/robot/Model.h"
 
 
+namespace boost
+{
+namespace serialization
+{
+    template<class Archive>
+    void serialize(Archive                       & ar,
+                   jiminy::collisionGeometry_t   & geometry,
+                   unsigned int            const   /* version */)
+    {
+        uint8_t shape = static_cast<uint8_t>(geometry.shape);
+        ar & shape;
+        geometry.shape = static_cast<jiminy::collisionShape_t>(shape);
+        ar & geometry.bodyName;
+        ar & geometry.size;
+        ar & geometry.placement;
+        ar & geometry.boundingRadius;
+        ar & geometry.probePoints;
+    }
+
+    template<class Archive>
+    void serialize(Archive                       & ar,
+                   jiminy::sharedModelData_t     & sharedData,
+                   unsigned int            const   /* version */)
+    {
+        ar & sharedData.urdfData;
+        ar & sharedData.pncModelFull;
+        ar & sharedData.pncModelRigid;
+        ar & sharedData.pncModelFlexible;
+        ar & sharedData.collisionGeometries;
+        ar & sharedData.rigidJointsNames;
+        ar & sharedData.flexibleJointsNames;
+        ar & sharedData.flexibleJointsModelIdx;
+        ar & sharedData.lockedConfigurationFull;
+    }
+}
+}
+
 namespace jiminy
 {
+    namespace
+    {
+        // Registry of the immutable data of the models currently loaded in the process
+        std::mutex sharedModelsMutex_;
+        std::map<uint64_t, std::weak_ptr<sharedModelData_t const> > sharedModelsRegistry_;
+
+        template<typename T>
+        std::shared_ptr<T> makeSharedAligned(T && value)
+        {
+            return std::allocate_shared<T>(Eigen::aligned_allocator<T>(), std::move(value));
+        }
+    }
+
+    float64_t computeSignedDistance(collisionGeometry_t const & geometry,
+                                    vector3_t           const & pos,
+                                    vector3_t                 & normal)
+    {
+        switch (geometry.shape)
+        {
+        case collisionShape_t::SPHERE:
+        {
+            float64_t const dist = pos.norm();
+            if (dist > EPS)
+            {
+                normal = pos / dist;
+            }
+            else
+            {
+                normal = vector3_t::UnitZ();
+            }
+            return dist - geometry.size[0];
+        }
+        case collisionShape_t::BOX:
+        {
+            vector3_t const posSigns = pos.unaryExpr(
+                [](float64_t const & x) -> float64_t
+                {
+                    return (x < 0.0) ? -1.0 : 1.0;
+                });
+            vector3_t const delta = pos.cwiseAbs() - geometry.size;
+            vector3_t const deltaOut = delta.cwiseMax(0.0);
+            float64_t const distOut = deltaOut.norm();
+            if (distOut > EPS)
+            {
+                // Outside the box, the closest point may be on a face, an edge or a vertex
+                normal = posSigns.cwiseProduct(deltaOut) / distOut;
+                return distOut;
+            }
+            // Inside the box, the closest point is on the nearest face
+            int32_t axis;
+            float64_t const distIn = delta.maxCoeff(&axis);
+            normal = posSigns[axis] * vector3_t::Unit(axis);
+            return distIn;
+        }
+        case collisionShape_t::CYLINDER:
+        default:
+        {
+            // Same as a box in the plane going through the axis and the point
+            float64_t const radial = pos.head<2>().norm();
+            vector3_t const radialDir = (radial > EPS) ?
+                vector3_t(pos[0] / radial, pos[1] / radial, 0.0) : vector3_t::UnitX();
+            float64_t const axialSign = (pos[2] < 0.0) ? -1.0 : 1.0;
+            float64_t const deltaRadial = radial - geometry.size[0];
+            float64_t const deltaAxial = std::abs(pos[2]) - geometry.size[1];
+            float64_t const distOut = std::hypot(std::max(deltaRadial, 0.0), std::max(deltaAxial, 0.0));
+            if (distOut > EPS)
+            {
+                normal = (std::max(deltaRadial, 0.0) * radialDir
+                        + std::max(deltaAxial, 0.0) * axialSign * vector3_t::UnitZ()) / distOut;
+                return distOut;
+            }
+            if (deltaRadial > deltaAxial)
+            {
+                normal = radialDir;
+                return deltaRadial;
+            }
+            normal = axialSign * vector3_t::UnitZ();
+            return deltaAxial;
+        }
+        }
+    }
+
     Model::Model(void) :
     pncModel_(),
     pncData_(pncModel_),
-    pncModelRigidOrig_(),
-    pncDataRigidOrig_(pncModelRigidOrig_),
+    pncModelFull_(makeSharedAligned(pinocchio::Model())),
+    pncModelRigidOrig_(pncModelFull_),
+    pncDataRigidOrig_(*pncModelRigidOrig_),
     mdlOptions_(nullptr),
     contactForces_(),
     isInitialized_(false),
     urdfPath_(),
+    urdfData_(std::make_shared<std::string const>()),
     hasFreeflyer_(false),
     mdlOptionsHolder_(),
     contactFramesNames_(),
     contactFramesIdx_(),
+    collisionGeometries_(),
     rigidJointsNames_(),
     rigidJointsModelIdx_(),
     rigidJointsPositionIdx_(),
@@ -38,10 +177,41 @@ namespace jiminy
     positionLimitMin_(),
     positionLimitMax_(),
     velocityLimit_(),
+    boundedJointsPositionIdx_(),
+    boundedJointsVelocityIdx_(),
+    boundedJointsPositionLimitMin_(),
+    boundedJointsPositionLimitMax_(),
+    boundedJointsVelocityLimit_(),
+    flexibleJointsPositionIdx_(),
+    flexibleJointsVelocityIdx_(),
+    flexibleJointsStiffness_(),
+    flexibleJointsDamping_(),
     positionFieldnames_(),
     velocityFieldnames_(),
     accelerationFieldnames_(),
-    pncModelFlexibleOrig_(),
+    generator_(),
+    pncModelFlexibleOrig_(pncModelFull_),
+    pncModelNominal_(nullptr),
+    biasedJointsModelIdx_(),
+    isModelBiased_(false),
+    modelBias_(),
+    modelsBiasPending_(),
+    lockedConfigurationFull_(),
+    kinematicsQ_(),
+    kinematicsV_(),
+    kinematicsA_(),
+    jacobiansQ_(),
+    isKinematicsValid_(false),
+    isKinematicsAccelerationValid_(false),
+    areKinematicsFramesAllValid_(false),
+    areJointJacobiansValid_(false),
+    kinematicsFramesIdx_(),
+    kinematicsQBackup_(),
+    kinematicsVBackup_(),
+    kinematicsABackup_(),
+    isKinematicsValidBackup_(false),
+    isKinematicsAccelerationValidBackup_(false),
+    areKinematicsFramesAllValidBackup_(false),
     nq_(0),
     nv_(0),
     nx_(0)
@@ -51,34 +221,111 @@ namespace jiminy
 
     hresult_t Model::initialize(std::string const & urdfPath,
                                 bool_t      const & hasFreeflyer)
+    {
+        // Read the URDF file
+        std::ifstream urdfFile(urdfPath, std::ios::binary);
+        if (!urdfFile.good())
+        {
+            std::cout << "Error - Model::initialize - The URDF file does not exist. Impossible to load it." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        std::ostringstream urdfData;
+        urdfData << urdfFile.rdbuf();
+
+        return initializeFromUrdfData(urdfPath, urdfData.str(), hasFreeflyer);
+    }
+
+    hresult_t Model::initializeFromUrdfData(std::string const & urdfPath,
+                                            std::string const & urdfData,
+                                            bool_t      const & hasFreeflyer)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
-        // Initialize the URDF model
-        returnCode = loadUrdfModel(urdfPath, hasFreeflyer);
-        isInitialized_ = true;
+        // The current model is about to be regenerated from scratch
+        pncModelNominal_.reset();
 
-        if (returnCode == hresult_t::SUCCESS)
+        /* Look for the immutable data of the model in the models already loaded in the
+           process, then in the cache if enabled, before actually processing the URDF. */
+        uint64_t const key = getModelCacheKey(urdfData, hasFreeflyer);
+        std::shared_ptr<sharedModelData_t const> sharedData;
+        {
+            std::lock_guard<std::mutex> lock(sharedModelsMutex_);
+            auto sharedDataIt = sharedModelsRegistry_.find(key);
+            if (sharedDataIt != sharedModelsRegistry_.end())
+            {
+                sharedData = sharedDataIt->second.lock();
+            }
+        }
+        if (!sharedData && mdlOptions_->cache.enable)
         {
-            // Backup the original model and data
-            pncModelRigidOrig_ = pncModel_;
-            pncDataRigidOrig_ = pinocchio::Data(pncModelRigidOrig_);
+            loadModelCache(getModelCachePath(key), sharedData);
+        }
 
-            /* Get the list of joint names of the rigid model and
-               remove the 'universe' and 'root' if any, since they
-               are not actual joints. */
-            rigidJointsNames_ = pncModelRigidOrig_.names;
-            rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'universe'
-            if (hasFreeflyer)
+        urdfPath_ = urdfPath;
+        hasFreeflyer_ = hasFreeflyer;
+        isInitialized_ = true;
+        if (!sharedData)
+        {
+            // Initialize the URDF model
+            returnCode = loadUrdfModel(urdfData, hasFreeflyer);
+
+            if (returnCode == hresult_t::SUCCESS)
             {
-                rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'root'
+                // Backup the original model
+                pncModelFull_ = makeSharedAligned(pinocchio::Model(pncModel_));
+
+                // Create the rigid model, without the locked joints
+                returnCode = generateModelReduced();
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                // Create the flexible model
+                returnCode = generateModelFlexible();
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                // Gather the immutable data of the model
+                sharedModelData_t sharedDataNew;
+                sharedDataNew.urdfData = urdfData;
+                sharedDataNew.pncModelFull = *pncModelFull_;
+                sharedDataNew.pncModelRigid = *pncModelRigidOrig_;
+                sharedDataNew.pncModelFlexible = *pncModelFlexibleOrig_;
+                sharedDataNew.collisionGeometries = collisionGeometries_;
+                sharedDataNew.rigidJointsNames = rigidJointsNames_;
+                sharedDataNew.flexibleJointsNames = flexibleJointsNames_;
+                sharedDataNew.flexibleJointsModelIdx = flexibleJointsModelIdx_;
+                sharedDataNew.lockedConfigurationFull = lockedConfigurationFull_;
+                sharedData = makeSharedAligned(std::move(sharedDataNew));
+
+                // Store it in cache. Failing to do so is not critical.
+                if (mdlOptions_->cache.enable)
+                {
+                    saveModelCache(getModelCachePath(key), *sharedData);
+                }
             }
         }
 
         if (returnCode == hresult_t::SUCCESS)
         {
-            // Create the flexible model
-            returnCode = generateModelFlexible();
+            // Share the immutable data with the other models loaded from the same URDF
+            {
+                std::lock_guard<std::mutex> lock(sharedModelsMutex_);
+                for (auto sharedDataIt = sharedModelsRegistry_.begin(); sharedDataIt != sharedModelsRegistry_.end();)
+                {
+                    if (sharedDataIt->second.expired())
+                    {
+                        sharedDataIt = sharedModelsRegistry_.erase(sharedDataIt);
+                    }
+                    else
+                    {
+                        ++sharedDataIt;
+                    }
+                }
+                sharedModelsRegistry_[key] = sharedData;
+            }
+            setSharedModelData(sharedData);
         }
 
         if (returnCode == hresult_t::SUCCESS)
@@ -104,6 +351,207 @@ namespace jiminy
             // Update the biases added to the dynamics properties of the model.
             generateModelBiased();
         }
+
+        // The kinematics data have been reinitialized
+        invalidateKinematics();
+    }
+
+    void Model::seedRandomStreams(uint32_t    const & seed,
+                                  std::string const & streamName,
+                                  bool_t      const & resetStreams)
+    {
+        uint64_t const counter = generator_.getCounter();
+        generator_.seed(seed, streamName + TELEMETRY_DELIMITER + "model");
+        if (resetStreams)
+        {
+            // The biases sampled up front are not consistent with the new streams anymore
+            modelsBiasPending_.clear();
+        }
+        else
+        {
+            generator_.setCounter(counter);
+        }
+    }
+
+    hresult_t Model::sampleModelsBiased(uint32_t const & nModels)
+    {
+        if (!isInitialized_)
+        {
+            std::cout << "Error - Model::sampleModelsBiased - Model not initialized." << std::endl;
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        // The biases are sampled around the nominal model, which is only available once the model has been reset successfully
+        if (!pncModelNominal_)
+        {
+            std::cout << "Error - Model::sampleModelsBiased - Nominal model not available. Please reset the model first." << std::endl;
+            return hresult_t::ERROR_INIT_FAILED;
+        }
+
+        for (uint32_t i = 0; i < nModels; i++)
+        {
+            modelsBiasPending_.emplace_back();
+            sampleModelBias(modelsBiasPending_.back());
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    uint32_t Model::getModelsBiasedPendingCount(void) const
+    {
+        return static_cast<uint32_t>(modelsBiasPending_.size());
+    }
+
+    void Model::computeForwardKinematics(Eigen::Ref<vectorN_t const> const & q,
+                                         Eigen::Ref<vectorN_t const> const & v,
+                                         Eigen::Ref<vectorN_t const> const & a,
+                                         bool_t                      const & updateAllFrames)
+    {
+        bool_t const isPositionValid = isKinematicsValid_ && kinematicsQ_ == q;
+        if (!isPositionValid || kinematicsV_ != v
+        || !isKinematicsAccelerationValid_ || kinematicsA_ != a)
+        {
+            pinocchio::forwardKinematics(pncModel_, pncData_, q, v, a);
+            kinematicsQ_ = q;
+            kinematicsV_ = v;
+            kinematicsA_ = a;
+            isKinematicsValid_ = true;
+            isKinematicsAccelerationValid_ = true;
+            if (!isPositionValid)
+            {
+                // The frame placements only depend on the configuration
+                areKinematicsFramesAllValid_ = false;
+                updateKinematicsFrames(updateAllFrames);
+                return;
+            }
+        }
+        if (updateAllFrames && !areKinematicsFramesAllValid_)
+        {
+            updateKinematicsFrames(true);
+        }
+    }
+
+    void Model::computeForwardKinematics(Eigen::Ref<vectorN_t const> const & q,
+                                         Eigen::Ref<vectorN_t const> const & v,
+                                         bool_t                      const & updateAllFrames)
+    {
+        bool_t const isPositionValid = isKinematicsValid_ && kinematicsQ_ == q;
+        if (!isPositionValid || kinematicsV_ != v)
+        {
+            pinocchio::forwardKinematics(pncModel_, pncData_, q, v);
+            kinematicsQ_ = q;
+            kinematicsV_ = v;
+            isKinematicsValid_ = true;
+            isKinematicsAccelerationValid_ = false;
+            if (!isPositionValid)
+            {
+                areKinematicsFramesAllValid_ = false;
+                updateKinematicsFrames(updateAllFrames);
+                return;
+            }
+        }
+        if (updateAllFrames && !areKinematicsFramesAllValid_)
+        {
+            updateKinematicsFrames(true);
+        }
+    }
+
+    void Model::updateKinematicsFrames(bool_t const & updateAllFrames)
+    {
+        if (updateAllFrames)
+        {
+            pinocchio::updateFramePlacements(pncModel_, pncData_);
+            areKinematicsFramesAllValid_ = true;
+        }
+        else
+        {
+            for (int32_t const & frameIdx : kinematicsFramesIdx_)
+            {
+                pinocchio::updateFramePlacement(pncModel_, pncData_, frameIdx);
+            }
+        }
+    }
+
+    void Model::flushKinematicsFrames(void)
+    {
+        if (isKinematicsValid_ && !areKinematicsFramesAllValid_)
+        {
+            updateKinematicsFrames(true);
+        }
+    }
+
+    void Model::computeJointJacobians(Eigen::Ref<vectorN_t const> const & q)
+    {
+        if (areJointJacobiansValid_ && jacobiansQ_ == q)
+        {
+            return;
+        }
+
+        /* Note that it updates the placement of the joints as well, which invalidates
+           the cached kinematics if computed for a different configuration. */
+        pinocchio::computeJointJacobians(pncModel_, pncData_, q);
+        jacobiansQ_ = q;
+        areJointJacobiansValid_ = true;
+        if (isKinematicsValid_ && kinematicsQ_ != q)
+        {
+            isKinematicsValid_ = false;
+        }
+    }
+
+    void Model::invalidateKinematics(bool_t const & isAccelerationOnly)
+    {
+        isKinematicsAccelerationValid_ = false;
+        areJointJacobiansValid_ = false;
+        if (!isAccelerationOnly)
+        {
+            isKinematicsValid_ = false;
+            areKinematicsFramesAllValid_ = false;
+        }
+    }
+
+    void Model::setKinematicsFramesIdx(std::vector<int32_t> const & framesIdx)
+    {
+        kinematicsFramesIdx_ = framesIdx;
+        std::sort(kinematicsFramesIdx_.begin(), kinematicsFramesIdx_.end());
+        kinematicsFramesIdx_.erase(std::unique(kinematicsFramesIdx_.begin(), kinematicsFramesIdx_.end()),
+                                   kinematicsFramesIdx_.end());
+    }
+
+    void Model::backupKinematics(void)
+    {
+        isKinematicsValidBackup_ = isKinematicsValid_;
+        isKinematicsAccelerationValidBackup_ = isKinematicsAccelerationValid_;
+        areKinematicsFramesAllValidBackup_ = areKinematicsFramesAllValid_;
+        if (isKinematicsValid_)
+        {
+            kinematicsQBackup_ = kinematicsQ_;
+            kinematicsVBackup_ = kinematicsV_;
+        }
+        if (isKinematicsAccelerationValid_)
+        {
+            kinematicsABackup_ = kinematicsA_;
+        }
+    }
+
+    void Model::restoreKinematics(void)
+    {
+        if (!isKinematicsValidBackup_)
+        {
+            // There is nothing to restore, but the kinematics computed in the meantime must not be used
+            isKinematicsValid_ = false;
+            isKinematicsAccelerationValid_ = false;
+            areKinematicsFramesAllValid_ = false;
+        }
+        else if (isKinematicsAccelerationValidBackup_)
+        {
+            computeForwardKinematics(kinematicsQBackup_, kinematicsVBackup_, kinematicsABackup_,
+                                     areKinematicsFramesAllValidBackup_);
+        }
+        else
+        {
+            computeForwardKinematics(kinematicsQBackup_, kinematicsVBackup_,
+                                     areKinematicsFramesAllValidBackup_);
+        }
     }
 
     hresult_t Model::addContactPoints(std::vector<std::string> const & frameNames)
@@ -198,6 +646,211 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    uint64_t Model::getModelCacheKey(std::string const & urdfData,
+                                     bool_t      const & hasFreeflyer) const
+    {
+        // The processed models are only valid for a given content of the URDF
+        std::ostringstream data;
+        data << urdfData;
+
+        // Append the options affecting the processed models
+        data << MODEL_CACHE_VERSION << hasFreeflyer;
+        for (std::string const & jointName : mdlOptions_->joints.lockedJointsNames)
+        {
+            data << jointName << TELEMETRY_DELIMITER;
+        }
+        for (vectorN_t const & position : mdlOptions_->joints.lockedJointsPositions)
+        {
+            data.write(reinterpret_cast<char const *>(position.data()),
+                       static_cast<std::streamsize>(position.size() * sizeof(float64_t)));
+        }
+        for (flexibleJointData_t const & flexibleJoint : mdlOptions_->dynamics.flexibilityConfig)
+        {
+            data << flexibleJoint.jointName << TELEMETRY_DELIMITER;
+        }
+
+        return computeHash(data.str());
+    }
+
+    std::string Model::getModelCachePath(uint64_t const & key) const
+    {
+        std::string directory = mdlOptions_->cache.directory;
+        if (directory.empty())
+        {
+            directory = getUserDirectory() + "/.cache/jiminy";
+        }
+        std::ostringstream cachePath;
+        cachePath << directory << "/model_" << std::hex << key << ".bin";
+        return cachePath.str();
+    }
+
+    hresult_t Model::loadModelCache(std::string                        const & cachePath,
+                                    std::shared_ptr<sharedModelData_t const> & sharedData) const
+    {
+        std::ifstream cacheFile(cachePath, std::ios::binary);
+        if (!cacheFile.good())
+        {
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        try
+        {
+            sharedModelData_t sharedDataNew;
+            boost::archive::binary_iarchive archive(cacheFile);
+            archive >> sharedDataNew;
+            sharedData = makeSharedAligned(std::move(sharedDataNew));
+        }
+        catch (std::exception const & e)
+        {
+            std::cout << "Warning - Model::loadModelCache - Corrupted model cache '" << cachePath << "'. Ignoring it." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    hresult_t Model::saveModelCache(std::string       const & cachePath,
+                                    sharedModelData_t const & sharedData) const
+    {
+        try
+        {
+            boost::filesystem::create_directories(boost::filesystem::path(cachePath).parent_path());
+
+            // Write in a temporary file first, so that concurrent processes never read a partial cache
+            std::string const cachePathTmp =
+                cachePath + "." + boost::filesystem::unique_path().string() + ".tmp";
+            {
+                std::ofstream cacheFile(cachePathTmp, std::ios::binary);
+                boost::archive::binary_oarchive archive(cacheFile);
+                archive << sharedData;
+            }
+            boost::filesystem::rename(cachePathTmp, cachePath);
+        }
+        catch (std::exception const & e)
+        {
+            std::cout << "Warning - Model::saveModelCache - Impossible to write the model cache '" << cachePath << "'." << std::endl;
+            return hresult_t::ERROR_GENERIC;
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
+    void Model::setSharedModelData(std::shared_ptr<sharedModelData_t const> const & sharedData)
+    {
+        // The models are aliasing the shared data, to keep it alive as long as they are used
+        urdfData_ = std::shared_ptr<std::string const>(sharedData, &sharedData->urdfData);
+        pncModelFull_ = std::shared_ptr<pinocchio::Model const>(sharedData, &sharedData->pncModelFull);
+        pncModelRigidOrig_ = std::shared_ptr<pinocchio::Model const>(sharedData, &sharedData->pncModelRigid);
+        pncModelFlexibleOrig_ = std::shared_ptr<pinocchio::Model const>(sharedData, &sharedData->pncModelFlexible);
+        pncDataRigidOrig_ = pinocchio::Data(*pncModelRigidOrig_);
+
+        // The other data are small, so that they are simply copied
+        collisionGeometries_ = sharedData->collisionGeometries;
+        rigidJointsNames_ = sharedData->rigidJointsNames;
+        flexibleJointsNames_ = sharedData->flexibleJointsNames;
+        flexibleJointsModelIdx_ = sharedData->flexibleJointsModelIdx;
+        lockedConfigurationFull_ = sharedData->lockedConfigurationFull;
+    }
+
+    hresult_t Model::generateModelReduced(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!isInitialized_)
+        {
+            std::cout << "Error - Model::generateModelReduced - Model not initialized." << std::endl;
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        std::vector<std::string> const & lockedJointsNames = mdlOptions_->joints.lockedJointsNames;
+        std::vector<vectorN_t> const & lockedJointsPositions = mdlOptions_->joints.lockedJointsPositions;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            if (!lockedJointsPositions.empty()
+            && lockedJointsPositions.size() != lockedJointsNames.size())
+            {
+                std::cout << "Error - Model::generateModelReduced - 'lockedJointsPositions' must be empty or have the same size as 'lockedJointsNames'." << std::endl;
+                returnCode = hresult_t::ERROR_BAD_INPUT;
+            }
+        }
+
+        /* Compute the reference configuration of the full model,
+           by setting the locked joints at their prescribed position. */
+        std::vector<pinocchio::JointIndex> lockedJointsIdx;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            lockedConfigurationFull_ = pinocchio::neutral(*pncModelFull_);
+            for (uint32_t i = 0; i < lockedJointsNames.size(); i++)
+            {
+                std::string const & jointName = lockedJointsNames[i];
+                if (!pncModelFull_->existJointName(jointName))
+                {
+                    std::cout << "Error - Model::generateModelReduced - Locked joint '" << jointName << "' does not exist." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+                pinocchio::JointIndex const jointIdx = pncModelFull_->getJointId(jointName);
+                if (hasFreeflyer_ && jointIdx == 1)
+                {
+                    std::cout << "Error - Model::generateModelReduced - The freeflyer cannot be locked." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+                if (std::find(lockedJointsIdx.begin(), lockedJointsIdx.end(), jointIdx) != lockedJointsIdx.end())
+                {
+                    std::cout << "Error - Model::generateModelReduced - Locked joint '" << jointName << "' specified twice." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+                lockedJointsIdx.push_back(jointIdx);
+
+                if (!lockedJointsPositions.empty())
+                {
+                    auto const & joint = pncModelFull_->joints[jointIdx];
+                    if (lockedJointsPositions[i].size() != joint.nq())
+                    {
+                        std::cout << "Error - Model::generateModelReduced - Wrong vector size for the position of locked joint '" << jointName << "'." << std::endl;
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                        break;
+                    }
+                    lockedConfigurationFull_.segment(joint.idx_q(), joint.nq()) = lockedJointsPositions[i];
+                }
+            }
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            /* Build the rigid model by merging the bodies attached by the locked
+               joints. It is a plain copy of the full model if there is none. */
+            if (lockedJointsIdx.empty())
+            {
+                pncModelRigidOrig_ = pncModelFull_;
+            }
+            else
+            {
+                pinocchio::Model pncModelRigid;
+                pinocchio::buildReducedModel(*pncModelFull_,
+                                             lockedJointsIdx,
+                                             lockedConfigurationFull_,
+                                             pncModelRigid);
+                pncModelRigidOrig_ = makeSharedAligned(std::move(pncModelRigid));
+            }
+            pncDataRigidOrig_ = pinocchio::Data(*pncModelRigidOrig_);
+
+            /* Get the list of joint names of the rigid model and
+               remove the 'universe' and 'root' if any, since they
+               are not actual joints. */
+            rigidJointsNames_ = pncModelRigidOrig_->names;
+            rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'universe'
+            if (hasFreeflyer_)
+            {
+                rigidJointsNames_.erase(rigidJointsNames_.begin()); // remove the 'root'
+            }
+        }
+
+        return returnCode;
+    }
+
     hresult_t Model::generateModelFlexible(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -212,7 +865,7 @@ namespace jiminy
         {
             flexibleJointsNames_.clear();
             flexibleJointsModelIdx_.clear();
-            pncModelFlexibleOrig_ = pncModelRigidOrig_;
+            pinocchio::Model pncModelFlexible = *pncModelRigidOrig_;
             for(flexibleJointData_t const & flexibleJoint : mdlOptions_->dynamics.flexibilityConfig)
             {
                 std::string const & jointName = flexibleJoint.jointName;
@@ -221,7 +874,7 @@ namespace jiminy
                 if (returnCode == hresult_t::SUCCESS)
                 {
                     int32_t jointIdx;
-                    returnCode = getJointPositionIdx(pncModel_, jointName, jointIdx);
+                    returnCode = getJointPositionIdx(*pncModelRigidOrig_, jointName, jointIdx);
                 }
 
                 // Add joints to model
@@ -230,14 +883,16 @@ namespace jiminy
                     std::string newName =
                         removeSuffix(jointName, "Joint") + FLEXIBLE_JOINT_SUFFIX;
                     flexibleJointsNames_.emplace_back(newName);
-                    insertFlexibilityInModel(pncModelFlexibleOrig_, jointName, newName); // Ignore return code, as check has already been done.
+                    insertFlexibilityInModel(pncModelFlexible, jointName, newName); // Ignore return code, as check has already been done.
                 }
             }
+
+            pncModelFlexibleOrig_ = makeSharedAligned(std::move(pncModelFlexible));
         }
 
         if (returnCode == hresult_t::SUCCESS)
         {
-            getJointsModelIdx(pncModelFlexibleOrig_,
+            getJointsModelIdx(*pncModelFlexibleOrig_,
                               flexibleJointsNames_,
                               flexibleJointsModelIdx_);
         }
@@ -255,64 +910,125 @@ namespace jiminy
             returnCode = hresult_t::ERROR_INIT_FAILED;
         }
 
+        bool_t isStructureChanged = false;
         if (returnCode == hresult_t::SUCCESS)
         {
             // Reset the robot either with the original rigid or flexible model
-            if (mdlOptions_->dynamics.enableFlexibleModel)
+            std::shared_ptr<pinocchio::Model const> const & pncModelNominal =
+                mdlOptions_->dynamics.enableFlexibleModel ? pncModelFlexibleOrig_ : pncModelRigidOrig_;
+
+            /* The model is copied only if its structure has changed. Otherwise, only the biased
+               dynamics properties are updated in place, since it is much cheaper. */
+            isStructureChanged = (pncModelNominal != pncModelNominal_);
+            if (isStructureChanged)
             {
-                pncModel_ = pncModelFlexibleOrig_;
+                pncModel_ = *pncModelNominal;
+                pncModelNominal_ = pncModelNominal;
+                isModelBiased_ = false;
+                modelsBiasPending_.clear();
+                getJointsModelIdx(pncModel_, rigidJointsNames_, biasedJointsModelIdx_);
+                modelBias_.inertias.resize(biasedJointsModelIdx_.size());
+                modelBias_.relativePositions.resize(biasedJointsModelIdx_.size());
             }
-            else
+
+            // Apply the biases sampled up front if any, otherwise sample them on the fly if enabled
+            bool_t isModelBiasedNew = false;
+            if (!modelsBiasPending_.empty())
             {
-                pncModel_ = pncModelRigidOrig_;
+                modelBias_ = std::move(modelsBiasPending_.front());
+                modelsBiasPending_.pop_front();
+                isModelBiasedNew = true;
+            }
+            else if (mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd > 0.0
+                  || mdlOptions_->dynamics.massBodiesBiasStd > 0.0
+                  || mdlOptions_->dynamics.inertiaBodiesBiasStd > 0.0
+                  || mdlOptions_->dynamics.relativePositionBodiesBiasStd > 0.0)
+            {
+                sampleModelBias(modelBias_);
+                isModelBiasedNew = true;
             }
 
-            for (std::string const & jointName : rigidJointsNames_)
+            if (isModelBiasedNew)
             {
-                int32_t const jointIdx = pncModel_.getJointId(jointName);
+                for (uint32_t i = 0; i < biasedJointsModelIdx_.size(); i++)
+                {
+                    int32_t const & jointIdx = biasedJointsModelIdx_[i];
+                    pncModel_.inertias[jointIdx] = modelBias_.inertias[i];
+                    pncModel_.jointPlacements[jointIdx].translation() = modelBias_.relativePositions[i];
+                }
+            }
+            else if (isModelBiased_)
+            {
+                // Restore the nominal dynamics properties
+                for (int32_t const & jointIdx : biasedJointsModelIdx_)
+                {
+                    pncModel_.inertias[jointIdx] = pncModelNominal->inertias[jointIdx];
+                    pncModel_.jointPlacements[jointIdx] = pncModelNominal->jointPlacements[jointIdx];
+                }
+            }
 
-                vector3_t & comRelativePositionBody =
-                    const_cast<vector3_t &>(pncModel_.inertias[jointIdx].lever());
-                comRelativePositionBody +=
-                    randVectorNormal(3U, mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd);
-
-                // Cannot be less than 1g for numerical stability
-                float64_t & massBody =
-                    const_cast<float64_t &>(pncModel_.inertias[jointIdx].mass());
-                massBody =
-                    std::max(massBody +
-                        randNormal(0.0, mdlOptions_->dynamics.massBodiesBiasStd), 1.0e-3);
-
-                // Cannot be less 1g applied at 1mm of distance from the rotation center
-                vector6_t & inertiaBody =
-                    const_cast<vector6_t &>(pncModel_.inertias[jointIdx].inertia().data());
-                inertiaBody =
-                    clamp(inertiaBody +
-                        randVectorNormal(6U, mdlOptions_->dynamics.inertiaBodiesBiasStd), 1.0e-9);
-
-                vector3_t & relativePositionBody =
-                    pncModel_.jointPlacements[jointIdx].translation();
-                relativePositionBody +=
-                    randVectorNormal(3U, mdlOptions_->dynamics.relativePositionBodiesBiasStd);
-            }
-
-            // Initialize Pinocchio Data internal state
-            pncData_ = pinocchio::Data(pncModel_);
-            pinocchio::forwardKinematics(pncModel_, pncData_,
-                                         pinocchio::neutral(pncModel_),
-                                         vectorN_t::Zero(pncModel_.nv));
-            pinocchio::updateFramePlacements(pncModel_, pncData_);
+            // Nothing else to do if the model is left unchanged
+            bool_t const isModelChanged = isStructureChanged || isModelBiasedNew || isModelBiased_;
+            isModelBiased_ = isModelBiasedNew;
+            if (isModelChanged)
+            {
+                // Initialize Pinocchio Data internal state, which is only required if the structure has changed
+                if (isStructureChanged)
+                {
+                    pncData_ = pinocchio::Data(pncModel_);
+                }
+                pinocchio::forwardKinematics(pncModel_, pncData_,
+                                             pinocchio::neutral(pncModel_),
+                                             vectorN_t::Zero(pncModel_.nv));
+                pinocchio::updateFramePlacements(pncModel_, pncData_);
+            }
         }
 
-        if (returnCode == hresult_t::SUCCESS)
+        if (returnCode == hresult_t::SUCCESS && isStructureChanged)
         {
-            // Initialize the internal proxies.
+            // Initialize the internal proxies, which only depend on the structure of the model
             returnCode = refreshProxies();
+            if (returnCode != hresult_t::SUCCESS)
+            {
+                // Force regenerating the model at next reset
+                pncModelNominal_.reset();
+            }
         }
 
         return returnCode;
     }
 
+    void Model::sampleModelBias(modelBias_t & modelBias)
+    {
+        modelBias.inertias.resize(biasedJointsModelIdx_.size());
+        modelBias.relativePositions.resize(biasedJointsModelIdx_.size());
+        for (uint32_t i = 0; i < biasedJointsModelIdx_.size(); i++)
+        {
+            int32_t const & jointIdx = biasedJointsModelIdx_[i];
+            pinocchio::Inertia const & inertiaNominal = pncModelNominal_->inertias[jointIdx];
+
+            vector3_t const comRelativePositionBody = inertiaNominal.lever() +
+                generator_.normal(3U, 0.0, mdlOptions_->dynamics.centerOfMassPositionBodiesBiasStd);
+
+            // Cannot be less than 1g for numerical stability
+            float64_t const massBody =
+                std::max(inertiaNominal.mass() +
+                    generator_.normal(0.0, mdlOptions_->dynamics.massBodiesBiasStd), 1.0e-3);
+
+            // Cannot be less 1g applied at 1mm of distance from the rotation center
+            vector6_t const inertiaBody =
+                clamp(inertiaNominal.inertia().data() +
+                    generator_.normal(6U, 0.0, mdlOptions_->dynamics.inertiaBodiesBiasStd), 1.0e-9);
+
+            modelBias.inertias[i] = pinocchio::Inertia(
+                massBody, comRelativePositionBody, pinocchio::Symmetric3(inertiaBody));
+
+            modelBias.relativePositions[i] =
+                pncModelNominal_->jointPlacements[jointIdx].translation() +
+                generator_.normal(3U, 0.0, mdlOptions_->dynamics.relativePositionBodiesBiasStd);
+        }
+    }
+
     hresult_t Model::refreshProxies(void)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -325,6 +1041,9 @@ namespace jiminy
 
         if (returnCode == hresult_t::SUCCESS)
         {
+            // The model may have changed, so that the cached kinematics is meaningless
+            invalidateKinematics();
+
             // Extract the dimensions of the configuration and velocity vectors
             nq_ = pncModel_.nq;
             nv_ = pncModel_.nv;
@@ -492,6 +1211,49 @@ namespace jiminy
                     }
                 }
             }
+
+            /* Gather the degrees of freedom and the limits of the bounded joints contiguously, so
+               that the bound forces can be evaluated all at once. Only the rigid joints having
+               as many position and velocity coordinates are supported (TODO: Add support of
+               spherical and planar joints). */
+            boundedJointsPositionIdx_.clear();
+            boundedJointsVelocityIdx_.clear();
+            for (int32_t const & rigidIdx : rigidJointsModelIdx_)
+            {
+                auto const & joint = pncModel_.joints[rigidIdx];
+                if (joint.nq() == joint.nv())
+                {
+                    for (int32_t j = 0; j < joint.nq(); j++)
+                    {
+                        boundedJointsPositionIdx_.push_back(joint.idx_q() + j);
+                        boundedJointsVelocityIdx_.push_back(joint.idx_v() + j);
+                    }
+                }
+            }
+            uint32_t const nBounded = boundedJointsPositionIdx_.size();
+            boundedJointsPositionLimitMin_.resize(nBounded);
+            boundedJointsPositionLimitMax_.resize(nBounded);
+            boundedJointsVelocityLimit_.resize(nBounded);
+            for (uint32_t i=0; i < nBounded; i++)
+            {
+                boundedJointsPositionLimitMin_[i] = positionLimitMin_[boundedJointsPositionIdx_[i]];
+                boundedJointsPositionLimitMax_[i] = positionLimitMax_[boundedJointsPositionIdx_[i]];
+                boundedJointsVelocityLimit_[i] = velocityLimit_[boundedJointsVelocityIdx_[i]];
+            }
+
+            // Gather the indices and the parameters of the enabled flexibility joints
+            std::vector<int32_t> const & flexibilityIdx = getFlexibleJointsModelIdx();
+            flexibleJointsPositionIdx_.resize(flexibilityIdx.size());
+            flexibleJointsVelocityIdx_.resize(flexibilityIdx.size());
+            flexibleJointsStiffness_.resize(3, flexibilityIdx.size());
+            flexibleJointsDamping_.resize(3, flexibilityIdx.size());
+            for (uint32_t i=0; i < flexibilityIdx.size(); ++i)
+            {
+                flexibleJointsPositionIdx_[i] = pncModel_.joints[flexibilityIdx[i]].idx_q();
+                flexibleJointsVelocityIdx_[i] = pncModel_.joints[flexibilityIdx[i]].idx_v();
+                flexibleJointsStiffness_.col(i) = mdlOptions_->dynamics.flexibilityConfig[i].stiffness;
+                flexibleJointsDamping_.col(i) = mdlOptions_->dynamics.flexibilityConfig[i].damping;
+            }
         }
 
         if (returnCode == hresult_t::SUCCESS)
@@ -499,6 +1261,11 @@ namespace jiminy
             returnCode = refreshContactsProxies();
         }
 
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = refreshCollisionsProxies();
+        }
+
         return returnCode;
     }
 
@@ -521,46 +1288,158 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t Model::refreshCollisionsProxies(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!isInitialized_)
+        {
+            std::cout << "Error - Model::refreshCollisionsProxies - Model not initialized." << std::endl;
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        for (collisionGeometry_t & geometry : collisionGeometries_)
+        {
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                /* Attach the geometry directly to the parent joint of its body, since the
+                   flexibility joints may have been inserted in between. */
+                int32_t frameIdx;
+                returnCode = getFrameIdx(pncModel_, geometry.bodyName, frameIdx);
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    pinocchio::Frame const & frame = pncModel_.frames[frameIdx];
+                    geometry.jointIdx = frame.parent;
+                    geometry.jointPlacement = frame.placement * geometry.placement;
+                }
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                int32_t frameRigidIdx;
+                returnCode = getFrameIdx(*pncModelRigidOrig_, geometry.bodyName, frameRigidIdx);
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    geometry.jointRigidIdx = pncModelRigidOrig_->frames[frameRigidIdx].parent;
+                }
+            }
+        }
+
+        return returnCode;
+    }
+
     hresult_t Model::setOptions(configHolder_t modelOptions)
     {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
         bool_t internalBuffersMustBeUpdated = false;
+        bool_t isReducedModelInvalid = false;
         bool_t isFlexibleModelInvalid = false;
         bool_t isCurrentModelInvalid = false;
         if (isInitialized_)
         {
-            /* Check that the following user parameters has the right dimension,
-               then update the required internal buffers to reflect changes, if any. */
             configHolder_t & jointOptionsHolder =
                 boost::get<configHolder_t>(modelOptions.at("joints"));
+
+            /* Check if the reduced model must be regenerated. In such a case, the
+               expected dimension of the joint limits is the one of the new model. */
+            std::vector<std::string> const & lockedJointsNames =
+                boost::get<std::vector<std::string> >(jointOptionsHolder.at("lockedJointsNames"));
+            std::vector<vectorN_t> const & lockedJointsPositions =
+                boost::get<std::vector<vectorN_t> >(jointOptionsHolder.at("lockedJointsPositions"));
+            int32_t nqRigid = static_cast<int32_t>(rigidJointsPositionIdx_.size());
+            int32_t nvRigid = static_cast<int32_t>(rigidJointsVelocityIdx_.size());
+            if (mdlOptions_
+            && (lockedJointsNames != mdlOptions_->joints.lockedJointsNames
+                || lockedJointsPositions.size() != mdlOptions_->joints.lockedJointsPositions.size()
+                || !std::equal(lockedJointsPositions.begin(),
+                               lockedJointsPositions.end(),
+                               mdlOptions_->joints.lockedJointsPositions.begin(),
+                               [](vectorN_t const & q1, vectorN_t const & q2)
+                               {
+                                   return q1.size() == q2.size() && ((q1 - q2).array().abs() < EPS).all();
+                               })))
+            {
+                isReducedModelInvalid = true;
+                nqRigid = 0;
+                nvRigid = 0;
+                for (int32_t i = hasFreeflyer_ ? 2 : 1; i < pncModelFull_->njoints; i++)
+                {
+                    std::string const & jointName = pncModelFull_->names[i];
+                    if (std::find(lockedJointsNames.begin(), lockedJointsNames.end(), jointName) == lockedJointsNames.end())
+                    {
+                        nqRigid += pncModelFull_->joints[i].nq();
+                        nvRigid += pncModelFull_->joints[i].nv();
+                    }
+                }
+
+                /* Check the locked joints before updating the options, since the model would be
+                   left with invalid options if the generation of the reduced model fails. */
+                if (!lockedJointsPositions.empty()
+                && lockedJointsPositions.size() != lockedJointsNames.size())
+                {
+                    std::cout << "Error - Model::setOptions - 'lockedJointsPositions' must be empty or have the same size as 'lockedJointsNames'." << std::endl;
+                    return hresult_t::ERROR_BAD_INPUT;
+                }
+                for (uint32_t i = 0; i < lockedJointsNames.size(); i++)
+                {
+                    std::string const & jointName = lockedJointsNames[i];
+                    if (!pncModelFull_->existJointName(jointName))
+                    {
+                        std::cout << "Error - Model::setOptions - Locked joint '" << jointName << "' does not exist." << std::endl;
+                        return hresult_t::ERROR_BAD_INPUT;
+                    }
+                    pinocchio::JointIndex const jointIdx = pncModelFull_->getJointId(jointName);
+                    if (hasFreeflyer_ && jointIdx == 1)
+                    {
+                        std::cout << "Error - Model::setOptions - The freeflyer cannot be locked." << std::endl;
+                        return hresult_t::ERROR_BAD_INPUT;
+                    }
+                    if (std::count(lockedJointsNames.begin(), lockedJointsNames.end(), jointName) > 1)
+                    {
+                        std::cout << "Error - Model::setOptions - Locked joint '" << jointName << "' specified twice." << std::endl;
+                        return hresult_t::ERROR_BAD_INPUT;
+                    }
+                    if (!lockedJointsPositions.empty()
+                    && lockedJointsPositions[i].size() != pncModelFull_->joints[jointIdx].nq())
+                    {
+                        std::cout << "Error - Model::setOptions - Wrong vector size for the position of locked joint '" << jointName << "'." << std::endl;
+                        return hresult_t::ERROR_BAD_INPUT;
+                    }
+                }
+            }
+
+            /* Check that the following user parameters has the right dimension,
+               then update the required internal buffers to reflect changes, if any. */
             if (!boost::get<bool_t>(jointOptionsHolder.at("positionLimitFromUrdf")))
             {
                 vectorN_t & jointsPositionLimitMin = boost::get<vectorN_t>(jointOptionsHolder.at("positionLimitMin"));
-                if ((int32_t) rigidJointsPositionIdx_.size() != jointsPositionLimitMin.size())
+                if (nqRigid != jointsPositionLimitMin.size())
                 {
                     std::cout << "Error - Model::setOptions - Wrong vector size for 'positionLimitMin'." << std::endl;
                     return hresult_t::ERROR_BAD_INPUT;
                 }
-                vectorN_t jointsPositionLimitMinDiff = jointsPositionLimitMin - mdlOptions_->joints.positionLimitMin;
-                internalBuffersMustBeUpdated |= (jointsPositionLimitMinDiff.array().abs() >= EPS).all();
+                internalBuffersMustBeUpdated |= isReducedModelInvalid
+                    || ((jointsPositionLimitMin - mdlOptions_->joints.positionLimitMin).array().abs() >= EPS).all();
                 vectorN_t & jointsPositionLimitMax = boost::get<vectorN_t>(jointOptionsHolder.at("positionLimitMax"));
-                if ((uint32_t) rigidJointsPositionIdx_.size() != jointsPositionLimitMax.size())
+                if (nqRigid != jointsPositionLimitMax.size())
                 {
                     std::cout << "Error - Model::setOptions - Wrong vector size for 'positionLimitMax'." << std::endl;
                     return hresult_t::ERROR_BAD_INPUT;
                 }
-                vectorN_t jointsPositionLimitMaxDiff = jointsPositionLimitMax - mdlOptions_->joints.positionLimitMax;
-                internalBuffersMustBeUpdated |= (jointsPositionLimitMaxDiff.array().abs() >= EPS).all();
+                internalBuffersMustBeUpdated |= isReducedModelInvalid
+                    || ((jointsPositionLimitMax - mdlOptions_->joints.positionLimitMax).array().abs() >= EPS).all();
             }
             if (!boost::get<bool_t>(jointOptionsHolder.at("velocityLimitFromUrdf")))
             {
                 vectorN_t & jointsVelocityLimit = boost::get<vectorN_t>(jointOptionsHolder.at("velocityLimit"));
-                if ((int32_t) rigidJointsVelocityIdx_.size() != jointsVelocityLimit.size())
+                if (nvRigid != jointsVelocityLimit.size())
                 {
                     std::cout << "Error - Model::setOptions - Wrong vector size for 'velocityLimit'." << std::endl;
                     return hresult_t::ERROR_BAD_INPUT;
                 }
-                vectorN_t jointsVelocityLimitDiff = jointsVelocityLimit - mdlOptions_->joints.velocityLimit;
-                internalBuffersMustBeUpdated |= (jointsVelocityLimitDiff.array().abs() >= EPS).all();
+                internalBuffersMustBeUpdated |= isReducedModelInvalid
+                    || ((jointsVelocityLimit - mdlOptions_->joints.velocityLimit).array().abs() >= EPS).all();
             }
 
             // Check if the flexible model and its associated proxies must be regenerated
@@ -590,24 +1469,33 @@ namespace jiminy
         // Create a fast struct accessor
         mdlOptions_ = std::make_unique<modelOptions_t const>(mdlOptionsHolder_);
 
-        if (isFlexibleModelInvalid)
+        if (isReducedModelInvalid)
         {
-            // Force flexible model regeneration
-            generateModelFlexible();
+            // Force reduced model regeneration
+            returnCode = generateModelReduced();
         }
 
-        if (isFlexibleModelInvalid || isCurrentModelInvalid)
+        if (returnCode == hresult_t::SUCCESS && (isReducedModelInvalid || isFlexibleModelInvalid))
         {
-            // Trigger biased model regeneration
-            reset();
+            // Force flexible model regeneration
+            generateModelFlexible();
         }
-        else if (internalBuffersMustBeUpdated)
+
+        if (returnCode == hresult_t::SUCCESS)
         {
-            // Update the info extracted from the model
-            refreshProxies();
+            if (isReducedModelInvalid || isFlexibleModelInvalid || isCurrentModelInvalid)
+            {
+                // Trigger biased model regeneration
+                reset();
+            }
+            else if (internalBuffersMustBeUpdated)
+            {
+                // Update the info extracted from the model
+                refreshProxies();
+            }
         }
 
-        return hresult_t::SUCCESS;
+        return returnCode;
     }
 
     configHolder_t Model::getOptions(void) const
@@ -625,34 +1513,31 @@ namespace jiminy
         return urdfPath_;
     }
 
+    std::string const & Model::getUrdfData(void) const
+    {
+        return *urdfData_;
+    }
+
     bool_t const & Model::getHasFreeflyer(void) const
     {
         return hasFreeflyer_;
     }
 
-    hresult_t Model::loadUrdfModel(std::string const & urdfPath,
+    hresult_t Model::loadUrdfModel(std::string const & urdfData,
                                    bool_t      const & hasFreeflyer)
     {
-        if (!std::ifstream(urdfPath.c_str()).good())
-        {
-            std::cout << "Error - Model::loadUrdfModel - The URDF file does not exist. Impossible to load it." << std::endl;
-            return hresult_t::ERROR_BAD_INPUT;
-        }
-
-        urdfPath_ = urdfPath;
-        hasFreeflyer_ = hasFreeflyer;
-
         try
         {
+            pncModel_ = pinocchio::Model();
             if (hasFreeflyer)
             {
-                pinocchio::urdf::buildModel(urdfPath,
-                                            pinocchio::JointModelFreeFlyer(),
-                                            pncModel_);
+                pinocchio::urdf::buildModelFromXML(urdfData,
+                                                   pinocchio::JointModelFreeFlyer(),
+                                                   pncModel_);
             }
             else
             {
-                pinocchio::urdf::buildModel(urdfPath, pncModel_);
+                pinocchio::urdf::buildModelFromXML(urdfData, pncModel_);
             }
         }
         catch (std::exception& e)
@@ -661,6 +1546,85 @@ namespace jiminy
             return hresult_t::ERROR_BAD_INPUT;
         }
 
+        // Extract the collision geometry of the bodies. Only the primitive shapes are supported.
+        auto const urdfTree = ::urdf::parseURDF(urdfData);
+        if (!urdfTree)
+        {
+            std::cout << "Error - Model::loadUrdfModel - Impossible to parse the collision geometry of the URDF." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+        collisionGeometries_.clear();
+        for (auto const & link : urdfTree->links_)
+        {
+            for (auto const & collision : link.second->collision_array)
+            {
+                ::urdf::Geometry const * geometry = collision->geometry.get();
+                if (!geometry)
+                {
+                    continue;
+                }
+
+                collisionGeometry_t collisionGeometry;
+                collisionGeometry.bodyName = link.first;
+                switch (geometry->type)
+                {
+                case ::urdf::Geometry::SPHERE:
+                {
+                    float64_t const & radius = static_cast<::urdf::Sphere const *>(geometry)->radius;
+                    collisionGeometry.shape = collisionShape_t::SPHERE;
+                    collisionGeometry.size = vector3_t(radius, 0.0, 0.0);
+                    collisionGeometry.boundingRadius = radius;
+                    break;
+                }
+                case ::urdf::Geometry::BOX:
+                {
+                    ::urdf::Vector3 const & dim = static_cast<::urdf::Box const *>(geometry)->dim;
+                    collisionGeometry.shape = collisionShape_t::BOX;
+                    collisionGeometry.size = 0.5 * vector3_t(dim.x, dim.y, dim.z);
+                    collisionGeometry.boundingRadius = collisionGeometry.size.norm();
+                    for (uint8_t i = 0; i < 8; i++)
+                    {
+                        vector3_t const signs((i & 1) ? 1.0 : -1.0, (i & 2) ? 1.0 : -1.0, (i & 4) ? 1.0 : -1.0);
+                        collisionGeometry.probePoints.push_back(collisionGeometry.size.cwiseProduct(signs));
+                    }
+                    break;
+                }
+                case ::urdf::Geometry::CYLINDER:
+                {
+                    ::urdf::Cylinder const * cylinder = static_cast<::urdf::Cylinder const *>(geometry);
+                    collisionGeometry.shape = collisionShape_t::CYLINDER;
+                    collisionGeometry.size = vector3_t(cylinder->radius, 0.5 * cylinder->length, 0.0);
+                    collisionGeometry.boundingRadius = std::hypot(cylinder->radius, 0.5 * cylinder->length);
+                    for (uint8_t i = 0; i < COLLISION_CYLINDER_RIM_POINTS; i++)
+                    {
+                        float64_t const angle = 2 * M_PI * i / COLLISION_CYLINDER_RIM_POINTS;
+                        for (float64_t const & side : {-1.0, 1.0})
+                        {
+                            collisionGeometry.probePoints.emplace_back(cylinder->radius * std::cos(angle),
+                                                                       cylinder->radius * std::sin(angle),
+                                                                       side * 0.5 * cylinder->length);
+                        }
+                    }
+                    break;
+                }
+                case ::urdf::Geometry::MESH:
+                default:
+                    // Meshes are ignored
+                    continue;
+                }
+
+                ::urdf::Pose const & origin = collision->origin;
+                collisionGeometry.placement = pinocchio::SE3(
+                    Eigen::Quaterniond(origin.rotation.w, origin.rotation.x,
+                                       origin.rotation.y, origin.rotation.z).toRotationMatrix(),
+                    vector3_t(origin.position.x, origin.position.y, origin.position.z));
+                collisionGeometry.jointIdx = 0;
+                collisionGeometry.jointRigidIdx = 0;
+                collisionGeometry.jointPlacement = pinocchio::SE3::Identity();
+                collisionGeometries_.push_back(std::move(collisionGeometry));
+            }
+        }
+
         return hresult_t::SUCCESS;
     }
 
@@ -668,10 +1632,10 @@ namespace jiminy
                                                vectorN_t       & xFlex) const
     {
         // Define some proxies
-        uint32_t const & nqRigid = pncModelRigidOrig_.nq;
-        uint32_t const & nvRigid = pncModelRigidOrig_.nv;
-        uint32_t const & nqFlex = pncModelFlexibleOrig_.nq;
-        uint32_t const & nvFlex = pncModelFlexibleOrig_.nv;
+        uint32_t const & nqRigid = pncModelRigidOrig_->nq;
+        uint32_t const & nvRigid = pncModelRigidOrig_->nv;
+        uint32_t const & nqFlex = pncModelFlexibleOrig_->nq;
+        uint32_t const & nvFlex = pncModelFlexibleOrig_->nv;
 
         // Check the size of the input state
         if (xRigid.size() != nqRigid + nvRigid)
@@ -682,19 +1646,19 @@ namespace jiminy
 
         // Initialize the flexible state
         xFlex.resize(nqFlex + nvFlex);
-        xFlex << pinocchio::neutral(pncModelFlexibleOrig_), vectorN_t::Zero(nvFlex);
+        xFlex << pinocchio::neutral(*pncModelFlexibleOrig_), vectorN_t::Zero(nvFlex);
 
         // Compute the flexible state based on the rigid state
         int32_t idxRigid = 0;
         int32_t idxFlex = 0;
-        for (; idxRigid < pncModelRigidOrig_.njoints; idxFlex++)
+        for (; idxRigid < pncModelRigidOrig_->njoints; idxFlex++)
         {
-            std::string const & jointRigidName = pncModelRigidOrig_.names[idxRigid];
-            std::string const & jointFlexName = pncModelFlexibleOrig_.names[idxFlex];
+            std::string const & jointRigidName = pncModelRigidOrig_->names[idxRigid];
+            std::string const & jointFlexName = pncModelFlexibleOrig_->names[idxFlex];
             if (jointRigidName == jointFlexName)
             {
-                auto const & jointRigid = pncModelRigidOrig_.joints[idxRigid];
-                auto const & jointFlex = pncModelFlexibleOrig_.joints[idxFlex];
+                auto const & jointRigid = pncModelRigidOrig_->joints[idxRigid];
+                auto const & jointFlex = pncModelFlexibleOrig_->joints[idxFlex];
                 if (jointRigid.idx_q() >= 0)
                 {
                     xFlex.segment(jointFlex.idx_q(), jointFlex.nq()) =
@@ -713,10 +1677,10 @@ namespace jiminy
                                                vectorN_t       & xRigid) const
     {
         // Define some proxies
-        uint32_t const & nqRigid = pncModelRigidOrig_.nq;
-        uint32_t const & nvRigid = pncModelRigidOrig_.nv;
-        uint32_t const & nqFlex = pncModelFlexibleOrig_.nq;
-        uint32_t const & nvFlex = pncModelFlexibleOrig_.nv;
+        uint32_t const & nqRigid = pncModelRigidOrig_->nq;
+        uint32_t const & nvRigid = pncModelRigidOrig_->nv;
+        uint32_t const & nqFlex = pncModelFlexibleOrig_->nq;
+        uint32_t const & nvFlex = pncModelFlexibleOrig_->nv;
 
         // Check the size of the input state
         if (xFlex.size() != nqFlex + nvFlex)
@@ -727,19 +1691,19 @@ namespace jiminy
 
         // Initialize the flexible state
         xRigid.resize(nqRigid + nvRigid);
-        xRigid << pinocchio::neutral(pncModelRigidOrig_), vectorN_t::Zero(nvRigid);
+        xRigid << pinocchio::neutral(*pncModelRigidOrig_), vectorN_t::Zero(nvRigid);
 
         // Compute the flexible state based on the rigid state
         int32_t idxRigid = 0;
         int32_t idxFlex = 0;
-        for (; idxFlex < pncModelFlexibleOrig_.njoints; idxRigid++, idxFlex++)
+        for (; idxFlex < pncModelFlexibleOrig_->njoints; idxRigid++, idxFlex++)
         {
-            std::string const & jointRigidName = pncModelRigidOrig_.names[idxRigid];
-            std::string const & jointFlexName = pncModelFlexibleOrig_.names[idxFlex];
+            std::string const & jointRigidName = pncModelRigidOrig_->names[idxRigid];
+            std::string const & jointFlexName = pncModelFlexibleOrig_->names[idxFlex];
             if (jointRigidName == jointFlexName)
             {
-                auto const & jointRigid = pncModelRigidOrig_.joints[idxRigid];
-                auto const & jointFlex = pncModelFlexibleOrig_.joints[idxFlex];
+                auto const & jointRigid = pncModelRigidOrig_->joints[idxRigid];
+                auto const & jointFlex = pncModelFlexibleOrig_->joints[idxFlex];
                 if (jointRigid.idx_q() >= 0)
                 {
                     xRigid.segment(jointRigid.idx_q(), jointRigid.nq()) =
@@ -757,6 +1721,31 @@ namespace jiminy
         return hresult_t::SUCCESS;
     }
 
+    hresult_t Model::getFullPositionFromRigid(vectorN_t const & qRigid,
+                                              vectorN_t       & qFull) const
+    {
+        // Check the size of the input configuration
+        if (qRigid.size() != pncModelRigidOrig_->nq)
+        {
+            std::cout << "Error - Model::getFullPositionFromRigid - Size of qRigid inconsistent with theoretical model." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        // The locked joints are at their prescribed position
+        qFull = lockedConfigurationFull_;
+
+        // Copy the configuration of the remaining joints, skipping the 'universe'
+        for (int32_t i = 1; i < pncModelRigidOrig_->njoints; i++)
+        {
+            auto const & jointRigid = pncModelRigidOrig_->joints[i];
+            auto const & jointFull = pncModelFull_->joints[pncModelFull_->getJointId(pncModelRigidOrig_->names[i])];
+            qFull.segment(jointFull.idx_q(), jointFull.nq()) =
+                qRigid.segment(jointRigid.idx_q(), jointRigid.nq());
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     std::vector<std::string> const & Model::getContactFramesNames(void) const
     {
         return contactFramesNames_;
@@ -767,6 +1756,11 @@ namespace jiminy
         return contactFramesIdx_;
     }
 
+    std::vector<collisionGeometry_t> const & Model::getCollisionGeometries(void) const
+    {
+        return collisionGeometries_;
+    }
+
     std::vector<std::string> const & Model::getPositionFieldnames(void) const
     {
         return positionFieldnames_;
@@ -817,6 +1811,51 @@ namespace jiminy
         return rigidJointsVelocityIdx_;
     }
 
+    std::vector<int32_t> const & Model::getBoundedJointsPositionIdx(void) const
+    {
+        return boundedJointsPositionIdx_;
+    }
+
+    std::vector<int32_t> const & Model::getBoundedJointsVelocityIdx(void) const
+    {
+        return boundedJointsVelocityIdx_;
+    }
+
+    vectorN_t const & Model::getBoundedJointsPositionLimitMin(void) const
+    {
+        return boundedJointsPositionLimitMin_;
+    }
+
+    vectorN_t const & Model::getBoundedJointsPositionLimitMax(void) const
+    {
+        return boundedJointsPositionLimitMax_;
+    }
+
+    vectorN_t const & Model::getBoundedJointsVelocityLimit(void) const
+    {
+        return boundedJointsVelocityLimit_;
+    }
+
+    std::vector<int32_t> const & Model::getFlexibleJointsPositionIdx(void) const
+    {
+        return flexibleJointsPositionIdx_;
+    }
+
+    std::vector<int32_t> const & Model::getFlexibleJointsVelocityIdx(void) const
+    {
+        return flexibleJointsVelocityIdx_;
+    }
+
+    matrixN_t const & Model::getFlexibleJointsStiffness(void) const
+    {
+        return flexibleJointsStiffness_;
+    }
+
+    matrixN_t const & Model::getFlexibleJointsDamping(void) const
+    {
+        return flexibleJointsDamping_;
+    }
+
     std::vector<std::string> const & Model::getFlexibleJointsNames(void) const
     {
         static std::vector<std::string> const flexibleJointsNamesEmpty {};
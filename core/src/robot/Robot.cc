@@ -2,6 +2,12 @@
 #include <iostream>
 #include <fstream>
 #include <exception>
+#include <sstream>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
 
 #include "pinocchio/parsers/urdf.hpp"
 #include "pinocchio/algorithm/kinematics.hpp"
@@ -12,6 +18,9 @@
 #include "jiminy/core/robot/AbstractConstraint.h"
 #include "jiminy/core/robot/AbstractMotor.h"
 #include "jiminy/core/robot/AbstractSensor.h"
+#include "jiminy/core/robot/BasicMotors.h"
+#include "jiminy/core/robot/BasicSensors.h"
+#include "jiminy/core/robot/FixedFrameConstraint.h"
 #include "jiminy/core/telemetry/TelemetryData.h"
 #include "jiminy/core/io/FileDevice.h"
 
@@ -35,7 +44,14 @@ namespace jiminy
     constraintsDrift_(),
     mutexLocal_(),
     motorsSharedHolder_(nullptr),
-    sensorsSharedHolder_()
+    sensorsSharedHolder_(),
+    sensorsTypesPending_(),
+    sensorsTimePending_(0.0),
+    sensorsQPending_(),
+    sensorsVPending_(),
+    sensorsAPending_(),
+    sensorsUPending_(),
+    sensorsTypesLogged_()
     {
         // Empty on purpose
     }
@@ -47,8 +63,9 @@ namespace jiminy
         detachSensors();
     }
 
-    hresult_t Robot::initialize(std::string const & urdfPath,
-                                bool_t      const & hasFreeflyer)
+    hresult_t Robot::initializeFromUrdfData(std::string const & urdfPath,
+                                            std::string const & urdfData,
+                                            bool_t      const & hasFreeflyer)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
@@ -61,7 +78,7 @@ namespace jiminy
 
         /* Delete the current model and generate a new one.
            Note that is also refresh all proxies automatically. */
-        returnCode = Model::initialize(urdfPath, hasFreeflyer);
+        returnCode = Model::initializeFromUrdfData(urdfPath, urdfData, hasFreeflyer);
 
         return returnCode;
     }
@@ -85,11 +102,35 @@ namespace jiminy
                 (*sensorGroup.second.begin())->resetAll();
             }
         }
+        sensorsTypesPending_.clear();
 
         // Reset the telemetry flag
         isTelemetryConfigured_ = false;
     }
 
+    void Robot::seedRandomStreams(uint32_t    const & seed,
+                                  std::string const & streamName,
+                                  bool_t      const & resetStreams)
+    {
+        // Seed the stream of the model
+        Model::seedRandomStreams(seed, streamName, resetStreams);
+
+        // Seed the stream of every sensor, identified by its type and name
+        for (auto & sensorGroup : sensorsGroupHolder_)
+        {
+            for (auto & sensor : sensorGroup.second)
+            {
+                uint64_t const counter = sensor->generator_.getCounter();
+                sensor->generator_.seed(seed, streamName + TELEMETRY_DELIMITER + sensor->getType()
+                                       + TELEMETRY_DELIMITER + sensor->getName());
+                if (!resetStreams)
+                {
+                    sensor->generator_.setCounter(counter);
+                }
+            }
+        }
+    }
+
     hresult_t Robot::configureTelemetry(std::shared_ptr<TelemetryData> telemetryData,
                                         std::string const & objectPrefixName)
     {
@@ -134,6 +175,45 @@ namespace jiminy
         return returnCode;
     }
 
+    void Robot::resumeTelemetry(void)
+    {
+        for (auto & sensorGroup : sensorsGroupHolder_)
+        {
+            if (sensorTelemetryOptions_.at(sensorGroup.first))
+            {
+                for (auto & sensor : sensorGroup.second)
+                {
+                    sensor->isTelemetryConfigured_ = true;
+                }
+            }
+        }
+        isTelemetryConfigured_ = true;
+    }
+
+    uint64_t Robot::getTelemetryFingerprint(void) const
+    {
+        /* The sensors are stored in an unordered map, so that the hashes of the groups are
+           combined in a way that does not depend on the order. The telemetry data to which
+           each sensor is bound is taken into account, to detect the sensors never configured. */
+        uint64_t fingerprint = 0U;
+        for (auto const & sensorGroup : sensorsGroupHolder_)
+        {
+            if (sensorTelemetryOptions_.at(sensorGroup.first))
+            {
+                uint64_t sensorGroupHash = computeHash(sensorGroup.first);
+                for (auto const & sensor : sensorGroup.second)
+                {
+                    uintptr_t const telemetryDataAddress = reinterpret_cast<uintptr_t>(
+                        sensor->telemetrySender_.getTelemetryData().get());
+                    sensorGroupHash = computeHash(std::vector<std::string>{
+                        sensor->getName(), std::to_string(telemetryDataAddress)}, sensorGroupHash);
+                }
+                fingerprint += sensorGroupHash;
+            }
+        }
+        return fingerprint;
+    }
+
     hresult_t Robot::attachMotor(std::shared_ptr<AbstractMotorBase> motor)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
@@ -1266,6 +1346,288 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t Robot::dumpToBinary(std::string & data) const
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!isInitialized_)
+        {
+            std::cout << "Error - Robot::dumpToBinary - Robot not initialized." << std::endl;
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        std::ostringstream stream;
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            boost::archive::binary_oarchive ar(stream, boost::archive::no_header);
+
+            // Serialize the model itself
+            ar << urdfPath_;
+            ar << getUrdfData();
+            ar << hasFreeflyer_;
+            ar << contactFramesNames_;
+
+            // Serialize the motors
+            ar << motorsHolder_.size();
+            for (std::shared_ptr<AbstractMotorBase> const & motor : motorsHolder_)
+            {
+                std::string motorType;
+                if (std::dynamic_pointer_cast<SimpleMotor>(motor))
+                {
+                    motorType = "SimpleMotor";
+                }
+                else if (std::dynamic_pointer_cast<DcMotor>(motor))
+                {
+                    motorType = "DcMotor";
+                }
+                else
+                {
+                    std::cout << "Error - Robot::dumpToBinary - Motor '" << motor->getName() << "' is not a built-in motor." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+                ar << motorType;
+                ar << motor->getName();
+                ar << motor->getJointName();
+            }
+
+            // Serialize the sensors
+            std::size_t nSensors = 0U;
+            for (auto const & sensorGroup : sensorsGroupHolder_)
+            {
+                nSensors += sensorGroup.second.size();
+            }
+            ar << nSensors;
+            for (auto const & sensorGroup : sensorsGroupHolder_)
+            {
+                for (std::shared_ptr<AbstractSensorBase> const & sensor : sensorGroup.second)
+                {
+                    std::string sensorTarget;
+                    if (auto imuSensor = std::dynamic_pointer_cast<ImuSensor>(sensor))
+                    {
+                        sensorTarget = imuSensor->getFrameName();
+                    }
+                    else if (auto forceSensor = std::dynamic_pointer_cast<ForceSensor>(sensor))
+                    {
+                        sensorTarget = forceSensor->getFrameName();
+                    }
+                    else if (auto encoderSensor = std::dynamic_pointer_cast<EncoderSensor>(sensor))
+                    {
+                        sensorTarget = encoderSensor->getJointName();
+                    }
+                    else if (auto effortSensor = std::dynamic_pointer_cast<EffortSensor>(sensor))
+                    {
+                        sensorTarget = effortSensor->getMotorName();
+                    }
+                    else
+                    {
+                        std::cout << "Error - Robot::dumpToBinary - Sensor '" << sensor->getName() << "' is not a built-in sensor." << std::endl;
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                        break;
+                    }
+                    ar << sensor->getType();
+                    ar << sensor->getName();
+                    ar << sensorTarget;
+                }
+            }
+
+            // Serialize the constraints
+            ar << constraintsHolder_.size();
+            for (robotConstraint_t const & constraint : constraintsHolder_)
+            {
+                auto fixedFrameConstraint = std::dynamic_pointer_cast<FixedFrameConstraint>(constraint.constraint_);
+                if (!fixedFrameConstraint)
+                {
+                    std::cout << "Error - Robot::dumpToBinary - Constraint '" << constraint.name_ << "' is not a built-in constraint." << std::endl;
+                    returnCode = hresult_t::ERROR_BAD_INPUT;
+                    break;
+                }
+                ar << constraint.name_;
+                ar << fixedFrameConstraint->getFrameName();
+            }
+
+            // Serialize the options
+            std::string robotOptionsData;
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = binaryDump(getOptions(), robotOptionsData);
+            }
+            ar << robotOptionsData;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            data = stream.str();
+        }
+
+        return returnCode;
+    }
+
+    hresult_t Robot::loadFromBinary(std::string const & data)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        try
+        {
+            std::istringstream stream(data);
+            boost::archive::binary_iarchive ar(stream, boost::archive::no_header);
+
+            // Rebuild the model without accessing the filesystem
+            std::string urdfPath;
+            std::string urdfData;
+            bool_t hasFreeflyer;
+            std::vector<std::string> contactFramesNames;
+            ar >> urdfPath;
+            ar >> urdfData;
+            ar >> hasFreeflyer;
+            ar >> contactFramesNames;
+            constraintsHolder_.clear();
+            returnCode = initializeFromUrdfData(urdfPath, urdfData, hasFreeflyer);
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = addContactPoints(contactFramesNames);
+            }
+
+            // Restore the motors
+            std::size_t nMotors;
+            ar >> nMotors;
+            for (std::size_t i = 0; i < nMotors; i++)
+            {
+                std::string motorType;
+                std::string motorName;
+                std::string jointName;
+                ar >> motorType;
+                ar >> motorName;
+                ar >> jointName;
+
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    if (motorType == "SimpleMotor")
+                    {
+                        auto motor = std::make_shared<SimpleMotor>(motorName);
+                        returnCode = attachMotor(motor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = motor->initialize(jointName);
+                        }
+                    }
+                    else if (motorType == "DcMotor")
+                    {
+                        auto motor = std::make_shared<DcMotor>(motorName);
+                        returnCode = attachMotor(motor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = motor->initialize(jointName);
+                        }
+                    }
+                    else
+                    {
+                        std::cout << "Error - Robot::loadFromBinary - Unknown motor type '" << motorType << "'." << std::endl;
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                    }
+                }
+            }
+
+            // Restore the sensors
+            std::size_t nSensors;
+            ar >> nSensors;
+            for (std::size_t i = 0; i < nSensors; i++)
+            {
+                std::string sensorType;
+                std::string sensorName;
+                std::string sensorTarget;
+                ar >> sensorType;
+                ar >> sensorName;
+                ar >> sensorTarget;
+
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    if (sensorType == ImuSensor::type_)
+                    {
+                        auto sensor = std::make_shared<ImuSensor>(sensorName);
+                        returnCode = attachSensor(sensor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = sensor->initialize(sensorTarget);
+                        }
+                    }
+                    else if (sensorType == ForceSensor::type_)
+                    {
+                        auto sensor = std::make_shared<ForceSensor>(sensorName);
+                        returnCode = attachSensor(sensor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = sensor->initialize(sensorTarget);
+                        }
+                    }
+                    else if (sensorType == EncoderSensor::type_)
+                    {
+                        auto sensor = std::make_shared<EncoderSensor>(sensorName);
+                        returnCode = attachSensor(sensor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = sensor->initialize(sensorTarget);
+                        }
+                    }
+                    else if (sensorType == EffortSensor::type_)
+                    {
+                        auto sensor = std::make_shared<EffortSensor>(sensorName);
+                        returnCode = attachSensor(sensor);
+                        if (returnCode == hresult_t::SUCCESS)
+                        {
+                            returnCode = sensor->initialize(sensorTarget);
+                        }
+                    }
+                    else
+                    {
+                        std::cout << "Error - Robot::loadFromBinary - Unknown sensor type '" << sensorType << "'." << std::endl;
+                        returnCode = hresult_t::ERROR_BAD_INPUT;
+                    }
+                }
+            }
+
+            // Restore the constraints
+            std::size_t nConstraints;
+            ar >> nConstraints;
+            for (std::size_t i = 0; i < nConstraints; i++)
+            {
+                std::string constraintName;
+                std::string frameName;
+                ar >> constraintName;
+                ar >> frameName;
+
+                if (returnCode == hresult_t::SUCCESS)
+                {
+                    returnCode = addConstraint(constraintName,
+                                               std::make_shared<FixedFrameConstraint>(frameName));
+                }
+            }
+
+            // Restore the options, once every motor and sensor is available
+            std::string robotOptionsData;
+            ar >> robotOptionsData;
+
+            configHolder_t robotOptions;
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = binaryLoad(robotOptions, robotOptionsData);
+            }
+
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = setOptions(robotOptions);
+            }
+        }
+        catch (std::exception const &)
+        {
+            std::cout << "Error - Robot::loadFromBinary - Impossible to load the robot. The data are corrupted." << std::endl;
+            returnCode = hresult_t::ERROR_BAD_INPUT;
+        }
+
+        return returnCode;
+    }
+
     bool_t const & Robot::getIsTelemetryConfigured(void) const
     {
         return isTelemetryConfigured_;
@@ -1312,6 +1674,45 @@ namespace jiminy
         return motorEffortEmpty;
     }
 
+    int32_t Robot::getMotorsStateSize(void) const
+    {
+        return getMotorsState().size();
+    }
+
+    vectorN_t const & Robot::getMotorsState(void) const
+    {
+        static vectorN_t const motorsStateEmpty;
+
+        if (!motorsHolder_.empty())
+        {
+            return (*motorsHolder_.begin())->getStateAll();
+        }
+
+        return motorsStateEmpty;
+    }
+
+    vectorN_t const & Robot::getMotorsStateDerivative(void) const
+    {
+        static vectorN_t const motorsStateDerivativeEmpty;
+
+        if (!motorsHolder_.empty())
+        {
+            return (*motorsHolder_.begin())->getStateDerivativeAll();
+        }
+
+        return motorsStateDerivativeEmpty;
+    }
+
+    hresult_t Robot::setMotorsState(Eigen::Ref<vectorN_t const> const & x)
+    {
+        if (!motorsHolder_.empty())
+        {
+            return (*motorsHolder_.begin())->setStateAll(x);
+        }
+
+        return hresult_t::SUCCESS;
+    }
+
     void Robot::setSensorsData(float64_t                   const & t,
                                Eigen::Ref<vectorN_t const> const & q,
                                Eigen::Ref<vectorN_t const> const & v,
@@ -1325,13 +1726,133 @@ namespace jiminy
                 (*sensorGroup.second.begin())->setAll(t, q, v, a, u);
             }
         }
+        sensorsTypesPending_.clear();
+    }
+
+    void Robot::setSensorsData(std::string                 const & sensorType,
+                               float64_t                   const & t,
+                               Eigen::Ref<vectorN_t const> const & q,
+                               Eigen::Ref<vectorN_t const> const & v,
+                               Eigen::Ref<vectorN_t const> const & a,
+                               vectorN_t                   const & u)
+    {
+        // Update only the sensors of the given type, since they share their data
+        auto sensorGroupIt = sensorsGroupHolder_.find(sensorType);
+        if (sensorGroupIt != sensorsGroupHolder_.end() && !sensorGroupIt->second.empty())
+        {
+            (*sensorGroupIt->second.begin())->setAll(t, q, v, a, u);
+        }
+        sensorsTypesPending_.erase(sensorType);
+    }
+
+    void Robot::setSensorsDataLazy(std::string                 const & sensorType,
+                                   float64_t                   const & t,
+                                   Eigen::Ref<vectorN_t const> const & q,
+                                   Eigen::Ref<vectorN_t const> const & v,
+                                   Eigen::Ref<vectorN_t const> const & a,
+                                   vectorN_t                   const & u)
+    {
+        auto sensorSharedIt = sensorsSharedHolder_.find(sensorType);
+        if (sensorSharedIt == sensorsSharedHolder_.end())
+        {
+            return;
+        }
+
+        // The history of the data is required to handle the delay
+        if (sensorSharedIt->second->delayMax_ > EPS)
+        {
+            setSensorsData(sensorType, t, q, v, a, u);
+            return;
+        }
+
+        /* Record the input state. Note that the sensors sharing the same pending state are
+           necessarily deferred at the same time, since it is only done in continuous mode. */
+        sensorsTimePending_ = t;
+        sensorsQPending_ = q;
+        sensorsVPending_ = v;
+        sensorsAPending_ = a;
+        sensorsUPending_ = u;
+        sensorsTypesPending_.insert(sensorType);
+    }
+
+    void Robot::flushSensorsData(std::string const & sensorType)
+    {
+        if (sensorsTypesPending_.empty()
+        || (!sensorType.empty() && sensorsTypesPending_.find(sensorType) == sensorsTypesPending_.end()))
+        {
+            return;
+        }
+
+        /* Compute the kinematics of the robot at the time the update has been deferred,
+           then restore the current one, on which the other consumers rely. */
+        backupKinematics();
+        computeForwardKinematics(sensorsQPending_, sensorsVPending_, sensorsAPending_, false);
+
+        if (sensorType.empty())
+        {
+            for (std::string const & sensorTypePending : sensorsTypesPending_)
+            {
+                evaluateSensorsPending(sensorTypePending);
+            }
+            sensorsTypesPending_.clear();
+        }
+        else
+        {
+            evaluateSensorsPending(sensorType);
+            sensorsTypesPending_.erase(sensorType);
+        }
+
+        restoreKinematics();
+    }
+
+    void Robot::flushSensorsData(std::vector<std::string> const & sensorsTypes)
+    {
+        bool_t isKinematicsPending = false;
+        for (std::string const & sensorType : sensorsTypes)
+        {
+            auto sensorTypeIt = sensorsTypesPending_.find(sensorType);
+            if (sensorTypeIt == sensorsTypesPending_.end())
+            {
+                continue;
+            }
+
+            // Compute the kinematics of the robot at the time the update has been deferred, once for all
+            if (!isKinematicsPending)
+            {
+                backupKinematics();
+                computeForwardKinematics(sensorsQPending_, sensorsVPending_, sensorsAPending_, false);
+                isKinematicsPending = true;
+            }
+
+            evaluateSensorsPending(sensorType);
+            sensorsTypesPending_.erase(sensorTypeIt);
+        }
+
+        // Restore the current kinematics of the robot, on which the other consumers rely
+        if (isKinematicsPending)
+        {
+            restoreKinematics();
+        }
+    }
+
+    void Robot::evaluateSensorsPending(std::string const & sensorType)
+    {
+        auto sensorGroupIt = sensorsGroupHolder_.find(sensorType);
+        if (sensorGroupIt != sensorsGroupHolder_.end() && !sensorGroupIt->second.empty())
+        {
+            (*sensorGroupIt->second.begin())->setAll(sensorsTimePending_,
+                                                     sensorsQPending_,
+                                                     sensorsVPending_,
+                                                     sensorsAPending_,
+                                                     sensorsUPending_);
+        }
     }
 
     void Robot::computeConstraints(Eigen::Ref<vectorN_t const> const & q,
                                    Eigen::Ref<vectorN_t const> const & v)
     {
-        // Compute joint jacobian.
-        pinocchio::computeJointJacobians(pncModel_, pncData_, q);
+        // Compute joint jacobian, unless already up-to-date.
+        computeJointJacobians(q);
 
         uint32_t currentRow = 0;
         for (auto & constraint : constraintsHolder_)
@@ -1400,6 +1921,20 @@ namespace jiminy
 
     void Robot::updateTelemetry(void)
     {
+        // Evaluate the sensors whose update has been deferred only if they are logged
+        if (!sensorsTypesPending_.empty())
+        {
+            sensorsTypesLogged_.clear();
+            for (std::string const & sensorType : sensorsTypesPending_)
+            {
+                if (sensorTelemetryOptions_.at(sensorType))
+                {
+                    sensorsTypesLogged_.push_back(sensorType);
+                }
+            }
+            flushSensorsData(sensorsTypesLogged_);
+        }
+
         for (auto const & sensorGroup : sensorsGroupHolder_)
         {
             if (!sensorGroup.second.empty())
@@ -1549,4 +2084,18 @@ namespace jiminy
     {
         return !constraintsHolder_.empty();
     }
+
+    std::vector<int32_t> Robot::getConstraintsFramesIdx(void) const
+    {
+        std::vector<int32_t> framesIdx;
+        for (robotConstraint_t const & constraint : constraintsHolder_)
+        {
+            auto fixedFrameConstraint = std::dynamic_pointer_cast<FixedFrameConstraint const>(constraint.constraint_);
+            if (fixedFrameConstraint)
+            {
+                framesIdx.push_back(fixedFrameConstraint->getFrameIdx());
+            }
+        }
+        return framesIdx;
+    }
 }
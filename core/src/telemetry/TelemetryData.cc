@@ -5,12 +5,20 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <algorithm>
 
 #include "jiminy/core/telemetry/TelemetryData.h"
+#include "jiminy/core/Constants.h"
 
 
 namespace jiminy
 {
+    // Alignment of the data sections, in bytes
+    static int64_t alignSection(int64_t const & offset)
+    {
+        return (offset + 7) & ~static_cast<int64_t>(7);
+    }
+
     TelemetryData::TelemetryData() :
     constantsMem_("telemetryConstants", CONSTANTS_MEM_SIZE),
     constantsHeader_(),
@@ -18,7 +26,13 @@ namespace jiminy
     integersHeader_(),
     floatsMem_("telemetryFloats", FLOATS_MEM_SIZE),
     floatsHeader_(),
-    entriesMap_()
+    constantsIndex_(),
+    integersIndex_(),
+    floatsIndex_(),
+    groups_(),
+    constantsMemSize_(CONSTANTS_MEM_SIZE),
+    integersMemSize_(INTEGERS_MEM_SIZE),
+    floatsMemSize_(FLOATS_MEM_SIZE)
     {
         constantsMem_.create();
         constantsHeader_ = static_cast<struct memHeader *>(constantsMem_.address());
@@ -34,50 +48,154 @@ namespace jiminy
 
     void TelemetryData::reset()
     {
-        entriesMap_.clear();
+        constantsIndex_.clear();
+        integersIndex_.clear();
+        floatsIndex_.clear();
+
+        /* Restore the reserved size of the memories, since they may have grown
+           or have been shrunk since then. They are kept as is on failure. */
+        constantsMem_.resize(constantsMemSize_);
+        integersMem_.resize(integersMemSize_);
+        floatsMem_.resize(floatsMemSize_);
 
-        std::memset(constantsMem_.address(), 0, CONSTANTS_MEM_SIZE);
+        constantsHeader_ = static_cast<struct memHeader *>(constantsMem_.address());
+        std::memset(constantsMem_.address(), 0, constantsMem_.size_);
         constantsHeader_->startNameSection = sizeof(struct memHeader);
         constantsHeader_->nextFreeNameOffset = sizeof(struct memHeader);
-        constantsHeader_->startDataSection = CONSTANTS_MEM_SIZE; // Set to the end, because it make no sense for constants to have a data section.
-        constantsHeader_->nextFreeDataOffset = CONSTANTS_MEM_SIZE;
+        constantsHeader_->startDataSection = constantsMem_.size_; // Set to the end, because it make no sense for constants to have a data section.
+        constantsHeader_->nextFreeDataOffset = constantsMem_.size_;
         constantsHeader_->isRegisteringAvailable = true;
 
-        std::memset(integersMem_.address(),  0, INTEGERS_MEM_SIZE);
+        integersHeader_ = static_cast<struct memHeader *>(integersMem_.address());
+        std::memset(integersMem_.address(), 0, integersMem_.size_);
         integersHeader_->startNameSection = sizeof(struct memHeader);
         integersHeader_->nextFreeNameOffset = sizeof(struct memHeader);
-        integersHeader_->startDataSection = INTEGERS_MEM_SIZE / 2U;
-        integersHeader_->nextFreeDataOffset = INTEGERS_MEM_SIZE / 2U;
+        integersHeader_->startDataSection = alignSection(integersMem_.size_ / 2U);
+        integersHeader_->nextFreeDataOffset = integersHeader_->startDataSection;
         integersHeader_->isRegisteringAvailable = true;
 
-        std::memset(floatsMem_.address(),    0, FLOATS_MEM_SIZE);
+        floatsHeader_ = static_cast<struct memHeader *>(floatsMem_.address());
+        std::memset(floatsMem_.address(), 0, floatsMem_.size_);
         floatsHeader_->startNameSection = sizeof(struct memHeader);
         floatsHeader_->nextFreeNameOffset = sizeof(struct memHeader);
-        floatsHeader_->startDataSection = FLOATS_MEM_SIZE / 2U;
-        floatsHeader_->nextFreeDataOffset = FLOATS_MEM_SIZE / 2U;
+        floatsHeader_->startDataSection = alignSection(floatsMem_.size_ / 2U);
+        floatsHeader_->nextFreeDataOffset = floatsHeader_->startDataSection;
         floatsHeader_->isRegisteringAvailable = true;
     }
 
+    hresult_t TelemetryData::reserve(std::size_t const & constantsMemSize,
+                                     std::size_t const & integersMemSize,
+                                     std::size_t const & floatsMemSize)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (!constantsHeader_->isRegisteringAvailable)
+        {
+            std::cout << "Error - TelemetryData::reserve - Registration is locked." << std::endl;
+            returnCode = hresult_t::ERROR_GENERIC;
+        }
+
+        // Grow the sections of a memory to the requested capacities, if larger
+        auto reserveMemory = [this](struct memHeader       * & header,
+                                    int64_t          const   & nameCapacity,
+                                    int64_t          const   & dataCapacity) -> hresult_t
+        {
+            int64_t const nameCapacityOld = header->startDataSection - header->startNameSection;
+            int64_t const dataCapacityOld = static_cast<int64_t>(getMemory(header).size_) - header->startDataSection;
+            if (nameCapacity <= nameCapacityOld && dataCapacity <= dataCapacityOld)
+            {
+                return hresult_t::SUCCESS;
+            }
+            return resizeMemory(header,
+                                std::max(nameCapacity, nameCapacityOld),
+                                std::max(dataCapacity, dataCapacityOld));
+        };
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            // The memory must be large enough to hold at least its header in each half
+            std::size_t const memSizeMin = 2U * static_cast<std::size_t>(alignSection(sizeof(struct memHeader)));
+            constantsMemSize_ = std::max(static_cast<std::size_t>(alignSection(constantsMemSize)), memSizeMin);
+            integersMemSize_ = std::max(static_cast<std::size_t>(alignSection(integersMemSize)), memSizeMin);
+            floatsMemSize_ = std::max(static_cast<std::size_t>(alignSection(floatsMemSize)), memSizeMin);
+
+            returnCode = reserveMemory(constantsHeader_,
+                                       static_cast<int64_t>(constantsMemSize_) - constantsHeader_->startNameSection,
+                                       0);
+        }
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = reserveMemory(integersHeader_,
+                                       static_cast<int64_t>(integersMemSize_ / 2U) - integersHeader_->startNameSection,
+                                       static_cast<int64_t>(integersMemSize_ - integersMemSize_ / 2U));
+        }
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = reserveMemory(floatsHeader_,
+                                       static_cast<int64_t>(floatsMemSize_ / 2U) - floatsHeader_->startNameSection,
+                                       static_cast<int64_t>(floatsMemSize_ - floatsMemSize_ / 2U));
+        }
+
+        return returnCode;
+    }
+
+    hresult_t TelemetryData::registerGroup(std::string              const & groupName,
+                                           uint32_t                 const & decimation,
+                                           std::vector<std::string> const & fieldnames)
+    {
+        if (decimation < 1U)
+        {
+            std::cout << "Error - TelemetryData::registerGroup - The decimation must be strictly positive." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        auto groupIt = std::find_if(groups_.begin(), groups_.end(),
+                                    [&groupName](auto const & group)
+                                    {
+                                        return group.name == groupName;
+                                    });
+        if (groupIt != groups_.end())
+        {
+            std::cout << "Error - TelemetryData::registerGroup - A group with this name was already registered." << std::endl;
+            return hresult_t::ERROR_BAD_INPUT;
+        }
+
+        groups_.push_back({groupName, decimation, fieldnames, {}, {}});
+
+        return hresult_t::SUCCESS;
+    }
+
+    void TelemetryData::removeGroups(void)
+    {
+        groups_.clear();
+    }
+
+    std::vector<telemetryGroup_t> const & TelemetryData::getGroups(void) const
+    {
+        return groups_;
+    }
+
     template<>
-    hresult_t TelemetryData::registerVariable<int32_t>(std::string const   & variableName,
-                                                       int32_t           * & positionInBufferOut)
+    hresult_t TelemetryData::registerVariable<int32_t>(std::string const & variableName,
+                                                       int32_t           & positionInBufferOut)
     {
-        return internalRegisterVariable(integersHeader_, variableName, positionInBufferOut);
+        return internalRegisterVariable<int32_t>(integersHeader_, variableName, positionInBufferOut);
     }
 
     template<>
-    hresult_t TelemetryData::registerVariable<float32_t>(std::string const   & variableName,
-                                                         float32_t         * & positionInBufferOut)
+    hresult_t TelemetryData::registerVariable<float32_t>(std::string const & variableName,
+                                                         int32_t           & positionInBufferOut)
     {
-        return internalRegisterVariable(floatsHeader_, variableName, positionInBufferOut);
+        return internalRegisterVariable<float32_t>(floatsHeader_, variableName, positionInBufferOut);
     }
 
     hresult_t TelemetryData::registerConstant(std::string const & variableNameIn,
                                               std::string const & constantValueIn)
     {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
         // Targeted shared memory.
-        struct memHeader * const header = constantsHeader_;
-        char_t * const memAddress = reinterpret_cast<char_t *>(header);
+        struct memHeader * & header = constantsHeader_;
 
         if (!header->isRegisteringAvailable)
         {
@@ -86,57 +204,226 @@ namespace jiminy
         }
 
         std::string const fullConstant = variableNameIn + "=" + constantValueIn;
-        if ((header->nextFreeNameOffset + static_cast<int64_t>(fullConstant.size()) + 1) >= header->startDataSection)
+        if (findEntry(header, fullConstant) != -1)
         {
-            std::cout << "Error - TelemetryData::registerConstant - Maximum number of registration exceeded." << std::endl;
+            std::cout << "Error - TelemetryData::registerConstant - A constant with this name was already registered." << std::endl;
             return hresult_t::ERROR_GENERIC;
         }
 
-        if (findEntry(header, fullConstant) != -1)
+        // Grow the memory if necessary. The header is updated accordingly.
+        returnCode = reserveEntry(header, static_cast<int64_t>(fullConstant.size()) + 1, 0);
+
+        if (returnCode == hresult_t::SUCCESS)
         {
-            std::cout << "Error - TelemetryData::registerConstant - A constant with this name was already registered." << std::endl;
-            return hresult_t::ERROR_GENERIC;
+            char_t * const memAddress = reinterpret_cast<char_t *>(header);
+            char_t * const namePos = memAddress + header->nextFreeNameOffset; // Compute record address
+            memcpy(namePos, fullConstant.data(), fullConstant.size());
+            namePos[fullConstant.size()] = '\0';
+            header->nextFreeNameOffset += fullConstant.size();
+            header->nextFreeNameOffset += 1U; // Null-terminated.
+            addEntry(header, fullConstant);
+        }
+
+        return returnCode;
+    }
+
+    hresult_t TelemetryData::reserveEntry(struct memHeader       * & header,
+                                          int64_t          const   & nameSize,
+                                          int64_t          const   & dataSize)
+    {
+        int64_t const nameSizeUsed = header->nextFreeNameOffset - header->startNameSection;
+        int64_t const dataSizeUsed = header->nextFreeDataOffset - header->startDataSection;
+        int64_t nameCapacity = header->startDataSection - header->startNameSection;
+        int64_t dataCapacity = static_cast<int64_t>(getMemory(header).size_) - header->startDataSection;
+
+        // Nothing to do if there is enough space left
+        if (nameSizeUsed + nameSize <= nameCapacity && dataSizeUsed + dataSize <= dataCapacity)
+        {
+            return hresult_t::SUCCESS;
         }
 
-        char_t * const namePos = memAddress + header->nextFreeNameOffset; // Compute record address
-        memcpy(namePos, fullConstant.data(), fullConstant.size());
-        header->nextFreeNameOffset += fullConstant.size();
-        header->nextFreeNameOffset += 1U; // Null-terminated.
+        // Double the capacity of the sections that are too small
+        while (nameSizeUsed + nameSize > nameCapacity)
+        {
+            nameCapacity = std::max(2 * nameCapacity, alignSection(nameSize));
+        }
+        while (dataSizeUsed + dataSize > dataCapacity)
+        {
+            dataCapacity = std::max(2 * dataCapacity, alignSection(dataSize));
+        }
 
-        return hresult_t::SUCCESS;;
+        return resizeMemory(header, nameCapacity, dataCapacity);
     }
 
-    int32_t TelemetryData::findEntry(struct memHeader        * header,
-                                     std::string       const & name)
+    hresult_t TelemetryData::resizeMemory(struct memHeader       * & header,
+                                          int64_t          const   & nameCapacity,
+                                          int64_t          const   & dataCapacity)
     {
-        char_t * const memAddress = reinterpret_cast<char_t *>(header);
+        MemoryBuffer & memory = getMemory(header);
+
+        int64_t const dataSizeUsed = header->nextFreeDataOffset - header->startDataSection;
+        int64_t const startDataSectionOld = header->startDataSection;
+        int64_t const startDataSection = alignSection(header->startNameSection + nameCapacity);
 
-        int32_t position = 0;
-        int64_t currentPos = header->startNameSection;
-        while (currentPos < header->nextFreeNameOffset)
+        /* Move the data section backward before reallocating, otherwise it
+           may be truncated. The memory is still consistent on failure. */
+        if (startDataSection < startDataSectionOld)
         {
-            std::string const entry(memAddress + currentPos);
-            if (entry == name)
+            char_t * const memAddress = reinterpret_cast<char_t *>(header);
+            memmove(memAddress + startDataSection, memAddress + startDataSectionOld, dataSizeUsed);
+            header->startDataSection = startDataSection;
+            header->nextFreeDataOffset = startDataSection + dataSizeUsed;
+        }
+
+        hresult_t returnCode = memory.resize(startDataSection + dataCapacity);
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            // Update the header, since the memory may have been moved
+            header = static_cast<struct memHeader *>(memory.address());
+
+            // Move the data section forward once the memory is large enough
+            if (startDataSection > startDataSectionOld)
             {
-                return position;
+                char_t * const memAddress = reinterpret_cast<char_t *>(header);
+                memmove(memAddress + startDataSection, memAddress + startDataSectionOld, dataSizeUsed);
+                header->startDataSection = startDataSection;
+                header->nextFreeDataOffset = startDataSection + dataSizeUsed;
             }
+        }
+
+        return returnCode;
+    }
 
-            currentPos += entry.size();
-            currentPos += 1U; // Null-terminated
+    MemoryBuffer & TelemetryData::getMemory(struct memHeader * header)
+    {
+        if (header == constantsHeader_)
+        {
+            return constantsMem_;
+        }
+        else if (header == integersHeader_)
+        {
+            return integersMem_;
+        }
+        return floatsMem_;
+    }
 
-            position++;
+    std::unordered_map<std::string, int32_t> & TelemetryData::getEntriesIndex(struct memHeader * header)
+    {
+        if (header == constantsHeader_)
+        {
+            return constantsIndex_;
         }
+        else if (header == integersHeader_)
+        {
+            return integersIndex_;
+        }
+        return floatsIndex_;
+    }
 
+    int32_t TelemetryData::findEntry(struct memHeader        * header,
+                                     std::string       const & name)
+    {
+        std::unordered_map<std::string, int32_t> const & entriesIndex = getEntriesIndex(header);
+        auto const entryIt = entriesIndex.find(name);
+        if (entryIt != entriesIndex.end())
+        {
+            return entryIt->second;
+        }
         return -1;
     }
 
-    void TelemetryData::formatHeader(std::vector<char_t> & header) const
+    int32_t TelemetryData::addEntry(struct memHeader       * header,
+                                    std::string      const & name)
     {
+        // The entries are never removed, so that the position is the number of entries
+        std::unordered_map<std::string, int32_t> & entriesIndex = getEntriesIndex(header);
+        int32_t const position = static_cast<int32_t>(entriesIndex.size());
+        entriesIndex.emplace(name, position);
+        return position;
+    }
+
+    void TelemetryData::formatHeader(std::vector<char_t> & header)
+    {
+        // Resolve the variables of the rate groups, unless it has already been done
+        if (constantsHeader_->isRegisteringAvailable)
+        {
+            for (telemetryGroup_t & group : groups_)
+            {
+                group.integersPositions.clear();
+                group.floatsPositions.clear();
+            }
+
+            // Each variable belongs to the first group matching its name, if any
+            auto assignToGroup = [this](std::unordered_map<std::string, int32_t> const & entriesIndex,
+                                        std::vector<int32_t> telemetryGroup_t::* positions)
+            {
+                for (auto const & entry : entriesIndex)
+                {
+                    for (telemetryGroup_t & group : groups_)
+                    {
+                        bool_t const isInGroup = std::any_of(group.fieldnames.begin(), group.fieldnames.end(),
+                            [&entry](std::string const & fieldname)
+                            {
+                                return entry.first.compare(0, fieldname.size(), fieldname) == 0;
+                            });
+                        if (isInGroup)
+                        {
+                            (group.*positions).push_back(entry.second);
+                            break;
+                        }
+                    }
+                }
+            };
+            assignToGroup(integersIndex_, &telemetryGroup_t::integersPositions);
+            assignToGroup(floatsIndex_, &telemetryGroup_t::floatsPositions);
+
+            // Record the description of the groups as constants, so that the log can be parsed
+            auto joinPositions = [](std::vector<int32_t> const & positions) -> std::string
+            {
+                std::string positionsStr;
+                for (int32_t const & position : positions)
+                {
+                    if (!positionsStr.empty())
+                    {
+                        positionsStr += ",";
+                    }
+                    positionsStr += std::to_string(position);
+                }
+                return positionsStr;
+            };
+
+            for (uint32_t i = 0; i < groups_.size(); ++i)
+            {
+                telemetryGroup_t & group = groups_[i];
+                std::sort(group.integersPositions.begin(), group.integersPositions.end());
+                std::sort(group.floatsPositions.begin(), group.floatsPositions.end());
+
+                std::string const groupPrefix = RATE_GROUP + std::to_string(i) + TELEMETRY_DELIMITER;
+                registerConstant(groupPrefix + "Name", group.name);
+                registerConstant(groupPrefix + "Decimation", std::to_string(group.decimation));
+                registerConstant(groupPrefix + "Integers", joinPositions(group.integersPositions));
+                registerConstant(groupPrefix + "Floats", joinPositions(group.floatsPositions));
+            }
+        }
+
         // Lock registering.
         constantsHeader_->isRegisteringAvailable = false;
         integersHeader_->isRegisteringAvailable = false;
         floatsHeader_->isRegisteringAvailable = false;
 
+        /* Shrink the memories to fit the registered entries exactly, since they
+           cannot change anymore. They are kept as is on failure, which is fine. */
+        resizeMemory(constantsHeader_,
+                     constantsHeader_->nextFreeNameOffset - constantsHeader_->startNameSection,
+                     0);
+        resizeMemory(integersHeader_,
+                     integersHeader_->nextFreeNameOffset - integersHeader_->startNameSection,
+                     integersHeader_->nextFreeDataOffset - integersHeader_->startDataSection);
+        resizeMemory(floatsHeader_,
+                     floatsHeader_->nextFreeNameOffset - floatsHeader_->startNameSection,
+                     floatsHeader_->nextFreeDataOffset - floatsHeader_->startDataSection);
+
         header.clear();
         header.reserve(64 * 1024);
 
@@ -5,8 +5,10 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <math.h>
+#include <algorithm>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 
 #include "jiminy/core/io/FileDevice.h"
 #include "jiminy/core/telemetry/TelemetryData.h"
@@ -22,13 +24,20 @@ namespace jiminy
     isInitialized_(false),
     recordedBytesLimits_(0),
     recordedBytesDataLine_(0),
+    recordedBytesLineMax_(0),
     recordedBytes_(0),
     headerSize_(0),
+    recordedBytesMax_(0),
     integersAddress_(),
     integerSectionSize_(0),
     floatsAddress_(),
     floatSectionSize_(0),
-    timeLoggingPrecision_(0.0)
+    timeLoggingPrecision_(0.0),
+    groups_(),
+    groupsCounters_(),
+    integersPositions_(),
+    floatsPositions_(),
+    lineBuffer_()
     {
         // Empty on purpose
     }
@@ -42,7 +51,8 @@ namespace jiminy
     }
 
     hresult_t TelemetryRecorder::initialize(TelemetryData       * telemetryData,
-                                            float64_t     const & timeLoggingPrecision)
+                                            float64_t     const & timeLoggingPrecision,
+                                            int64_t       const & recordedBytesMax)
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
@@ -60,18 +70,68 @@ namespace jiminy
         {
             // Clear the MemoryDevice buffer
             flows_.clear();
+            recordedBytesMax_ = std::max(recordedBytesMax, int64_t(0));
 
-            // Get telemetry data infos
+            // Get the header
+            telemetryData->formatHeader(header);
+            headerSize_ = header.size();
+
+            /* Get telemetry data infos.
+               It must be done after formatting the header since the memory
+               is shrunk to fit the data when locking the registration. */
             telemetryData->getData(integersAddress_,
                                    integerSectionSize_,
                                    floatsAddress_,
                                    floatSectionSize_);
             recordedBytesDataLine_ = integerSectionSize_ + floatSectionSize_
                                    + static_cast<int64_t>(START_LINE_TOKEN.size() + sizeof(uint32_t));
-
-            // Get the header
-            telemetryData->formatHeader(header);
-            headerSize_ = header.size();
+            recordedBytesLineMax_ = recordedBytesDataLine_;
+
+            // Get the rate groups, if any, and the variables recorded at every snapshot
+            groups_ = telemetryData->getGroups();
+            groupsCounters_.assign(groups_.size(), 0U);
+            integersPositions_.clear();
+            floatsPositions_.clear();
+            if (!groups_.empty())
+            {
+                std::vector<bool_t> isIntegerInGroup(integerSectionSize_ / sizeof(int32_t), false);
+                std::vector<bool_t> isFloatInGroup(floatSectionSize_ / sizeof(float32_t), false);
+                for (telemetryGroup_t const & group : groups_)
+                {
+                    for (int32_t const & position : group.integersPositions)
+                    {
+                        isIntegerInGroup[position] = true;
+                    }
+                    for (int32_t const & position : group.floatsPositions)
+                    {
+                        isFloatInGroup[position] = true;
+                    }
+                    int64_t const recordedBytesGroupLine = static_cast<int64_t>(
+                        START_GROUP_LINE_TOKEN.size() + 2U * sizeof(int32_t)
+                        + group.integersPositions.size() * sizeof(int32_t)
+                        + group.floatsPositions.size() * sizeof(float32_t));
+                    recordedBytesLineMax_ = std::max(recordedBytesLineMax_, recordedBytesGroupLine);
+                }
+                for (uint32_t i = 0; i < isIntegerInGroup.size(); ++i)
+                {
+                    if (!isIntegerInGroup[i])
+                    {
+                        integersPositions_.push_back(static_cast<int32_t>(i));
+                    }
+                }
+                for (uint32_t i = 0; i < isFloatInGroup.size(); ++i)
+                {
+                    if (!isFloatInGroup[i])
+                    {
+                        floatsPositions_.push_back(static_cast<int32_t>(i));
+                    }
+                }
+                recordedBytesDataLine_ = static_cast<int64_t>(
+                    START_LINE_TOKEN.size() + sizeof(uint32_t)
+                    + integersPositions_.size() * sizeof(int32_t)
+                    + floatsPositions_.size() * sizeof(float32_t));
+            }
+            lineBuffer_.resize(recordedBytesLineMax_);
 
             // Create a new MemoryDevice and open it
             returnCode = createNewChunk();
@@ -92,6 +152,58 @@ namespace jiminy
         return returnCode;
     }
 
+    hresult_t TelemetryRecorder::restart(void)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
+
+        if (isInitialized_)
+        {
+            std::cout << "Error - TelemetryRecorder::restart - TelemetryRecorder already initialized." << std::endl;
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (returnCode == hresult_t::SUCCESS && flows_.empty())
+        {
+            std::cout << "Error - TelemetryRecorder::restart - TelemetryRecorder never initialized." << std::endl;
+            returnCode = hresult_t::ERROR_INIT_FAILED;
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            // Only keep the first chunk, which starts with the header
+            flows_.erase(flows_.begin() + 1, flows_.end());
+
+            /* Clear the data previously recorded without reallocating the memory, since
+               it must be filled with zeros for the end of the data to be detected. */
+            MemoryDevice & flow = flows_.front();
+            int64_t const chunkSize = flow.size();
+            flow.resize(headerSize_);
+            flow.resize(chunkSize);
+
+            // Move the cursor right after the header
+            if (flow.isOpen())
+            {
+                flow.close();
+            }
+            returnCode = flow.open(OpenMode::READ_WRITE);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            returnCode = flows_.front().seek(headerSize_);
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            recordedBytesLimits_ = flows_.front().size();
+            recordedBytes_ = headerSize_;
+            std::fill(groupsCounters_.begin(), groupsCounters_.end(), 0U);
+            isInitialized_ = true;
+        }
+
+        return returnCode;
+    }
+
     float64_t TelemetryRecorder::getMaximumLogTime(void) const
     {
         return std::numeric_limits<int32_t>::max() / timeLoggingPrecision_;
@@ -123,17 +235,50 @@ namespace jiminy
             flows_.back().close();
         }
 
-        /* Create a new chunk.
-           The size of the first chunk is chosen to be large enough
-           to contain the whole header (with constants). Doing this
-           does not really affect the performances since it is written
-           only once, at init of the simulation. The optimized buffer
-           size is used for the log data. */
         uint32_t isHeaderThere = flows_.empty();
-        uint32_t maxBufferSize = std::max(TELEMETRY_MAX_BUFFER_SIZE, isHeaderThere * headerSize_);
-        uint32_t maxRecordedDataLines = ((maxBufferSize - isHeaderThere * headerSize_) / recordedBytesDataLine_);
-        recordedBytesLimits_ = isHeaderThere * headerSize_ + maxRecordedDataLines * recordedBytesDataLine_;
-        flows_.emplace_back(recordedBytesLimits_);
+        if (recordedBytesMax_ > 0)
+        {
+            /* Flight recorder mode. The header is alone in the first chunk,
+               so that it is never recycled. The memory budget is split in
+               several chunks of data, each of them holding at least one line,
+               and the oldest one is recycled once they are all full. */
+            if (isHeaderThere)
+            {
+                recordedBytesLimits_ = headerSize_;
+                flows_.emplace_back(recordedBytesLimits_);
+            }
+            else
+            {
+                int64_t const maxRecordedDataLines = std::max(
+                    recordedBytesMax_ / (TELEMETRY_FLIGHT_RECORDER_CHUNKS * recordedBytesLineMax_), int64_t(1));
+                recordedBytesLimits_ = maxRecordedDataLines * recordedBytesLineMax_;
+                if (static_cast<int64_t>(flows_.size()) > TELEMETRY_FLIGHT_RECORDER_CHUNKS)
+                {
+                    // Move the oldest chunk of data at the end and clear it, without reallocating
+                    std::rotate(flows_.begin() + 1, flows_.begin() + 2, flows_.end());
+                    flows_.back().resize(0);
+                    flows_.back().resize(recordedBytesLimits_);
+                }
+                else
+                {
+                    flows_.emplace_back(recordedBytesLimits_);
+                }
+            }
+        }
+        else
+        {
+            /* Create a new chunk.
+               The size of the first chunk is chosen to be large enough
+               to contain the whole header (with constants). Doing this
+               does not really affect the performances since it is written
+               only once, at init of the simulation. The optimized buffer
+               size is used for the log data, unless a single line is larger,
+               since the memory of the telemetry can grow on demand. */
+            uint32_t maxBufferSize = std::max(TELEMETRY_MAX_BUFFER_SIZE, isHeaderThere * headerSize_ + recordedBytesLineMax_);
+            uint32_t maxRecordedDataLines = ((maxBufferSize - isHeaderThere * headerSize_) / recordedBytesLineMax_);
+            recordedBytesLimits_ = isHeaderThere * headerSize_ + maxRecordedDataLines * recordedBytesLineMax_;
+            flows_.emplace_back(recordedBytesLimits_);
+        }
         returnCode = flows_.back().open(OpenMode::READ_WRITE);
 
         if (returnCode == hresult_t::SUCCESS)
@@ -148,27 +293,99 @@ namespace jiminy
     {
         hresult_t returnCode = hresult_t::SUCCESS;
 
-        if (recordedBytes_ == recordedBytesLimits_)
+        int32_t const time = static_cast<int32_t>(std::round(timestamp * timeLoggingPrecision_));
+
+        if (groups_.empty())
         {
-            returnCode = createNewChunk();
-        }
+            if (recordedBytes_ == recordedBytesLimits_)
+            {
+                returnCode = createNewChunk();
+            }
 
-        if (returnCode == hresult_t::SUCCESS)
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                // Write new line token
+                flows_.back().write(START_LINE_TOKEN);
+
+                // Write time
+                flows_.back().write(time);
+
+                // Write data, integers first
+                flows_.back().write(reinterpret_cast<uint8_t const*>(integersAddress_), integerSectionSize_);
+
+                // Write data, floats last
+                flows_.back().write(reinterpret_cast<uint8_t const*>(floatsAddress_), floatSectionSize_);
+
+                // Update internal counter
+                recordedBytes_ += recordedBytesDataLine_;
+            }
+        }
+        else
         {
-            // Write new line token
-            flows_.back().write(START_LINE_TOKEN);
+            /* Write the lines of the rate groups first, so that their variables
+               are up-to-date when parsing the main line of the same snapshot. */
+            for (uint32_t i = 0; i < groups_.size(); ++i)
+            {
+                if (returnCode == hresult_t::SUCCESS && groupsCounters_[i] == 0U)
+                {
+                    returnCode = writeLine(static_cast<int32_t>(i),
+                                           time,
+                                           groups_[i].integersPositions,
+                                           groups_[i].floatsPositions);
+                }
+                groupsCounters_[i] = (groupsCounters_[i] + 1U) % groups_[i].decimation;
+            }
 
-            // Write time
-            flows_.back().write(static_cast<int32_t>(std::round(timestamp * timeLoggingPrecision_)));
+            if (returnCode == hresult_t::SUCCESS)
+            {
+                returnCode = writeLine(-1, time, integersPositions_, floatsPositions_);
+            }
+        }
 
-            // Write data, integers first
-            flows_.back().write(reinterpret_cast<uint8_t const*>(integersAddress_), integerSectionSize_);
+        return returnCode;
+    }
 
-            // Write data, floats last
-            flows_.back().write(reinterpret_cast<uint8_t const*>(floatsAddress_), floatSectionSize_);
+    hresult_t TelemetryRecorder::writeLine(int32_t              const & groupIdx,
+                                           int32_t              const & time,
+                                           std::vector<int32_t> const & integersPositions,
+                                           std::vector<int32_t> const & floatsPositions)
+    {
+        hresult_t returnCode = hresult_t::SUCCESS;
 
-            // Update internal counter
-            recordedBytes_ += recordedBytesDataLine_;
+        // Gather the line in a buffer, to write it at once
+        char_t * cursor = lineBuffer_.data();
+        std::string const & lineToken = (groupIdx < 0) ? START_LINE_TOKEN : START_GROUP_LINE_TOKEN;
+        std::memcpy(cursor, lineToken.data(), lineToken.size());
+        cursor += lineToken.size();
+        if (groupIdx >= 0)
+        {
+            std::memcpy(cursor, &groupIdx, sizeof(int32_t));
+            cursor += sizeof(int32_t);
+        }
+        std::memcpy(cursor, &time, sizeof(int32_t));
+        cursor += sizeof(int32_t);
+        for (int32_t const & position : integersPositions)
+        {
+            std::memcpy(cursor, integersAddress_ + position * sizeof(int32_t), sizeof(int32_t));
+            cursor += sizeof(int32_t);
+        }
+        for (int32_t const & position : floatsPositions)
+        {
+            std::memcpy(cursor, floatsAddress_ + position * sizeof(float32_t), sizeof(float32_t));
+            cursor += sizeof(float32_t);
+        }
+        int64_t const recordedBytesLine = cursor - lineBuffer_.data();
+
+        // The remaining of the current chunk is left empty if the line does not fit
+        if (recordedBytes_ + recordedBytesLine > recordedBytesLimits_)
+        {
+            returnCode = createNewChunk();
+        }
+
+        if (returnCode == hresult_t::SUCCESS)
+        {
+            flows_.back().write(reinterpret_cast<uint8_t const*>(lineBuffer_.data()), recordedBytesLine);
+            recordedBytes_ += recordedBytesLine;
         }
 
         return returnCode;
@@ -226,6 +443,31 @@ namespace jiminy
             std::vector<float32_t> floatDataLine;
             floatDataLine.resize(floatSectionSize / sizeof(float32_t));
 
+            /* Positions of the variables of each rate group, and of the ones recorded
+               in the main lines. The latter are only used if there is any group. */
+            std::vector<std::vector<int32_t> > groupsIntegersPositions;
+            std::vector<std::vector<int32_t> > groupsFloatsPositions;
+            std::vector<int32_t> integersPositions;
+            std::vector<int32_t> floatsPositions;
+
+            // Read a given number of variables and scatter them in the current data line
+            std::vector<int32_t> intDataBuffer;
+            std::vector<float32_t> floatDataBuffer;
+            auto readScattered = [](AbstractIODevice           * flow,
+                                    std::vector<int32_t> const & positions,
+                                    auto                       & dataBuffer,
+                                    auto                       & dataLine)
+            {
+                dataBuffer.resize(positions.size());
+                flow->readData(dataBuffer.data(), dataBuffer.size() * sizeof(dataBuffer[0]));
+                for (uint32_t i = 0; i < positions.size(); ++i)
+                {
+                    dataLine[positions[i]] = dataBuffer[i];
+                }
+            };
+
+            std::vector<char_t> lineToken(START_LINE_TOKEN.size());
+
             bool_t isReadingHeaderDone = false;
             for (auto & flow : flows)
             {
@@ -261,6 +503,76 @@ namespace jiminy
                         }
                     }
                     isReadingHeaderDone = true;
+
+                    // Extract the positions of the variables of the rate groups, if any
+                    auto const lastConstantIt = std::find(header.begin(), header.end(), START_COLUMNS);
+                    for (auto constantIt = header.begin() ; constantIt != lastConstantIt ; constantIt++)
+                    {
+                        if (constantIt->compare(0, RATE_GROUP.size(), RATE_GROUP) != 0)
+                        {
+                            continue;
+                        }
+                        std::size_t const delimiter = constantIt->find("=");
+                        std::size_t const fieldDelimiter = constantIt->find(TELEMETRY_DELIMITER, RATE_GROUP.size());
+                        if (delimiter == std::string::npos || fieldDelimiter > delimiter)
+                        {
+                            continue;
+                        }
+                        uint32_t const groupIdx = std::stoul(
+                            constantIt->substr(RATE_GROUP.size(), fieldDelimiter - RATE_GROUP.size()));
+                        std::string const field = constantIt->substr(
+                            fieldDelimiter + 1, delimiter - fieldDelimiter - 1);
+                        if (groupIdx >= groupsIntegersPositions.size())
+                        {
+                            groupsIntegersPositions.resize(groupIdx + 1);
+                            groupsFloatsPositions.resize(groupIdx + 1);
+                        }
+
+                        if (field != "Integers" && field != "Floats")
+                        {
+                            continue;
+                        }
+                        std::vector<int32_t> & positions = (field == "Integers") ?
+                            groupsIntegersPositions[groupIdx] : groupsFloatsPositions[groupIdx];
+                        std::istringstream positionsStream(constantIt->substr(delimiter + 1));
+                        std::string position;
+                        while (std::getline(positionsStream, position, ','))
+                        {
+                            positions.push_back(std::stoi(position));
+                        }
+                    }
+
+                    // Deduce the variables recorded in the main lines
+                    if (!groupsIntegersPositions.empty())
+                    {
+                        std::vector<bool_t> isIntegerInGroup(intDataLine.size(), false);
+                        std::vector<bool_t> isFloatInGroup(floatDataLine.size(), false);
+                        for (uint32_t i = 0; i < groupsIntegersPositions.size(); ++i)
+                        {
+                            for (int32_t const & position : groupsIntegersPositions[i])
+                            {
+                                isIntegerInGroup[position] = true;
+                            }
+                            for (int32_t const & position : groupsFloatsPositions[i])
+                            {
+                                isFloatInGroup[position] = true;
+                            }
+                        }
+                        for (uint32_t i = 0; i < isIntegerInGroup.size(); ++i)
+                        {
+                            if (!isIntegerInGroup[i])
+                            {
+                                integersPositions.push_back(static_cast<int32_t>(i));
+                            }
+                        }
+                        for (uint32_t i = 0; i < isFloatInGroup.size(); ++i)
+                        {
+                            if (!isFloatInGroup[i])
+                            {
+                                floatsPositions.push_back(static_cast<int32_t>(i));
+                            }
+                        }
+                    }
                 }
 
                 // In header, look for timeUnit constant - if not found, use default time unit.
@@ -287,10 +599,41 @@ namespace jiminy
 
                 while (flow->bytesAvailable() > 0)
                 {
-                    flow->seek(flow->pos() + START_LINE_TOKEN.size()); // Skip new line flag
+                    flow->readData(lineToken.data(), lineToken.size());
+
+                    // Update the variables of a rate group, holding their value until the next record
+                    if (std::equal(lineToken.begin(), lineToken.end(), START_GROUP_LINE_TOKEN.begin()))
+                    {
+                        int32_t groupIdx;
+                        flow->readData(&groupIdx, sizeof(int32_t));
+                        flow->readData(&timestamp, sizeof(int32_t));
+                        if (groupIdx < 0 || groupIdx >= static_cast<int32_t>(groupsIntegersPositions.size()))
+                        {
+                            // The log is corrupted, must stop reading !
+                            break;
+                        }
+                        readScattered(flow, groupsIntegersPositions[groupIdx], intDataBuffer, intDataLine);
+                        readScattered(flow, groupsFloatsPositions[groupIdx], floatDataBuffer, floatDataLine);
+                        continue;
+                    }
+
+                    if (!std::equal(lineToken.begin(), lineToken.end(), START_LINE_TOKEN.begin()))
+                    {
+                        // The remaining of the buffer is empty, must stop reading !
+                        break;
+                    }
+
                     flow->readData(&timestamp, sizeof(int32_t));
-                    flow->readData(intDataLine.data(), integerSectionSize);
-                    flow->readData(floatDataLine.data(), floatSectionSize);
+                    if (groupsIntegersPositions.empty())
+                    {
+                        flow->readData(intDataLine.data(), integerSectionSize);
+                        flow->readData(floatDataLine.data(), floatSectionSize);
+                    }
+                    else
+                    {
+                        readScattered(flow, integersPositions, intDataBuffer, intDataLine);
+                        readScattered(flow, floatsPositions, floatDataBuffer, floatDataLine);
+                    }
 
                     if (!timestamps.empty() && timestamp == 0)
                     {
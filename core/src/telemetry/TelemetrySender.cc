@@ -34,8 +34,9 @@ namespace jiminy
             return;
         }
 
-        // Write the value directly in the buffer holder using the pointer stored in the map.
-        *(it->second) = value;
+        /* Write the value directly in the buffer holder using the position stored in the map.
+           The address of the buffer is not cached since it may change while registering. */
+        telemetryData_->getDataSection<int32_t>()[it->second] = value;
     }
 
     template <>
@@ -49,8 +50,9 @@ namespace jiminy
             return;
         }
 
-        // Write the value directly in the buffer holder using the pointer stored in the map.
-        *(it->second) = static_cast<float32_t>(value);
+        /* Write the value directly in the buffer holder using the position stored in the map.
+           The address of the buffer is not cached since it may change while registering. */
+        telemetryData_->getDataSection<float32_t>()[it->second] = static_cast<float32_t>(value);
     }
 
     void TelemetrySender::updateValue(std::vector<std::string>    const & fieldnames,
@@ -66,10 +68,10 @@ namespace jiminy
     hresult_t TelemetrySender::registerVariable<int32_t>(std::string const & fieldNameIn,
                                                          int32_t     const & initialValue)
     {
-        int32_t * positionInBuffer = nullptr;
+        int32_t positionInBuffer = -1;
         std::string const fullFieldName = objectName_ + TELEMETRY_DELIMITER + fieldNameIn;
 
-        hresult_t returnCode = telemetryData_->registerVariable(fullFieldName, positionInBuffer);
+        hresult_t returnCode = telemetryData_->registerVariable<int32_t>(fullFieldName, positionInBuffer);
         if (returnCode == hresult_t::SUCCESS)
         {
             intBufferPosition_[fieldNameIn] = positionInBuffer;
@@ -83,10 +85,10 @@ namespace jiminy
     hresult_t TelemetrySender::registerVariable<float64_t>(std::string const & fieldNameIn,
                                                            float64_t   const & initialValue)
     {
-        float32_t * positionInBuffer = nullptr;
+        int32_t positionInBuffer = -1;
         std::string const fullFieldName = objectName_ + TELEMETRY_DELIMITER + fieldNameIn;
 
-        hresult_t returnCode = telemetryData_->registerVariable(fullFieldName, positionInBuffer);
+        hresult_t returnCode = telemetryData_->registerVariable<float32_t>(fullFieldName, positionInBuffer);
         if (returnCode == hresult_t::SUCCESS)
         {
             floatBufferPosition_[fieldNameIn] = positionInBuffer;
@@ -135,4 +137,9 @@ namespace jiminy
     {
         return objectName_;
     }
+
+    std::shared_ptr<TelemetryData> const & TelemetrySender::getTelemetryData(void) const
+    {
+        return telemetryData_;
+    }
 } // End of namespace jiminy.
@@ -268,7 +268,8 @@ class EngineAsynchronous:
         @return     State of the robot
         """
         if (self._state is None):
-            x = self._engine.stepper_state.x
+            # Discard the internal state of the motors, if any
+            x = self._engine.stepper_state.x[:self.robot.nx]
             if self.robot.is_flexible and self.use_theoretical_model:
                 self._state = self.robot.get_rigid_state_from_flexible(x)
             else:
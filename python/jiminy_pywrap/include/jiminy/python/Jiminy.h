@@ -589,6 +589,9 @@ namespace python
                                                   bp::return_value_policy<bp::copy_const_reference>()))
                     .add_property("rotor_inertia", bp::make_function(&AbstractMotorBase::getRotorInertia,
                                                    bp::return_value_policy<bp::copy_const_reference>()))
+                    .add_property("state_size", &AbstractMotorBase::getStateSize)
+                    .add_property("state_idx", bp::make_function(&AbstractMotorBase::getStateIdx,
+                                               bp::return_value_policy<bp::copy_const_reference>()))
                     ;
             }
 
@@ -645,6 +648,11 @@ namespace python
                        std::shared_ptr<SimpleMotor>,
                        boost::noncopyable>("SimpleMotor", bp::init<std::string>())
                 .def(PyMotorVisitor());
+
+            bp::class_<DcMotor, bp::bases<AbstractMotorBase>,
+                       std::shared_ptr<DcMotor>,
+                       boost::noncopyable>("DcMotor", bp::init<std::string>())
+                .def(PyMotorVisitor());
         }
     };
 
@@ -883,13 +891,20 @@ namespace python
                                                       (bp::arg("self"), "rigid_state"))
                 .def("get_rigid_state_from_flexible", &PyModelVisitor::getRigidStateFromFlexible,
                                                       (bp::arg("self"), "flexible_state"))
+                .def("get_full_position_from_rigid", &PyModelVisitor::getFullPositionFromRigid,
+                                                     (bp::arg("self"), "rigid_position"))
+                .def("sample_models_biased", &Model::sampleModelsBiased,
+                                             (bp::arg("self"), "n_models"))
+                .add_property("n_models_biased_pending", &Model::getModelsBiasedPendingCount)
 
                 .add_property("pinocchio_model", bp::make_getter(&Model::pncModel_,
                                                  bp::return_internal_reference<>()))
-                .add_property("pinocchio_data", bp::make_getter(&Model::pncData_,
+                .add_property("pinocchio_data", bp::make_function(&PyModelVisitor::getPinocchioData,
                                                 bp::return_internal_reference<>()))
-                .add_property("pinocchio_model_th", bp::make_getter(&Model::pncModelRigidOrig_,
+                .add_property("pinocchio_model_th", bp::make_function(&PyModelVisitor::getPinocchioModelTh,
                                                     bp::return_internal_reference<>()))
+                .add_property("pinocchio_model_full", bp::make_function(&PyModelVisitor::getPinocchioModelFull,
+                                                      bp::return_internal_reference<>()))
                 .add_property("pinocchio_data_th", bp::make_getter(&Model::pncDataRigidOrig_,
                                                    bp::return_internal_reference<>()))
 
@@ -970,6 +985,14 @@ namespace python
             return xRigid;
         }
 
+        static vectorN_t getFullPositionFromRigid(Model           & self,
+                                                  vectorN_t const & qRigid)
+        {
+            vectorN_t qFull;
+            self.getFullPositionFromRigid(qRigid, qFull);
+            return qFull;
+        }
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief      Getters and Setters
         ///////////////////////////////////////////////////////////////////////////////
@@ -979,6 +1002,23 @@ namespace python
             return self.mdlOptions_->dynamics.enableFlexibleModel;
         }
 
+        static pinocchio::Data & getPinocchioData(Model & self)
+        {
+            // Only the frames used by the simulation are up-to-date in the middle of a step
+            self.flushKinematicsFrames();
+            return self.pncData_;
+        }
+
+        static pinocchio::Model const & getPinocchioModelTh(Model & self)
+        {
+            return *self.pncModelRigidOrig_;
+        }
+
+        static pinocchio::Model const & getPinocchioModelFull(Model & self)
+        {
+            return *self.pncModelFull_;
+        }
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief Expose.
         ///////////////////////////////////////////////////////////////////////////////
@@ -1052,6 +1092,10 @@ namespace python
                                               (bp::arg("self"), "telemetry_options"))
                 .def("get_telemetry_options", &Robot::getTelemetryOptions)
 
+                .def("dump_to_binary", &PyRobotVisitor::dumpToBinary)
+                .def("load_from_binary", &PyRobotVisitor::loadFromBinary,
+                                         (bp::arg("self"), "data"))
+
                 .add_property("nmotors", bp::make_function(&Robot::nmotors,
                                          bp::return_value_policy<bp::copy_const_reference>()))
                 .add_property("motors_names", bp::make_function(&Robot::getMotorsNames,
@@ -1106,6 +1150,7 @@ namespace python
 
         static std::shared_ptr<sensorsDataMap_t> getSensorsData(Robot & self)
         {
+            self.flushSensorsData();
             return std::make_shared<sensorsDataMap_t>(self.getSensorsData());
         }
 
@@ -1161,6 +1206,53 @@ namespace python
             self.setTelemetryOptions(config);
         }
 
+        static bp::object dumpToBinary(Robot const & self)
+        {
+            std::string data;
+            if (self.dumpToBinary(data) != hresult_t::SUCCESS)
+            {
+                throw std::runtime_error("Impossible to serialize the robot.");
+            }
+            return bp::object(bp::handle<>(PyBytes_FromStringAndSize(
+                data.c_str(), static_cast<Py_ssize_t>(data.size()))));
+        }
+
+        static hresult_t loadFromBinary(Robot            & self,
+                                        bp::object const & dataPy)
+        {
+            char * dataPtr;
+            Py_ssize_t dataSize;
+            if (PyBytes_AsStringAndSize(dataPy.ptr(), &dataPtr, &dataSize) < 0)
+            {
+                bp::throw_error_already_set();
+            }
+            return self.loadFromBinary(std::string(dataPtr, static_cast<std::size_t>(dataSize)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        /// \brief Pickle support, so that fully configured robots can be sent to
+        ///        worker processes without accessing the filesystem.
+        ///////////////////////////////////////////////////////////////////////////////
+        struct PyRobotPickleSuite : public bp::pickle_suite
+        {
+            static bp::tuple getstate(Robot const & self)
+            {
+                return bp::make_tuple(dumpToBinary(self));
+            }
+
+            static void setstate(Robot & self, bp::tuple state)
+            {
+                if (bp::len(state) != 1)
+                {
+                    throw std::runtime_error("Invalid state, impossible to unpickle the robot.");
+                }
+                if (loadFromBinary(self, state[0]) != hresult_t::SUCCESS)
+                {
+                    throw std::runtime_error("Impossible to unpickle the robot.");
+                }
+            }
+        };
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief Expose.
         ///////////////////////////////////////////////////////////////////////////////
@@ -1169,7 +1261,8 @@ namespace python
             bp::class_<Robot, bp::bases<Model>,
                        std::shared_ptr<Robot>,
                        boost::noncopyable>("Robot")
-                .def(PyRobotVisitor());
+                .def(PyRobotVisitor())
+                .def_pickle(PyRobotPickleSuite());
         }
     };
 
@@ -1457,6 +1550,10 @@ namespace python
                                             bp::return_value_policy<bp::copy_non_const_reference>()))
                 .add_property("f_external", bp::make_getter(&systemState_t::fExternal,
                                             bp::return_value_policy<bp::copy_non_const_reference>()))
+                .add_property("x_motor", bp::make_getter(&systemState_t::xMotor,
+                                         bp::return_value_policy<bp::copy_non_const_reference>()))
+                .add_property("x_motor_dot", bp::make_getter(&systemState_t::xMotorDot,
+                                             bp::return_value_policy<bp::copy_non_const_reference>()))
                 ;
         }
 
@@ -1493,6 +1590,8 @@ namespace python
                                             bp::return_internal_reference<>()))
                 .add_property("callbackFct", bp::make_getter(&systemDataHolder_t::callbackFct,
                                              bp::return_internal_reference<>()))
+                .add_property("is_kinematic", bp::make_getter(&systemDataHolder_t::isKinematic,
+                                              bp::return_value_policy<bp::copy_non_const_reference>()))
                 ;
         }
 
@@ -1529,6 +1628,9 @@ namespace python
                 .def("add_system", &PyEngineMultiRobotVisitor::addSystemWithCallback,
                                    (bp::arg("self"), "system_name",
                                     "robot", "controller", "callback_function"))
+                .def("add_kinematic_system", &EngineMultiRobot::addKinematicSystem,
+                                             (bp::arg("self"), "system_name",
+                                              "robot", "times", "positions"))
                 .def("remove_system", &EngineMultiRobot::removeSystem,
                                       (bp::arg("self"), "system_name"))
                 .def("add_coupling_force", &PyEngineMultiRobotVisitor::addCouplingForce,
@@ -1536,6 +1638,12 @@ namespace python
                                             "system_name_1", "system_name_2",
                                             "frame_name_1", "frame_name_2",
                                             "force_function"))
+                .def("add_coupling_force", &PyEngineMultiRobotVisitor::addCouplingForceNative,
+                                           (bp::arg("self"),
+                                            "system_name_1", "system_name_2",
+                                            "frame_name_1", "frame_name_2",
+                                            "stiffness", "damping", "rest_length",
+                                            bp::arg("is_tether") = false))
                 .def("remove_coupling_forces",
                     static_cast<
                         hresult_t (EngineMultiRobot::*)(std::string const &, std::string const &)
@@ -1546,6 +1654,10 @@ namespace python
                         hresult_t (EngineMultiRobot::*)(std::string const &)
                     >(&EngineMultiRobot::removeCouplingForces),
                     (bp::arg("self"), "system_name"))
+                .def("add_interaction_frame", &EngineMultiRobot::addInteractionFrame,
+                                              (bp::arg("self"), "system_name", "frame_name"))
+                .def("remove_interaction_frames", &EngineMultiRobot::removeInteractionFrames,
+                                                  (bp::arg("self"), "system_name"))
 
                 .def("reset",
                     static_cast<
@@ -1574,8 +1686,25 @@ namespace python
                                                 "frame_name", "t", "dt", "F"))
                 .def("register_force_profile", &PyEngineMultiRobotVisitor::registerForceProfile,
                                                (bp::arg("self"), "system_name",
-                                                "frame_name", "force_function"))
+                                                "frame_name", "force_function",
+                                                bp::arg("update_period") = 0.0))
+                .def("register_force_profile", &PyEngineMultiRobotVisitor::registerForceProfileConstant,
+                                               (bp::arg("self"), "system_name",
+                                                "frame_name", "offset"))
+                .def("register_force_profile", &PyEngineMultiRobotVisitor::registerForceProfileSinusoidal,
+                                               (bp::arg("self"), "system_name",
+                                                "frame_name", "offset", "amplitude",
+                                                bp::arg("frequency") = 0.0,
+                                                bp::arg("phase") = 0.0))
                 .def("remove_forces", &PyEngineMultiRobotVisitor::removeForces)
+                .def("register_timed_event", &PyEngineMultiRobotVisitor::registerTimedEvent,
+                                             (bp::arg("self"), "t", "event_function",
+                                              bp::arg("period") = 0.0))
+                .def("remove_timed_events", &EngineMultiRobot::removeTimedEvents)
+                .def("register_telemetry_group", &PyEngineMultiRobotVisitor::registerTelemetryGroup,
+                                                 (bp::arg("self"), "group_name",
+                                                  "decimation", "fieldnames"))
+                .def("remove_telemetry_groups", &EngineMultiRobot::removeTelemetryGroups)
 
                 .def("get_options", &EngineMultiRobot::getOptions,
                                     bp::return_value_policy<bp::return_by_value>())
@@ -1666,6 +1795,20 @@ namespace python
                 systemName1, systemName2, frameName1, frameName2, forceFct);
         }
 
+        static hresult_t addCouplingForceNative(EngineMultiRobot       & self,
+                                                std::string      const & systemName1,
+                                                std::string      const & systemName2,
+                                                std::string      const & frameName1,
+                                                std::string      const & frameName2,
+                                                float64_t        const & stiffness,
+                                                float64_t        const & damping,
+                                                float64_t        const & restLength,
+                                                bool_t           const & isTether)
+        {
+            return self.addCouplingForce(systemName1, systemName2, frameName1, frameName2,
+                                         stiffness, damping, restLength, isTether);
+        }
+
         static hresult_t start(EngineMultiRobot       & self,
                                bp::object       const & xInit,
                                bool             const & resetRandomGenerator,
@@ -1715,13 +1858,47 @@ namespace python
             self.registerForceImpulse(systemName, frameName, t, dt, pinocchio::Force(F));
         }
 
-        static void registerForceProfile(EngineMultiRobot       & self,
-                                         std::string      const & systemName,
-                                         std::string      const & frameName,
-                                         bp::object       const & forcePy)
+        static hresult_t registerForceProfile(EngineMultiRobot       & self,
+                                              std::string      const & systemName,
+                                              std::string      const & frameName,
+                                              bp::object       const & forcePy,
+                                              float64_t        const & updatePeriod)
         {
             TimeStateRefFctPyWrapper<pinocchio::Force> forceFct(forcePy);
-            self.registerForceProfile(systemName, frameName, std::move(forceFct));
+            return self.registerForceProfile(systemName, frameName, std::move(forceFct), updatePeriod);
+        }
+
+        static void registerForceProfileConstant(EngineMultiRobot       & self,
+                                                 std::string      const & systemName,
+                                                 std::string      const & frameName,
+                                                 vector6_t        const & offset)
+        {
+            self.registerForceProfile(systemName, frameName, pinocchio::Force(offset));
+        }
+
+        static void registerForceProfileSinusoidal(EngineMultiRobot       & self,
+                                                   std::string      const & systemName,
+                                                   std::string      const & frameName,
+                                                   vector6_t        const & offset,
+                                                   vector6_t        const & amplitude,
+                                                   float64_t        const & frequency,
+                                                   float64_t        const & phase)
+        {
+            self.registerForceProfile(systemName, frameName, pinocchio::Force(offset),
+                                      pinocchio::Force(amplitude), frequency, phase);
+        }
+
+        static hresult_t registerTimedEvent(EngineMultiRobot       & self,
+                                            float64_t        const & t,
+                                            bp::object       const & eventPy,
+                                            float64_t        const & period)
+        {
+            timedEventFunctor_t eventFct =
+                [eventPy](float64_t const & tIn)
+                {
+                    eventPy(tIn);
+                };
+            return self.registerTimedEvent(t, std::move(eventFct), period);
         }
 
         static void removeForces(Engine & self)
@@ -1729,6 +1906,15 @@ namespace python
             self.reset(true);
         }
 
+        static hresult_t registerTelemetryGroup(EngineMultiRobot       & self,
+                                                std::string      const & groupName,
+                                                uint32_t         const & decimation,
+                                                bp::list         const & fieldnamesPy)
+        {
+            auto fieldnames = convertFromPython<std::vector<std::string> >(fieldnamesPy);
+            return self.registerTelemetryGroup(groupName, decimation, fieldnames);
+        }
+
         ///////////////////////////////////////////////////////////////////////////////
         /// \brief      Getters and Setters
         ///////////////////////////////////////////////////////////////////////////////
@@ -1908,7 +2094,14 @@ namespace python
                 .def("register_force_impulse", &PyEngineVisitor::registerForceImpulse,
                                                (bp::arg("self"), "frame_name", "t", "dt", "F"))
                 .def("register_force_profile", &PyEngineVisitor::registerForceProfile,
-                                               (bp::arg("self"), "frame_name", "force_function"))
+                                               (bp::arg("self"), "frame_name", "force_function",
+                                                bp::arg("update_period") = 0.0))
+                .def("register_force_profile", &PyEngineVisitor::registerForceProfileConstant,
+                                               (bp::arg("self"), "frame_name", "offset"))
+                .def("register_force_profile", &PyEngineVisitor::registerForceProfileSinusoidal,
+                                               (bp::arg("self"), "frame_name", "offset", "amplitude",
+                                                bp::arg("frequency") = 0.0,
+                                                bp::arg("phase") = 0.0))
 
                 .add_property("is_initialized", bp::make_function(&Engine::getIsInitialized,
                                                 bp::return_value_policy<bp::copy_const_reference>()))
@@ -1988,12 +2181,31 @@ namespace python
             self.registerForceImpulse(frameName, t, dt, pinocchio::Force(F));
         }
 
-        static void registerForceProfile(Engine            & self,
-                                         std::string const & frameName,
-                                         bp::object  const & forcePy)
+        static hresult_t registerForceProfile(Engine            & self,
+                                              std::string const & frameName,
+                                              bp::object  const & forcePy,
+                                              float64_t   const & updatePeriod)
         {
             TimeStateRefFctPyWrapper<pinocchio::Force> forceFct(forcePy);
-            self.registerForceProfile(frameName, std::move(forceFct));
+            return self.registerForceProfile(frameName, std::move(forceFct), updatePeriod);
+        }
+
+        static void registerForceProfileConstant(Engine            & self,
+                                                 std::string const & frameName,
+                                                 vector6_t   const & offset)
+        {
+            self.registerForceProfile(frameName, pinocchio::Force(offset));
+        }
+
+        static void registerForceProfileSinusoidal(Engine            & self,
+                                                   std::string const & frameName,
+                                                   vector6_t   const & offset,
+                                                   vector6_t   const & amplitude,
+                                                   float64_t   const & frequency,
+                                                   float64_t   const & phase)
+        {
+            self.registerForceProfile(frameName, pinocchio::Force(offset),
+                                      pinocchio::Force(amplitude), frequency, phase);
         }
 
         ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+// Test the telemetry.
+// The tests in this file verify that the recorded data can be read back as they were
+// logged, whatever the layout of the telemetry and the way it is recorded.
+#include <cstdio>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "jiminy/core/telemetry/TelemetryData.h"
+#include "jiminy/core/telemetry/TelemetrySender.h"
+#include "jiminy/core/telemetry/TelemetryRecorder.h"
+#include "jiminy/core/engine/EngineMultiRobot.h"
+#include "jiminy/core/Types.h"
+
+
+using namespace jiminy;
+
+
+TEST(TelemetrySanity, FlightRecorderRoundTrip)
+{
+    // Verify that only the most recent data are kept in flight recorder mode,
+    // and that the dumped log can be parsed back.
+
+    auto telemetryData = std::make_shared<TelemetryData>();
+    telemetryData->reset();
+    TelemetrySender telemetrySender;
+    telemetrySender.configureObject(telemetryData, "Object");
+    ASSERT_EQ(telemetrySender.registerVariable("position", 0.0), hresult_t::SUCCESS);
+    ASSERT_EQ(telemetrySender.registerVariable("counter", int32_t(0)), hresult_t::SUCCESS);
+
+    // Record much more snapshots than the memory budget can hold
+    int64_t const recordedBytesMax = 4096;
+    TelemetryRecorder telemetryRecorder;
+    ASSERT_EQ(telemetryRecorder.initialize(telemetryData.get(), 1.0e6, recordedBytesMax), hresult_t::SUCCESS);
+    int32_t const numSnapshots = 100000;
+    for (int32_t i = 0; i < numSnapshots; ++i)
+    {
+        telemetrySender.updateValue("position", static_cast<float64_t>(i));
+        telemetrySender.updateValue("counter", i);
+        ASSERT_EQ(telemetryRecorder.flushDataSnapshot(1.0e-3 * i), hresult_t::SUCCESS);
+    }
+
+    // Check that only the most recent snapshots are kept, without any gap
+    std::vector<std::string> header;
+    std::vector<float64_t> timestamps;
+    std::vector<std::vector<int32_t> > intData;
+    std::vector<std::vector<float32_t> > floatData;
+    telemetryRecorder.getData(header, timestamps, intData, floatData);
+    int64_t const recordedBytesLine = START_LINE_TOKEN.size() + 3U * sizeof(int32_t);
+    ASSERT_GT(timestamps.size(), 0U);
+    ASSERT_LE(static_cast<int64_t>(timestamps.size()), recordedBytesMax / recordedBytesLine);
+    EXPECT_GT(timestamps.front(), 0.0);
+    EXPECT_EQ(intData.back()[0], numSnapshots - 1);
+    for (uint32_t i = 0; i < timestamps.size(); ++i)
+    {
+        EXPECT_EQ(intData[i][0], intData[0][0] + static_cast<int32_t>(i));
+        EXPECT_EQ(floatData[i][0], static_cast<float32_t>(intData[i][0]));
+    }
+
+    // Dump the log and parse it back
+    std::string const logPath = "flight_recorder_log.data";
+    ASSERT_EQ(telemetryRecorder.writeDataBinary(logPath), hresult_t::SUCCESS);
+    std::vector<std::string> headerParsed;
+    std::vector<float64_t> timestampsParsed;
+    std::vector<std::vector<int32_t> > intDataParsed;
+    std::vector<std::vector<float32_t> > floatDataParsed;
+    hresult_t const returnCode = EngineMultiRobot::parseLogBinaryRaw(
+        logPath, headerParsed, timestampsParsed, intDataParsed, floatDataParsed);
+    std::remove(logPath.c_str());
+    ASSERT_EQ(returnCode, hresult_t::SUCCESS);
+    EXPECT_EQ(headerParsed, header);
+    EXPECT_EQ(timestampsParsed, timestamps);
+    EXPECT_EQ(intDataParsed, intData);
+    EXPECT_EQ(floatDataParsed, floatData);
+}
+
+TEST(TelemetrySanity, BufferGrowth)
+{
+    // Verify that the telemetry memory grows on demand past its initial size,
+    // without corrupting the variables already registered.
+
+    auto telemetryData = std::make_shared<TelemetryData>();
+    telemetryData->reset();
+    TelemetrySender telemetrySender;
+    telemetrySender.configureObject(telemetryData, "Object");
+
+    // Register more variables than the default memory of the floats can hold
+    int32_t const numVariables = 4 * static_cast<int32_t>(FLOATS_MEM_SIZE / sizeof(float32_t));
+    for (int32_t i = 0; i < numVariables; ++i)
+    {
+        std::string const index = std::to_string(i);
+        ASSERT_EQ(telemetrySender.registerVariable("float_" + index, static_cast<float64_t>(i)), hresult_t::SUCCESS);
+        ASSERT_EQ(telemetrySender.registerVariable("int_" + index, i), hresult_t::SUCCESS);
+        ASSERT_EQ(telemetrySender.registerConstant("constant_" + index, index), hresult_t::SUCCESS);
+    }
+
+    // Reserving memory up front must not alter the variables already registered
+    ASSERT_EQ(telemetryData->reserve(4 * CONSTANTS_MEM_SIZE, 4 * INTEGERS_MEM_SIZE, 8 * FLOATS_MEM_SIZE), hresult_t::SUCCESS);
+
+    TelemetryRecorder telemetryRecorder;
+    ASSERT_EQ(telemetryRecorder.initialize(telemetryData.get(), 1.0e6), hresult_t::SUCCESS);
+    for (int32_t k = 0; k < 3; ++k)
+    {
+        telemetrySender.updateValue("float_0", static_cast<float64_t>(k));
+        ASSERT_EQ(telemetryRecorder.flushDataSnapshot(1.0e-3 * k), hresult_t::SUCCESS);
+    }
+
+    std::vector<std::string> header;
+    std::vector<float64_t> timestamps;
+    std::vector<std::vector<int32_t> > intData;
+    std::vector<std::vector<float32_t> > floatData;
+    telemetryRecorder.getData(header, timestamps, intData, floatData);
+    ASSERT_EQ(timestamps.size(), 3U);
+    ASSERT_EQ(intData.back().size(), static_cast<std::size_t>(numVariables));
+    ASSERT_EQ(floatData.back().size(), static_cast<std::size_t>(numVariables));
+    EXPECT_EQ(floatData.back()[0], 2.0F);
+    for (int32_t i = 1; i < numVariables; ++i)
+    {
+        EXPECT_EQ(intData.back()[i], i);
+        EXPECT_EQ(floatData.back()[i], static_cast<float32_t>(i));
+    }
+    EXPECT_NE(std::find(header.begin(), header.end(), "Object.constant_" + std::to_string(numVariables - 1) + "=" +
+                        std::to_string(numVariables - 1)), header.end());
+    EXPECT_NE(std::find(header.begin(), header.end(), "Object.float_" + std::to_string(numVariables - 1)), header.end());
+}
+
+TEST(TelemetrySanity, RateGroups)
+{
+    // Verify that the variables of a rate group are recorded once every 'decimation'
+    // snapshots, and that they hold their last recorded value when read back.
+
+    auto telemetryData = std::make_shared<TelemetryData>();
+    telemetryData->reset();
+    uint32_t const decimation = 3U;
+    ASSERT_EQ(telemetryData->registerGroup("Slow", decimation, {"Object.slow"}), hresult_t::SUCCESS);
+    TelemetrySender telemetrySender;
+    telemetrySender.configureObject(telemetryData, "Object");
+    ASSERT_EQ(telemetrySender.registerVariable("fastFloat", 0.0), hresult_t::SUCCESS);
+    ASSERT_EQ(telemetrySender.registerVariable("slowFloat", 0.0), hresult_t::SUCCESS);
+    ASSERT_EQ(telemetrySender.registerVariable("fastInt", int32_t(0)), hresult_t::SUCCESS);
+    ASSERT_EQ(telemetrySender.registerVariable("slowInt", int32_t(0)), hresult_t::SUCCESS);
+
+    TelemetryRecorder telemetryRecorder;
+    ASSERT_EQ(telemetryRecorder.initialize(telemetryData.get(), 1.0e6), hresult_t::SUCCESS);
+    int32_t const numSnapshots = 20;
+    for (int32_t i = 0; i < numSnapshots; ++i)
+    {
+        telemetrySender.updateValue("fastFloat", static_cast<float64_t>(i));
+        telemetrySender.updateValue("slowFloat", static_cast<float64_t>(-i));
+        telemetrySender.updateValue("fastInt", i);
+        telemetrySender.updateValue("slowInt", -i);
+        ASSERT_EQ(telemetryRecorder.flushDataSnapshot(1.0e-3 * i), hresult_t::SUCCESS);
+    }
+
+    // The lines of the group are merged with the main ones, holding their last recorded value
+    std::vector<std::string> header;
+    std::vector<float64_t> timestamps;
+    std::vector<std::vector<int32_t> > intData;
+    std::vector<std::vector<float32_t> > floatData;
+    telemetryRecorder.getData(header, timestamps, intData, floatData);
+    ASSERT_EQ(timestamps.size(), static_cast<std::size_t>(numSnapshots));
+    for (int32_t i = 0; i < numSnapshots; ++i)
+    {
+        int32_t const iRecorded = i - i % static_cast<int32_t>(decimation);
+        EXPECT_DOUBLE_EQ(timestamps[i], 1.0e-3 * i);
+        EXPECT_EQ(intData[i][0], i);
+        EXPECT_EQ(intData[i][1], -iRecorded);
+        EXPECT_EQ(floatData[i][0], static_cast<float32_t>(i));
+        EXPECT_EQ(floatData[i][1], static_cast<float32_t>(-iRecorded));
+    }
+
+    // The same data must be read back from the log file
+    std::string const logPath = "rate_groups_log.data";
+    ASSERT_EQ(telemetryRecorder.writeDataBinary(logPath), hresult_t::SUCCESS);
+    std::vector<std::string> headerParsed;
+    std::vector<float64_t> timestampsParsed;
+    std::vector<std::vector<int32_t> > intDataParsed;
+    std::vector<std::vector<float32_t> > floatDataParsed;
+    hresult_t const returnCode = EngineMultiRobot::parseLogBinaryRaw(
+        logPath, headerParsed, timestampsParsed, intDataParsed, floatDataParsed);
+    std::remove(logPath.c_str());
+    ASSERT_EQ(returnCode, hresult_t::SUCCESS);
+    EXPECT_EQ(timestampsParsed, timestamps);
+    EXPECT_EQ(intDataParsed, intData);
+    EXPECT_EQ(floatDataParsed, floatData);
+}
+
+TEST(TelemetrySanity, EntriesIndex)
+{
+    // Verify that registering an entry again gives back its position instead of adding it,
+    // and that registering a constant twice is rejected, before and after resetting.
+
+    auto telemetryData = std::make_shared<TelemetryData>();
+    telemetryData->reset();
+
+    // The positions are given in order of registration, separately for each type
+    int32_t const numVariables = 2 * static_cast<int32_t>(FLOATS_MEM_SIZE / sizeof(float32_t));
+    for (int32_t i = 0; i < numVariables; ++i)
+    {
+        std::string const index = std::to_string(i);
+        int32_t floatPosition = -1;
+        int32_t intPosition = -1;
+        ASSERT_EQ(telemetryData->registerVariable<float32_t>("float_" + index, floatPosition), hresult_t::SUCCESS);
+        ASSERT_EQ(telemetryData->registerVariable<int32_t>("int_" + index, intPosition), hresult_t::SUCCESS);
+        EXPECT_EQ(floatPosition, i);
+        EXPECT_EQ(intPosition, i);
+    }
+
+    // Registering a variable again gives back its position, even once the registration is locked
+    std::vector<char_t> header;
+    for (bool_t const isLocked : {false, true})
+    {
+        if (isLocked)
+        {
+            telemetryData->formatHeader(header);
+        }
+        for (int32_t i : {0, numVariables / 2, numVariables - 1})
+        {
+            std::string const index = std::to_string(i);
+            int32_t floatPosition = -1;
+            int32_t intPosition = -1;
+            ASSERT_EQ(telemetryData->registerVariable<float32_t>("float_" + index, floatPosition), hresult_t::SUCCESS);
+            ASSERT_EQ(telemetryData->registerVariable<int32_t>("int_" + index, intPosition), hresult_t::SUCCESS);
+            EXPECT_EQ(floatPosition, i);
+            EXPECT_EQ(intPosition, i);
+        }
+    }
+    int32_t position = -1;
+    EXPECT_NE(telemetryData->registerVariable<float32_t>("float_new", position), hresult_t::SUCCESS);
+
+    // The entries are forgotten when resetting, and the same constant cannot be registered twice
+    telemetryData->reset();
+    ASSERT_EQ(telemetryData->registerVariable<float32_t>("float_1", position), hresult_t::SUCCESS);
+    EXPECT_EQ(position, 0);
+    ASSERT_EQ(telemetryData->registerConstant("constant", "value"), hresult_t::SUCCESS);
+    EXPECT_NE(telemetryData->registerConstant("constant", "value"), hresult_t::SUCCESS);
+
+    // The constant only appears once in the header
+    telemetryData->formatHeader(header);
+    std::string const headerStr(header.begin(), header.end());
+    std::size_t const constantPos = headerStr.find("constant=value");
+    ASSERT_NE(constantPos, std::string::npos);
+    EXPECT_EQ(headerStr.find("constant=value", constantPos + 1), std::string::npos);
+}
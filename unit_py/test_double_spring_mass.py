@@ -4,6 +4,7 @@ import unittest
 import numpy as np
 from scipy.linalg import expm
 
+import pinocchio as pin
 from jiminy_py import core as jiminy
 
 from utilities import load_urdf_default, integrate_dynamics
@@ -391,5 +392,138 @@ class SimulateTwoMasses(unittest.TestCase):
         x_python = integrate_dynamics(time, x0, system_dynamics)
         self.assertTrue(np.allclose(x_jiminy_extract, x_python, atol=TOLERANCE))
 
+    def test_constrained_dynamics(self):
+        """
+        @brief Test the constrained acceleration against the solution of the dense KKT
+               system, for redundant constraints on a freeflyer that is not at identity.
+        """
+        # Rebuild the model with a freeflyer.
+        self.robot = load_urdf_default(self.urdf_path, self.motor_names, has_freeflyer = True)
+
+        def compute_command(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[6:] = - self.k * q[7:] - self.nu * v[6:]
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+
+        # Hold both the freeflyer and the second mass in place, as if they were in contact
+        frame_names = ["world", "SecondMass"]
+        for frame_name in frame_names:
+            self.robot.add_constraint(frame_name, jiminy.FixedFrameConstraint(frame_name))
+
+        # Initialize with zero freeflyer velocity and a "random" (but fixed) quaternion
+        x_init = np.zeros(17)
+        x_init[7:9] = self.x0[:2]
+        x_init[-2:] = self.x0[2:]
+        np.random.seed(42)
+        x_init[:7] = np.random.rand(7)
+        x_init[3:7] /= np.linalg.norm(x_init[3:7])
+
+        # Compare the acceleration after each step with the solution of the KKT system
+        pnc_model = self.robot.pinocchio_model
+        pnc_data = pnc_model.createData()
+        frames_idx = [pnc_model.getFrameId(frame_name) for frame_name in frame_names]
+        engine.start(x_init)
+        for _ in range(100):
+            engine.step(1.0e-2)
+            q, v, a = engine.system_state.q, engine.system_state.v, engine.system_state.a
+            u = np.zeros(pnc_model.nv)
+            internal_dynamics(0.0, q, v, None, u)
+
+            # Compute the dynamics terms, and the constraints in local frame
+            M = pin.crba(pnc_model, pnc_data, q)
+            M = np.triu(M) + np.triu(M, 1).T
+            nle = pin.nonLinearEffects(pnc_model, pnc_data, q, v)
+            pin.computeJointJacobians(pnc_model, pnc_data, q)
+            pin.forwardKinematics(pnc_model, pnc_data, q, v, np.zeros(pnc_model.nv))
+            pin.updateFramePlacements(pnc_model, pnc_data)
+            J = np.concatenate([pin.getFrameJacobian(pnc_model, pnc_data, frame_idx, pin.LOCAL)
+                                for frame_idx in frames_idx], axis=0)
+            drift = np.concatenate([pin.getFrameAcceleration(pnc_model, pnc_data, frame_idx).vector
+                                    for frame_idx in frames_idx], axis=0)
+
+            # The constraints are redundant, so the KKT matrix is singular, but not the acceleration
+            n_constraints = J.shape[0]
+            kkt_matrix = np.block([[M, J.T], [J, np.zeros((n_constraints, n_constraints))]])
+            kkt_rhs = np.concatenate((u - nle, - drift))
+            a_ref = np.linalg.lstsq(kkt_matrix, kkt_rhs, rcond=None)[0][:pnc_model.nv]
+            self.assertTrue(np.allclose(a, a_ref, atol=1e-6))
+
+        engine.stop()
+
+    def test_locked_joint(self):
+        """
+        @brief Test simulation of this system with the second joint locked, which merges
+               both masses into a single one held by the first spring.
+        """
+        # Lock the second joint before attaching the motors, since it is removed from the model
+        robot = jiminy.Robot()
+        robot.initialize(self.urdf_path)
+        model_options = robot.get_model_options()
+        model_options["joints"]["enablePositionLimit"] = False
+        model_options["joints"]["enableVelocityLimit"] = False
+        model_options["joints"]["lockedJointsNames"] = ["SecondJoint"]
+        robot.set_model_options(model_options)
+        motor = jiminy.SimpleMotor("FirstJoint")
+        robot.attach_motor(motor)
+        motor.initialize("FirstJoint")
+        motor_options = robot.get_motors_options()
+        motor_options["FirstJoint"]['enableEffortLimit'] = False
+        motor_options["FirstJoint"]['enableRotorInertia'] = False
+        robot.set_motors_options(motor_options)
+
+        # Only the first joint remains
+        self.assertEqual(robot.pinocchio_model.nq, 1)
+        self.assertEqual(robot.pinocchio_model_full.nq, 2)
+
+        # Invalid locked joints are rejected, without altering the options nor the model
+        model_options = robot.get_model_options()
+        for locked_joints_names, locked_joints_positions in (
+                (["FirstJoint"], [np.zeros(2)]),
+                (["FirstJoint", "SecondJoint"], [np.zeros(1)]),
+                (["SecondJoint", "SecondJoint"], [])):
+            model_options_invalid = robot.get_model_options()
+            model_options_invalid["joints"]["lockedJointsNames"] = locked_joints_names
+            model_options_invalid["joints"]["lockedJointsPositions"] = locked_joints_positions
+            robot.set_model_options(model_options_invalid)
+            self.assertEqual(robot.get_model_options()["joints"]["lockedJointsNames"],
+                             model_options["joints"]["lockedJointsNames"])
+            self.assertEqual(len(robot.get_model_options()["joints"]["lockedJointsPositions"]), 0)
+            self.assertEqual(robot.pinocchio_model.nq, 1)
+
+        def compute_command(t, q, v, sensor_data, u):
+            u[:] = - self.k[0] * q
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(robot)
+        engine = jiminy.Engine()
+        engine.initialize(robot, controller)
+
+        # Run simulation
+        x0 = np.array([0.1, 0.0])
+        engine.simulate(self.tf, x0)
+
+        log_data, _ = engine.get_log()
+        time = log_data['Global.Time']
+        x_jiminy = np.stack([log_data['HighLevelController.' + s]
+                             for s in robot.logfile_position_headers + \
+                                      robot.logfile_velocity_headers], axis=-1)
+
+        # Analytical solution: a single mass, summing both masses, on a spring
+        m = sum(robot.pinocchio_model_full.inertias[i].mass for i in range(1, 3))
+        A = np.array([[              0, 1],
+                      [-self.k[0] / m, 0]])
+        x_analytical = np.stack([expm(A * t).dot(x0) for t in time], axis=0)
+
+        self.assertTrue(np.allclose(x_jiminy, x_analytical, atol=TOLERANCE))
+
 if __name__ == '__main__':
     unittest.main()
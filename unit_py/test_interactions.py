@@ -0,0 +1,220 @@
+# This file aims at verifying the sanity of the forces applied between several
+# systems without any explicit coupling.
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+# Small tolerance for numerical equality.
+# The integration error is supposed to be bounded.
+TOLERANCE = 1e-7
+
+
+class SimulateInteractions(unittest.TestCase):
+    def setUp(self):
+        self.system_names = ['FirstSystem', 'SecondSystem']
+
+    def _create_engine(self, urdf_path):
+        engine = jiminy.EngineMultiRobot()
+        robots = []
+        for system_name in self.system_names:
+            robot = jiminy.Robot()
+            robot.initialize(urdf_path, has_freeflyer=True)
+            engine.add_system(system_name, robot)
+            robots.append(robot)
+
+        # Turn off gravity
+        engine_options = engine.get_options()
+        engine_options["world"]["gravity"] = np.zeros(6)
+        engine.set_options(engine_options)
+
+        return engine, robots
+
+    def _get_positions_x(self, engine, robots):
+        # Extract the position and velocity of both systems along x-axis
+        log_data, _ = engine.get_log()
+        time = log_data['Global.Time']
+        pos = np.stack([log_data['.'.join(('HighLevelController', system_name,
+                                           robot.logfile_position_headers[0]))]
+                        for system_name, robot in zip(self.system_names, robots)], axis=-1)
+        vel = np.stack([log_data['.'.join(('HighLevelController', system_name,
+                                           robot.logfile_velocity_headers[0]))]
+                        for system_name, robot in zip(self.system_names, robots)], axis=-1)
+        return time, pos, vel
+
+    def test_interaction_forces(self):
+        """
+        @brief Verify that two point masses closer than the cutoff radius attract each
+               other beyond the rest length, conserving the momentum, and that farther
+               ones do not interact at all.
+        """
+        engine, robots = self._create_engine("data/point_mass.urdf")
+        for system_name in self.system_names:
+            engine.add_interaction_frame(system_name, "MassBody")
+
+        engine_options = engine.get_options()
+        engine_options["interactions"]["stiffness"] = 10.0
+        engine_options["interactions"]["damping"] = 0.0
+        engine_options["interactions"]["restLength"] = 0.3
+        engine_options["interactions"]["cutoffRadius"] = 1.0
+        engine.set_options(engine_options)
+
+        def get_initial_state(pos_x):
+            x0 = np.zeros(13)
+            x0[0] = pos_x
+            x0[6] = 1.0 # [TX,TY,TZ],[QX,QY,QZ,QW]
+            return x0
+
+        # Both masses are initially at rest, farther than the rest length
+        dist_init = 0.5
+        x0 = {'FirstSystem': get_initial_state(-dist_init / 2),
+              'SecondSystem': get_initial_state(dist_init / 2)}
+        tf = 2.0
+        engine.simulate(tf, x0)
+        _, pos, vel = self._get_positions_x(engine, robots)
+
+        # The momentum is conserved, since the masses are equal.
+        # A specific tolerance is used because of the limited precision of the log.
+        TOLERANCE_log = 1e-6
+        self.assertTrue(np.allclose(vel[:, 0] + vel[:, 1], 0.0, atol=TOLERANCE_log))
+
+        # The masses get closer, without ever getting farther than initially
+        dist = pos[:, 1] - pos[:, 0]
+        self.assertTrue(np.min(dist) < dist_init - 0.1)
+        self.assertTrue(np.all(dist < dist_init + TOLERANCE_log))
+
+        # No force is applied beyond the cutoff radius
+        dist_init = 1.5
+        x0 = {'FirstSystem': get_initial_state(-dist_init / 2),
+              'SecondSystem': get_initial_state(dist_init / 2)}
+        engine.simulate(tf, x0)
+        _, pos, vel = self._get_positions_x(engine, robots)
+        self.assertTrue(np.allclose(vel, 0.0, atol=TOLERANCE))
+
+    def test_collision_ground(self):
+        """
+        @brief Verify that a sphere dropped on the ground ends up at rest on it, at the
+               equilibrium depth of the contact model.
+        """
+        engine, robots = self._create_engine("data/sphere.urdf")
+
+        k_contact = 1.0e6
+        engine_options = engine.get_options()
+        engine_options["world"]["gravity"][2] = -9.81
+        engine_options["contacts"]["stiffness"] = k_contact
+        engine_options["contacts"]["damping"] = 2.0e3
+        engine_options["contacts"]["transitionEps"] = 1.0 / k_contact
+        engine_options["collisions"]["enableGround"] = True
+        engine.set_options(engine_options)
+
+        # Drop both spheres from different heights, far from each other
+        x0 = {}
+        for i, system_name in enumerate(self.system_names):
+            x0[system_name] = np.zeros(13)
+            x0[system_name][[0, 2, 6]] = [2.0 * i, 0.5 + 0.5 * i, 1.0]
+        tf = 2.0
+        engine.simulate(tf, x0)
+
+        # Compare the numerical and analytical equilibrium state
+        log_data, _ = engine.get_log()
+        radius = 0.1
+        mass = robots[0].pinocchio_model.inertias[-1].mass
+        for system_name, robot in zip(self.system_names, robots):
+            pos_z = log_data['.'.join(('HighLevelController', system_name,
+                                       robot.logfile_position_headers[2]))]
+            vel_z = log_data['.'.join(('HighLevelController', system_name,
+                                       robot.logfile_velocity_headers[2]))]
+            self.assertTrue(np.allclose(pos_z[-1], radius - mass * 9.81 / k_contact, atol=TOLERANCE))
+            self.assertTrue(np.allclose(vel_z[-1], 0.0, atol=1e-5))
+
+    def test_collision_systems(self):
+        """
+        @brief Verify that two spheres of different systems bounce on each other instead of
+               going through each other, conserving the momentum.
+        """
+        engine, robots = self._create_engine("data/sphere.urdf")
+
+        k_contact = 1.0e6
+        engine_options = engine.get_options()
+        engine_options["contacts"]["stiffness"] = k_contact
+        engine_options["contacts"]["damping"] = 2.0e2 # Under-damped contact, so that the spheres bounce
+        engine_options["contacts"]["transitionEps"] = 1.0 / k_contact
+        engine_options["collisions"]["enableSystems"] = True
+        engine.set_options(engine_options)
+
+        # The first sphere is thrown at the second one, initially at rest
+        x0 = {}
+        for i, system_name in enumerate(self.system_names):
+            x0[system_name] = np.zeros(13)
+            x0[system_name][[0, 6]] = [0.5 * i, 1.0]
+        x0['FirstSystem'][7] = 1.0
+        tf = 1.0
+        engine.simulate(tf, x0)
+        _, pos, vel = self._get_positions_x(engine, robots)
+
+        # The spheres never go through each other
+        radius = 0.1
+        dist = pos[:, 1] - pos[:, 0]
+        self.assertTrue(np.all(dist > radius))
+
+        # The momentum is conserved, and the second sphere has been pushed away
+        TOLERANCE_log = 1e-6
+        self.assertTrue(np.allclose(vel[:, 0] + vel[:, 1], 1.0, atol=TOLERANCE_log))
+        self.assertTrue(vel[-1, 1] > vel[-1, 0])
+        self.assertTrue(dist[-1] > 2.0 * radius)
+
+    def test_collision_sphere_box(self):
+        """
+        @brief Verify that a sphere thrown down on a box bounces on it instead of going
+               through it, whatever the order of the bodies along the sweep axis.
+        """
+        radius, half_size = 0.1, 0.05
+        # The box is first along x-axis if the sphere is shifted, since it is smaller
+        for offset_x in (0.0, 0.8 * half_size):
+            engine = jiminy.EngineMultiRobot()
+            robots = []
+            for system_name, urdf_path in zip(self.system_names,
+                                              ("data/sphere.urdf", "data/box.urdf")):
+                robot = jiminy.Robot()
+                robot.initialize(urdf_path, has_freeflyer=True)
+                engine.add_system(system_name, robot)
+                robots.append(robot)
+
+            k_contact = 1.0e6
+            engine_options = engine.get_options()
+            engine_options["world"]["gravity"] = np.zeros(6)
+            engine_options["contacts"]["stiffness"] = k_contact
+            engine_options["contacts"]["damping"] = 2.0e2
+            engine_options["contacts"]["transitionEps"] = 1.0 / k_contact
+            engine_options["collisions"]["enableSystems"] = True
+            engine.set_options(engine_options)
+
+            # The sphere is thrown down at the box, initially at rest
+            x0 = {}
+            for system_name in self.system_names:
+                x0[system_name] = np.zeros(13)
+                x0[system_name][6] = 1.0
+            x0['FirstSystem'][[0, 2, 9]] = [offset_x, 0.3, -1.0]
+            tf = 1.0
+            engine.simulate(tf, x0)
+
+            log_data, _ = engine.get_log()
+            pos_z = np.stack([log_data['.'.join(('HighLevelController', system_name,
+                                                 robot.logfile_position_headers[2]))]
+                              for system_name, robot in zip(self.system_names, robots)], axis=-1)
+            vel_z = np.stack([log_data['.'.join(('HighLevelController', system_name,
+                                                 robot.logfile_velocity_headers[2]))]
+                              for system_name, robot in zip(self.system_names, robots)], axis=-1)
+
+            # The sphere never goes through the box
+            dist = pos_z[:, 0] - pos_z[:, 1]
+            self.assertTrue(np.all(dist > radius + half_size - 1e-2))
+
+            # The momentum is conserved, and the box has been pushed away
+            TOLERANCE_log = 1e-6
+            self.assertTrue(np.allclose(vel_z[:, 0] + vel_z[:, 1], -1.0, atol=TOLERANCE_log))
+            self.assertTrue(vel_z[-1, 1] < vel_z[-1, 0])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,106 @@
+# This file aims at verifying that the kinematics of the robot seen by the user is
+# always consistent with the current state, despite the caching done by the engine.
+import unittest
+import numpy as np
+
+import pinocchio as pin
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class KinematicsCache(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+
+    def _get_frames_placement(self, q):
+        """
+        @brief Compute the placement of every frame from scratch for a given configuration.
+        """
+        pnc_model = self.robot.pinocchio_model
+        pnc_data = pnc_model.createData()
+        pin.framesForwardKinematics(pnc_model, pnc_data, q)
+        return [oMf.homogeneous for oMf in pnc_data.oMf]
+
+    def test_frames_up_to_date(self):
+        """
+        @brief Verify that the placement of every frame is up-to-date when read by the
+               controller and after each step, for discrete and continuous control.
+        """
+        errors = []
+        def compute_command(t, q, v, sensor_data, u):
+            oMf_ref = self._get_frames_placement(q)
+            for oMf, oMf_ref_i in zip(self.robot.pinocchio_data.oMf, oMf_ref):
+                errors.append(np.max(np.abs(oMf.homogeneous - oMf_ref_i)))
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+
+        x0 = np.array([0.1, 0.0])
+        for controller_update_period in (0.0, 1.0e-2):
+            engine_options = engine.get_options()
+            engine_options["stepper"]["controllerUpdatePeriod"] = controller_update_period
+            engine.set_options(engine_options)
+
+            # Check the frames after each step
+            engine.start(x0)
+            for _ in range(100):
+                engine.step(1.0e-2)
+                q = engine.system_state.q
+                oMf_ref = self._get_frames_placement(q)
+                for oMf, oMf_ref_i in zip(self.robot.pinocchio_data.oMf, oMf_ref):
+                    self.assertTrue(np.allclose(oMf.homogeneous, oMf_ref_i, atol=TOLERANCE))
+            engine.stop()
+
+        # Check the frames read by the controller
+        self.assertTrue(len(errors) > 0)
+        self.assertTrue(np.max(errors) < TOLERANCE)
+
+    def test_frames_after_lazy_sensors(self):
+        """
+        @brief Verify that evaluating the sensors whose update has been deferred does not
+               alter the kinematics of the robot, although it is evaluated at another state.
+        """
+        encoder = jiminy.EncoderSensor("PendulumJoint")
+        self.robot.attach_sensor(encoder)
+        encoder.initialize("PendulumJoint")
+
+        # The last update of the encoder occurs strictly inside each step
+        sensors_options = self.robot.get_sensors_options()
+        sensors_options['EncoderSensor']['PendulumJoint']['updatePeriod'] = 3.0e-3
+        self.robot.set_sensors_options(sensors_options)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot)
+        engine_options = engine.get_options()
+        engine_options["stepper"]["sensorsLazyEvaluation"] = True
+        engine.set_options(engine_options)
+
+        # Check the frames after each step, and after reading the sensors
+        x0 = np.array([0.1, 0.0])
+        engine.start(x0)
+        for _ in range(100):
+            engine.step(1.0e-2)
+            q = engine.system_state.q
+            oMf_ref = self._get_frames_placement(q)
+            for _ in range(2):
+                for oMf, oMf_ref_i in zip(self.robot.pinocchio_data.oMf, oMf_ref):
+                    self.assertTrue(np.allclose(oMf.homogeneous, oMf_ref_i, atol=TOLERANCE))
+                self.robot.sensors_data
+        engine.stop()
+
+
+if __name__ == '__main__':
+    unittest.main()
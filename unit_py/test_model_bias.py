@@ -0,0 +1,132 @@
+# This file aims at verifying that the random biases of the dynamics of the model
+# are applied and removed consistently, without altering the rest of the model.
+import unittest
+import numpy as np
+
+import pinocchio as pin
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class ModelBias(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+
+        self.engine = jiminy.Engine()
+        self.engine.initialize(self.robot)
+
+        self.x0 = np.array([0.1, 0.0])
+        self.tf = 1.0
+
+    def _set_bias_std(self, std):
+        model_options = self.robot.get_model_options()
+        for field in ("massBodiesBiasStd", "centerOfMassPositionBodiesBiasStd",
+                      "relativePositionBodiesBiasStd"):
+            model_options["dynamics"][field] = std
+        self.robot.set_model_options(model_options)
+
+    def _set_flexible(self, enable_flexible_model):
+        model_options = self.robot.get_model_options()
+        model_options["dynamics"]["enableFlexibleModel"] = enable_flexible_model
+        model_options["dynamics"]["flexibilityConfig"] = [{'jointName': "PendulumJoint",
+                                                           'stiffness': 20.0 * np.ones(3),
+                                                           'damping': 0.1 * np.ones(3)}]
+        self.robot.set_model_options(model_options)
+
+    def _get_dynamics_properties(self):
+        pnc_model = self.robot.pinocchio_model
+        return (np.array([inertia.mass for inertia in pnc_model.inertias]),
+                np.stack([inertia.lever for inertia in pnc_model.inertias], axis=0),
+                np.stack([placement.translation for placement in pnc_model.jointPlacements], axis=0))
+
+    def _get_proxies(self):
+        return (self.robot.nq, self.robot.nv,
+                list(self.robot.rigid_joints_position_idx),
+                list(self.robot.rigid_joints_velocity_idx),
+                self.robot.position_limit_lower.copy(),
+                self.robot.position_limit_upper.copy(),
+                self.robot.velocity_limit.copy(),
+                list(self.robot.logfile_position_headers),
+                list(self.robot.logfile_velocity_headers))
+
+    def _assert_proxies_equal(self, proxies, proxies_ref):
+        self.assertEqual(len(proxies), len(proxies_ref))
+        for value, value_ref in zip(proxies, proxies_ref):
+            if isinstance(value, np.ndarray):
+                self.assertTrue(np.array_equal(value, value_ref))
+            else:
+                self.assertEqual(value, value_ref)
+
+    def _assert_kinematics_consistent(self):
+        # The data of the robot must be consistent with its current, possibly biased, model
+        pnc_model = self.robot.pinocchio_model
+        pnc_data = pnc_model.createData()
+        pin.framesForwardKinematics(pnc_model, pnc_data, self.engine.system_state.q)
+        for oMf, oMf_ref in zip(self.robot.pinocchio_data.oMf, pnc_data.oMf):
+            self.assertTrue(np.allclose(oMf.homogeneous, oMf_ref.homogeneous, atol=TOLERANCE))
+
+    def _simulate(self, is_state_theoretical=False):
+        self.engine.simulate(self.tf, self.x0, is_state_theoretical)
+        log_data, _ = self.engine.get_log()
+        return log_data
+
+    def test_bias_applied_and_restored(self):
+        """
+        @brief Verify that the biased model differs from the nominal one, that the nominal
+               model is restored once the biases are disabled, and that the proxies of the
+               model are up-to-date whether its structure changes or not.
+        """
+        # Nominal simulation
+        log_data_ref = self._simulate()
+        properties_ref = self._get_dynamics_properties()
+        proxies_ref = self._get_proxies()
+
+        # The dynamics properties are biased, and differ from one simulation to the next
+        self._set_bias_std(0.05)
+        log_data = self._simulate()
+        properties_biased = self._get_dynamics_properties()
+        for value, value_ref in zip(properties_biased, properties_ref):
+            self.assertFalse(np.allclose(value, value_ref))
+        self.assertFalse(np.allclose(log_data['HighLevelController.' + self.robot.logfile_position_headers[0]],
+                                     log_data_ref['HighLevelController.' + self.robot.logfile_position_headers[0]]))
+        self._assert_proxies_equal(self._get_proxies(), proxies_ref)
+        self._assert_kinematics_consistent()
+
+        self._simulate()
+        for value, value_prev in zip(self._get_dynamics_properties(), properties_biased):
+            self.assertFalse(np.allclose(value, value_prev))
+        self._assert_proxies_equal(self._get_proxies(), proxies_ref)
+        self._assert_kinematics_consistent()
+
+        # The proxies are updated if the structure of the model changes while it is biased
+        self._set_flexible(True)
+        self._simulate(is_state_theoretical=True)
+        self.assertEqual(self.robot.nq, proxies_ref[0] + 4)
+        self.assertEqual(self.robot.nv, proxies_ref[1] + 3)
+        self._assert_kinematics_consistent()
+
+        self._set_flexible(False)
+        self._simulate()
+        self._assert_proxies_equal(self._get_proxies(), proxies_ref)
+        self._assert_kinematics_consistent()
+
+        # The nominal model is restored once the biases are disabled
+        self._set_bias_std(0.0)
+        log_data = self._simulate()
+        for value, value_ref in zip(self._get_dynamics_properties(), properties_ref):
+            self.assertTrue(np.array_equal(value, value_ref))
+        self._assert_proxies_equal(self._get_proxies(), proxies_ref)
+        self._assert_kinematics_consistent()
+        self.assertEqual(set(log_data.keys()), set(log_data_ref.keys()))
+        for field, values in log_data_ref.items():
+            self.assertTrue(np.allclose(values, log_data[field], atol=TOLERANCE))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,91 @@
+# This file aims at verifying that the models loaded from the binary cache are
+# identical to the ones obtained by parsing the URDF.
+import os
+import gc
+import glob
+import tempfile
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+
+class ModelCache(unittest.TestCase):
+    def setUp(self):
+        self.urdf_path = "data/linear_two_masses.urdf"
+        self.cache_dir = tempfile.TemporaryDirectory()
+
+    def tearDown(self):
+        self.cache_dir.cleanup()
+
+    def _create_robot(self, has_freeflyer=False):
+        robot = jiminy.Robot()
+        model_options = robot.get_model_options()
+        model_options["cache"]["enable"] = True
+        model_options["cache"]["directory"] = self.cache_dir.name
+        robot.set_model_options(model_options)
+        robot.initialize(self.urdf_path, has_freeflyer=has_freeflyer)
+        return robot
+
+    def _get_model_info(self, robot):
+        pnc_model = robot.pinocchio_model
+        return (pnc_model.nq, pnc_model.nv, list(pnc_model.names),
+                [frame.name for frame in pnc_model.frames],
+                [inertia.mass for inertia in pnc_model.inertias])
+
+    def _get_cache_files(self):
+        return glob.glob(os.path.join(self.cache_dir.name, "model_*.bin"))
+
+    def test_cache(self):
+        """
+        @brief Verify that the processed model is written in cache the first time it is
+               loaded, and that the model read from the cache afterward is identical.
+        """
+        # The cache file is created when the model is loaded for the first time
+        robot = self._create_robot()
+        model_info_ref = self._get_model_info(robot)
+        self.assertEqual(len(self._get_cache_files()), 1)
+
+        # Release the model, so that the next one cannot be shared in-process
+        del robot
+        gc.collect()
+
+        # The model is read from the cache, without writing any new file
+        cache_files = self._get_cache_files()
+        cache_mtime = os.path.getmtime(cache_files[0])
+        robot = self._create_robot()
+        self.assertEqual(self._get_cache_files(), cache_files)
+        self.assertEqual(os.path.getmtime(cache_files[0]), cache_mtime)
+        model_info = self._get_model_info(robot)
+        self.assertEqual(model_info[:-1], model_info_ref[:-1])
+        self.assertTrue(np.allclose(model_info[-1], model_info_ref[-1]))
+
+        # The options affecting the processed model are part of the cache key
+        robot_freeflyer = self._create_robot(has_freeflyer=True)
+        self.assertEqual(len(self._get_cache_files()), 2)
+        self.assertEqual(robot_freeflyer.pinocchio_model.nq, robot.pinocchio_model.nq + 7)
+
+    def test_corrupted_cache(self):
+        """
+        @brief Verify that a corrupted cache file is ignored instead of breaking the model.
+        """
+        robot = self._create_robot()
+        model_info_ref = self._get_model_info(robot)
+        del robot
+        gc.collect()
+
+        # Overwrite the cache file with garbage
+        cache_file, = self._get_cache_files()
+        with open(cache_file, 'wb') as f:
+            f.write(b'\x00' * 16)
+
+        # The model is still loaded from the URDF, and the cache file is repaired
+        robot = self._create_robot()
+        model_info = self._get_model_info(robot)
+        self.assertEqual(model_info[:-1], model_info_ref[:-1])
+        self.assertTrue(np.allclose(model_info[-1], model_info_ref[-1]))
+        self.assertTrue(os.path.getsize(cache_file) > 16)
+
+
+if __name__ == '__main__':
+    unittest.main()
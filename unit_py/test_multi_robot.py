@@ -101,6 +101,130 @@ class SimulateMultiRobot(unittest.TestCase):
         # Compare the numerical and analytical solutions
         self.assertTrue(np.allclose(x_jiminy, x_analytical, atol=TOLERANCE))
 
+    def test_kinematic_system(self):
+        """
+        @brief Simulate a mass linked by a spring to a kinematic system, whose motion
+               is prescribed by a trajectory instead of being integrated.
+
+        @details The kinematic system follows exactly the trajectory, whatever the force
+                 applied by the spring, and it drags the mass along.
+        """
+        # Load URDF, create robot.
+        urdf_path = "data/linear_single_mass.urdf"
+        system_names = ['DynamicSystem', 'KinematicSystem']
+        robots = [load_urdf_default(urdf_path, ["Joint"]) for _ in range(2)]
+
+        # Create the engine, the motion of the second system being prescribed
+        engine = jiminy.EngineMultiRobot()
+        engine.add_system(system_names[0], robots[0])
+        times = np.array([0.0, 0.5, 1.0])
+        positions = np.array([[0.0, 0.2, 0.0]])
+        engine.add_kinematic_system(system_names[1], robots[1], times, positions)
+
+        # Add coupling force between both systems: a spring between both masses.
+        k = 50.0
+        def coupling_force(t, q1, v1, q2, v2, f):
+            f[0] = k * (q2[0] - q1[0])
+
+        engine.add_coupling_force(system_names[0], system_names[1], "Mass", "Mass", coupling_force)
+
+        # Only the dynamic system requires an initial state
+        x0 = {system_names[0]: np.array([0.0, 0.0])}
+        engine.start(x0)
+
+        # The kinematic system goes through the knots, then stays still
+        for t, q_ref in ((0.5, 0.2), (1.0, 0.0), (1.5, 0.0)):
+            engine.step(t - engine.stepper_state.t)
+            q = engine.get_system_state(system_names[1]).q
+            self.assertTrue(np.allclose(q, q_ref, atol=TOLERANCE))
+
+        # The dynamic system has been dragged along
+        q_dynamic = engine.get_system_state(system_names[0]).q
+        engine.stop()
+        self.assertTrue(np.abs(q_dynamic[0]) > TOLERANCE)
+
+    def test_native_forces(self):
+        """
+        @brief Verify that the native force profiles and coupling forces give the same
+               motion as the equivalent force functions defined in Python.
+
+        @details A sinusoidal force profile shakes the first point mass, which is linked
+                 to the second one by a spring-damper, in tether mode or not.
+        """
+        urdf_path = "data/point_mass.urdf"
+        system_names = ['FirstSystem', 'SecondSystem']
+
+        offset = np.array([0.5, 0.0, -0.2, 0.0, 0.0, 0.0])
+        amplitude = np.array([2.0, 1.0, 0.0, 0.0, 0.0, 0.0])
+        frequency, phase = 1.5, 0.3
+        stiffness, damping, rest_length = 20.0, 0.5, 0.4
+
+        def force_profile(t, q, v, f):
+            f[:] = offset + amplitude * np.sin(2 * np.pi * frequency * t + phase)
+
+        def get_coupling_force(is_tether):
+            # The frames are at the origin of the freeflyers, whose orientation is constant
+            def coupling_force(t, q1, v1, q2, v2, f):
+                direction = q2[:3] - q1[:3]
+                length = np.linalg.norm(direction)
+                f[:] = 0.0
+                if is_tether and length < rest_length:
+                    return
+                direction /= length
+                length_dot = (v2[:3] - v1[:3]).dot(direction)
+                intensity = stiffness * (length - rest_length) + damping * length_dot
+                if is_tether:
+                    intensity = max(intensity, 0.0)
+                f[:3] = intensity * direction
+            return coupling_force
+
+        def simulate(is_native, is_tether):
+            engine = jiminy.EngineMultiRobot()
+            robots = []
+            for system_name in system_names:
+                robot = jiminy.Robot()
+                robot.initialize(urdf_path, has_freeflyer=True)
+                engine.add_system(system_name, robot)
+                robots.append(robot)
+
+            engine_options = engine.get_options()
+            engine_options["world"]["gravity"] = np.zeros(6) # Turn off gravity
+            engine.set_options(engine_options)
+
+            if is_native:
+                engine.register_force_profile(
+                    system_names[0], "MassBody", offset, amplitude, frequency, phase)
+                engine.add_coupling_force(*system_names, "MassBody", "MassBody",
+                                          stiffness, damping, rest_length, is_tether)
+            else:
+                engine.register_force_profile(system_names[0], "MassBody", force_profile)
+                engine.add_coupling_force(*system_names, "MassBody", "MassBody",
+                                          get_coupling_force(is_tether))
+
+            # Both masses are initially at rest, closer than the rest length
+            x0 = {}
+            for i, system_name in enumerate(system_names):
+                x0[system_name] = np.zeros(13)
+                x0[system_name][[0, 6]] = [0.3 * i, 1.0] # [TX,TY,TZ],[QX,QY,QZ,QW]
+            tf = 3.0
+            engine.simulate(tf, x0)
+
+            log_data, _ = engine.get_log()
+            return np.stack([log_data['.'.join(('HighLevelController', system_name, s))]
+                             for system_name, robot in zip(system_names, robots)
+                             for s in robot.logfile_position_headers + \
+                                      robot.logfile_velocity_headers], axis=-1)
+
+        for is_tether in (False, True):
+            x_native = simulate(True, is_tether)
+            x_python = simulate(False, is_tether)
+            self.assertEqual(x_native.shape, x_python.shape)
+            self.assertTrue(np.allclose(x_native, x_python, atol=TOLERANCE))
+
+            # The masses did move, and both forces were applied
+            self.assertTrue(np.max(np.abs(x_native[:, 7:9])) > 0.1)
+            self.assertTrue(np.max(np.abs(x_native[:, 13 + 7:13 + 9])) > 0.1)
+
 
 if __name__ == '__main__':
     unittest.main()
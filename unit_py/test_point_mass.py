@@ -181,5 +181,146 @@ class SimulatePointMass(unittest.TestCase):
         self.assertTrue(a_steady < TOLERANCE_acc)
         self.assertTrue(np.allclose(v_steady, v_steady_analytical, atol=TOLERANCE))
 
+    def test_sampled_force_profile(self):
+        """
+        @brief Validate the force profiles sampled with a given update period.
+
+        @details The profile must be evaluated at every multiple of the period only, and
+                 held constant in between. A period shorter than the minimum timestep of
+                 the simulation must be rejected.
+        """
+        # Create the engine
+        engine = jiminy.Engine()
+        engine.initialize(self.robot)
+
+        engine_options = engine.get_options()
+        engine_options["world"]["gravity"] = np.zeros(6) # Turn off gravity
+        engine_options["stepper"]["logInternalStepperSteps"] = True
+        engine.set_options(engine_options)
+
+        # Periods shorter than the minimum timestep are rejected, and nothing is registered
+        t_rejected = []
+        def force_rejected(t, q, v, f):
+            t_rejected.append(t)
+        self.assertEqual(engine.register_force_profile("MassBody", force_rejected, 5.0e-7),
+                         jiminy.hresult_t.ERROR_BAD_INPUT)
+
+        # Register a force increasing with time, sampled periodically
+        update_period = 0.1
+        t_sampled = []
+        def force_profile(t, q, v, f):
+            t_sampled.append(t)
+            f[0] = 1.0 + 2.0 * t
+        self.assertEqual(engine.register_force_profile("MassBody", force_profile, update_period),
+                         jiminy.hresult_t.SUCCESS)
+
+        # Run simulation
+        x0 = np.array([0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0,
+                       0.0, 0.0, 0.0, 0.0, 0.0, 0.0, ]) # [TX,TY,TZ],[QX,QY,QZ,QW]
+        tf = 1.05
+        engine.simulate(tf, x0)
+
+        # The profile is only evaluated at every multiple of the update period
+        self.assertEqual(len(t_rejected), 0)
+        n_updates = int(tf / update_period) + 1
+        self.assertEqual(len(t_sampled), n_updates)
+        self.assertTrue(np.allclose(t_sampled, update_period * np.arange(n_updates), atol=TOLERANCE))
+
+        # The velocity is piecewise linear, since the force is held between two updates
+        mass = self.robot.pinocchio_model.inertias[-1].mass
+        log_data, _ = engine.get_log()
+        time = log_data['Global.Time']
+        v_x = log_data['HighLevelController.' + self.robot.logfile_velocity_headers[0]]
+        k_update = np.floor(time / update_period + 1e-9)
+        f_held = 1.0 + 2.0 * update_period * k_update
+        v_x_analytical = (update_period * (k_update + update_period * k_update * (k_update - 1))
+                          + f_held * (time - update_period * k_update)) / mass
+
+        # A specific tolerance is used because of the limited precision of the log
+        TOLERANCE_log = 1e-6
+        self.assertTrue(np.allclose(v_x, v_x_analytical, atol=TOLERANCE_log))
+
+    def _simulate_drop(self, contact_model, dt_max, friction):
+        """
+        @brief Throw the point mass sideways onto the ground using a given contact model.
+        """
+        # Create the engine
+        engine = jiminy.Engine()
+        engine.initialize(self.robot)
+
+        # Same Coulomb friction coefficient whatever the sliding velocity
+        engine_options = engine.get_options()
+        engine_options['contacts']['model'] = contact_model
+        engine_options['contacts']['stiffness'] = self.k_contact
+        engine_options['contacts']['damping'] = self.nu_contact
+        engine_options['contacts']['frictionDry'] = friction
+        engine_options['contacts']['frictionViscous'] = friction
+        engine_options['contacts']['transitionEps'] = 1.0 / self.k_contact
+        engine_options["stepper"]["dtMax"] = dt_max
+        engine_options["stepper"]["logInternalStepperSteps"] = True
+        engine.set_options(engine_options)
+
+        # Run simulation
+        x0 = np.array([0.0, 0.0, 0.05, 0.0, 0.0, 0.0, 1.0,
+                       1.0, 0.0, 0.0, 0.0, 0.0, 0.0, ]) # [TX,TY,TZ],[QX,QY,QZ,QW]
+        tf = 1.0
+        engine.simulate(tf, x0)
+
+        log_data, _ = engine.get_log()
+        x_jiminy = np.stack([log_data['HighLevelController.' + s]
+                            for s in self.robot.logfile_position_headers + \
+                                     self.robot.logfile_velocity_headers], axis=-1)
+        f_contact = np.stack([log_data['MassBody.' + s] for s in ('FX', 'FY', 'FZ')], axis=-1)
+        return log_data['Global.Time'], x_jiminy, f_contact
+
+    def test_time_stepping_contact(self):
+        """
+        @brief Validate the time-stepping contact model.
+
+        @details The point mass must never go deeper into the ground than the distance
+                 travelled during the step of the impact, the contact forces must always
+                 lie inside the friction cone, and the mass must end up at rest at the same
+                 place as with the spring-damper contact model.
+        """
+        dt_max = 1.0e-3
+        friction = 0.5
+        time, x_jiminy, f_contact = self._simulate_drop("time_stepping", dt_max, friction)
+
+        # Extract some information about the engine and the robot
+        mass = self.robot.pinocchio_model.inertias[-1].mass
+        gravity = jiminy.Engine().get_options()['world']['gravity'][2]
+
+        # A specific tolerance is used because of the limited precision of the log
+        TOLERANCE_log = 1e-5
+
+        # Check the non-penetration: the penetration does not exceed the one of the impact
+        v_impact = np.sqrt(2 * abs(gravity) * 0.05)
+        is_contact = x_jiminy[:, 2] < 0.0
+        self.assertTrue(np.any(is_contact))
+        self.assertTrue(np.min(x_jiminy[:, 2]) > - v_impact * dt_max)
+        i_impact = np.where(is_contact)[0][0]
+        self.assertTrue(np.all(np.abs(x_jiminy[i_impact:, 9]) < TOLERANCE_log))
+        self.assertTrue(np.allclose(x_jiminy[i_impact:, 2], x_jiminy[i_impact, 2], atol=TOLERANCE_log))
+
+        # Check that the contact forces lie inside the friction cone
+        f_tangential = np.linalg.norm(f_contact[:, :2], axis=1)
+        self.assertTrue(np.all(f_contact[:, 2] > - TOLERANCE_log))
+        self.assertTrue(np.all(f_tangential <= friction * f_contact[:, 2] * (1.0 + TOLERANCE_log) + TOLERANCE_log))
+
+        # The friction force is saturated while sliding, then the mass sticks to the ground
+        is_sliding = np.logical_and(is_contact[:-1], x_jiminy[1:, 7] > 1.0e-2)
+        self.assertTrue(np.any(is_sliding))
+        acc_sliding = (np.diff(x_jiminy[:, 7]) / np.diff(time))[is_sliding]
+        self.assertTrue(np.allclose(acc_sliding, friction * gravity, atol=1e-3))
+        self.assertTrue(np.allclose(x_jiminy[-1, 7:], 0.0, atol=TOLERANCE_log))
+
+        # Compare the steady state with the one of the spring-damper contact model
+        _, x_jiminy_ref, f_contact_ref = self._simulate_drop("spring_damper", self.dtMax, friction)
+        self.assertTrue(np.allclose(f_contact[-1], f_contact_ref[-1], atol=1e-3))
+        self.assertTrue(np.allclose(f_contact[-1, 2], - mass * gravity, atol=1e-3))
+        self.assertTrue(np.allclose(x_jiminy[-1, 2], x_jiminy_ref[-1, 2], atol=v_impact * dt_max))
+        self.assertTrue(np.allclose(x_jiminy[-1, :2], x_jiminy_ref[-1, :2], atol=1e-2))
+        self.assertTrue(np.allclose(x_jiminy[-1, 7:], x_jiminy_ref[-1, 7:], atol=1e-4))
+
 if __name__ == '__main__':
     unittest.main()
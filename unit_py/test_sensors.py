@@ -0,0 +1,133 @@
+# This file aims at verifying that the way the sensors are evaluated does not
+# affect the simulation.
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class LazySensors(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+        encoder = jiminy.EncoderSensor("PendulumJoint")
+        self.robot.attach_sensor(encoder)
+        encoder.initialize("PendulumJoint")
+        effort = jiminy.EffortSensor("PendulumJoint")
+        self.robot.attach_sensor(effort)
+        effort.initialize("PendulumJoint")
+
+    def _simulate(self, is_lazy, sensors_types_read=[]):
+        # PD controller based on the encoder
+        k_p, k_d = 10.0, 1.0
+        def compute_command(t, q, v, sensor_data, u):
+            encoder_data = sensor_data['EncoderSensor', 'PendulumJoint']
+            u[:] = - k_p * encoder_data[0] - k_d * encoder_data[1]
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+        controller_options = controller.get_options()
+        controller_options["sensorsTypesRead"] = sensors_types_read
+        controller.set_options(controller_options)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+        engine_options = engine.get_options()
+        engine_options["stepper"]["sensorsLazyEvaluation"] = is_lazy
+        engine.set_options(engine_options)
+
+        # Run simulation
+        x0 = np.array([0.1, 0.0])
+        tf = 2.0
+        engine.simulate(tf, x0)
+
+        log_data, _ = engine.get_log()
+        return log_data
+
+    def test_lazy_evaluation(self):
+        """
+        @brief Verify that deferring the evaluation of the continuous sensors until their
+               data is actually needed gives the same result as evaluating them eagerly.
+        """
+        log_data_eager = self._simulate(False)
+        log_data_lazy = self._simulate(True)
+        log_data_lazy_read = self._simulate(True, ['EncoderSensor'])
+
+        # The data of the sensors and the motion of the pendulum must be identical
+        for log_data in (log_data_lazy, log_data_lazy_read):
+            self.assertEqual(set(log_data_eager.keys()), set(log_data.keys()))
+            for field, values in log_data_eager.items():
+                self.assertTrue(np.allclose(values, log_data[field], atol=TOLERANCE))
+
+
+class SensorsNoise(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot with two noisy encoders measuring the same joint
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+        self.encoder_names = ["FirstEncoder", "SecondEncoder"]
+        for encoder_name in self.encoder_names:
+            encoder = jiminy.EncoderSensor(encoder_name)
+            self.robot.attach_sensor(encoder)
+            encoder.initialize("PendulumJoint")
+
+        sensors_options = self.robot.get_sensors_options()
+        for encoder_name in self.encoder_names:
+            sensors_options['EncoderSensor'][encoder_name]['noiseStd'] = np.array([1.0e-2, 1.0e-2])
+        self.robot.set_sensors_options(sensors_options)
+
+    def test_noise_uncorrelated(self):
+        """
+        @brief Verify that the noise of different sensors is uncorrelated, and that it is
+               not the same from one simulation to the next without resetting the random
+               number generators.
+        """
+        # Record the noise of the encoders at every update of the controller
+        noise = []
+        def compute_command(t, q, v, sensor_data, u):
+            noise.append([sensor_data['EncoderSensor', encoder_name][0] - q[0]
+                          for encoder_name in self.encoder_names])
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+        engine_options = engine.get_options()
+        engine_options["stepper"]["controllerUpdatePeriod"] = 1.0e-2
+        engine.set_options(engine_options)
+
+        # Run simulation
+        x0 = np.array([0.1, 0.0])
+        tf = 2.0
+        engine.simulate(tf, x0)
+        noise_first = np.array(noise)
+
+        # The noise of the encoders is not the same, and is uncorrelated
+        self.assertTrue(np.all(np.std(noise_first, axis=0) > 1.0e-3))
+        self.assertFalse(np.allclose(noise_first[:, 0], noise_first[:, 1]))
+        self.assertTrue(abs(np.corrcoef(noise_first.T)[0, 1]) < 0.3)
+
+        # The noise differs at the next simulation
+        noise.clear()
+        engine.simulate(tf, x0)
+        noise_second = np.array(noise)
+        n_samples = min(len(noise_first), len(noise_second))
+        self.assertFalse(np.allclose(noise_first[:n_samples], noise_second[:n_samples]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,109 @@
+# This file aims at verifying that a fully configured robot can be serialized
+# and rebuilt without accessing the filesystem, with no effect on the simulation.
+import pickle
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class RobotSerialization(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+        encoder = jiminy.EncoderSensor("PendulumJoint")
+        self.robot.attach_sensor(encoder)
+        encoder.initialize("PendulumJoint")
+        effort = jiminy.EffortSensor("PendulumJoint")
+        self.robot.attach_sensor(effort)
+        effort.initialize("PendulumJoint")
+
+        # Use non-default options, to make sure they are serialized too
+        sensors_options = self.robot.get_sensors_options()
+        sensors_options['EncoderSensor']['PendulumJoint']['delay'] = 1.0e-2
+        self.robot.set_sensors_options(sensors_options)
+
+    def _assert_options_equal(self, options, options_ref):
+        self.assertEqual(set(options.keys()), set(options_ref.keys()))
+        for key, value_ref in options_ref.items():
+            value = options[key]
+            if isinstance(value_ref, dict):
+                self._assert_options_equal(value, value_ref)
+            elif isinstance(value_ref, np.ndarray):
+                self.assertTrue(np.allclose(value, value_ref))
+            else:
+                self.assertEqual(value, value_ref)
+
+    def _assert_robots_equal(self, robot, robot_ref):
+        self.assertTrue(robot.is_initialized)
+        self.assertEqual(robot.pinocchio_model.nq, robot_ref.pinocchio_model.nq)
+        self.assertEqual(robot.motors_names, robot_ref.motors_names)
+        self.assertEqual(robot.sensors_names, robot_ref.sensors_names)
+        self._assert_options_equal(robot.get_options(), robot_ref.get_options())
+
+    def _simulate(self, robot):
+        # PD controller based on the encoder
+        k_p, k_d = 10.0, 1.0
+        def compute_command(t, q, v, sensor_data, u):
+            encoder_data = sensor_data['EncoderSensor', 'PendulumJoint']
+            u[:] = - k_p * encoder_data[0] - k_d * encoder_data[1]
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(robot)
+
+        engine = jiminy.Engine()
+        engine.initialize(robot, controller)
+
+        # Run simulation
+        x0 = np.array([0.1, 0.0])
+        tf = 2.0
+        engine.simulate(tf, x0)
+
+        log_data, _ = engine.get_log()
+        return log_data
+
+    def test_binary(self):
+        """
+        @brief Verify that a robot rebuilt from its binary dump is identical to the original
+               one, and that an invalid dump is rejected.
+        """
+        data = self.robot.dump_to_binary()
+        robot = jiminy.Robot()
+        self.assertEqual(robot.load_from_binary(data), jiminy.hresult_t.SUCCESS)
+        self._assert_robots_equal(robot, self.robot)
+
+        # Truncated data is rejected
+        robot = jiminy.Robot()
+        self.assertNotEqual(robot.load_from_binary(data[:len(data) // 2]),
+                            jiminy.hresult_t.SUCCESS)
+
+        # An uninitialized robot cannot be serialized
+        with self.assertRaises(RuntimeError):
+            jiminy.Robot().dump_to_binary()
+
+    def test_pickle(self):
+        """
+        @brief Verify that a robot can be pickled, and that the unpickled robot gives
+               exactly the same simulation as the original one.
+        """
+        robot = pickle.loads(pickle.dumps(self.robot))
+        self._assert_robots_equal(robot, self.robot)
+
+        log_data_ref = self._simulate(self.robot)
+        log_data = self._simulate(robot)
+        self.assertEqual(set(log_data.keys()), set(log_data_ref.keys()))
+        for field, values in log_data_ref.items():
+            self.assertTrue(np.allclose(values, log_data[field], atol=TOLERANCE))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -118,6 +118,68 @@ class SimulateSimplePendulum(unittest.TestCase):
         # Compare the numerical and numerical integration of analytical model using scipy
         self.assertTrue(np.allclose(x_jiminy, x_rk_python, atol=TOLERANCE))
 
+    def test_joint_bounds(self):
+        """
+        @brief Verify the forces enforcing the position and velocity bounds of a revolute
+               joint, which must push it back inside its bounds.
+        """
+        # Create robot without motor, keeping the bounds of the URDF
+        self.robot = jiminy.Robot()
+        self.robot.initialize(self.urdf_path, has_freeflyer = False)
+        q_max = self.robot.position_limit_upper[0]
+        v_max = self.robot.velocity_limit[0]
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot)
+        engine_options = engine.get_options()
+        engine_options["world"]["gravity"] = np.zeros(6) # Turn off gravity
+        engine.set_options(engine_options)
+        joint_options = engine_options["joints"]
+
+        def compute_bound_force(q, v, enable_position_limit, enable_velocity_limit):
+            u = 0.0
+            if enable_position_limit:
+                q_error = max(q - q_max, 0.0) + min(q - self.robot.position_limit_lower[0], 0.0)
+                v_error = v if q_error * v > 0.0 else 0.0
+                eps = joint_options["transitionPositionEps"]
+                blending_factor = abs(q_error - eps * np.tanh(q_error / eps))
+                u -= joint_options["boundStiffness"] * q_error + \
+                     joint_options["boundDamping"] * blending_factor * v_error
+            if enable_velocity_limit:
+                v_error = max(v - v_max, 0.0) + min(v + v_max, 0.0)
+                u -= joint_options["boundDamping"] * \
+                     np.tanh(v_error / joint_options["transitionVelocityEps"])
+            return u
+
+        # Throw the pendulum toward its upper position bound, then beyond its velocity bound
+        for enable_position_limit, enable_velocity_limit, x0 in (
+                (True, False, np.array([q_max - 0.01, 3.0])),
+                (False, True, np.array([0.0, 1.1 * v_max]))):
+            model_options = self.robot.get_model_options()
+            model_options["joints"]["enablePositionLimit"] = enable_position_limit
+            model_options["joints"]["enableVelocityLimit"] = enable_velocity_limit
+            self.robot.set_model_options(model_options)
+
+            # Compare the bound forces with the expected ones after each step
+            engine.start(x0)
+            q_all, v_all = [], []
+            for _ in range(100):
+                engine.step(1.0e-3)
+                q, v = engine.system_state.q[0], engine.system_state.v[0]
+                u_ref = compute_bound_force(q, v, enable_position_limit, enable_velocity_limit)
+                self.assertTrue(np.allclose(engine.system_state.u_internal[0], u_ref, atol=TOLERANCE))
+                q_all.append(q)
+                v_all.append(v)
+            engine.stop()
+
+            # The bounds have been reached, then enforced
+            if enable_position_limit:
+                self.assertTrue(np.max(q_all) > q_max)
+                self.assertTrue(np.max(q_all) < q_max + 0.1)
+                self.assertTrue(v_all[-1] < 0.0)
+            if enable_velocity_limit:
+                self.assertTrue(v_all[-1] < v_max)
+
     def test_pendulum_force_impulse(self):
         """
         @brief   Validate the impulse-momentum theorem
@@ -388,5 +450,78 @@ class SimulateSimplePendulum(unittest.TestCase):
 
         self.assertTrue(np.allclose(x_jiminy, x_analytical, atol=TOLERANCE))
 
+    def test_dc_motor_electrical_response(self):
+        """
+        @brief Verify the internal state of a DC motor subject to a constant voltage.
+
+        @details Without back electromotive force and with a resistance independent of
+                 the temperature, the current follows a first-order response whose time
+                 constant is L / R, and the temperature is heated by the Joule losses.
+        """
+        # Create robot with a DC motor instead of a simple motor
+        self.robot = jiminy.Robot()
+        self.robot.initialize(self.urdf_path, has_freeflyer = False)
+        motor = jiminy.DcMotor("PendulumJoint")
+        self.robot.attach_motor(motor)
+        motor.initialize("PendulumJoint")
+
+        R, L, K_t = 2.0, 5.0e-3, 0.1
+        R_th, C_th = 1.0, 100.0
+        motor_options = self.robot.get_motors_options()
+        motor_options["PendulumJoint"]['armatureResistance'] = R
+        motor_options["PendulumJoint"]['armatureInductance'] = L
+        motor_options["PendulumJoint"]['torqueConstant'] = K_t
+        motor_options["PendulumJoint"]['backEmfConstant'] = 0.0
+        motor_options["PendulumJoint"]['resistanceTemperatureCoefficient'] = 0.0
+        motor_options["PendulumJoint"]['thermalResistance'] = R_th
+        motor_options["PendulumJoint"]['thermalCapacitance'] = C_th
+        self.robot.set_motors_options(motor_options)
+
+        # Constant voltage applied to the windings
+        U = 1.5
+        def computeCommand(t, q, v, sensor_data, u):
+            u[:] = U
+
+        def internalDynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(computeCommand, internalDynamics)
+        controller.initialize(self.robot)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+        engine_options = engine.get_options()
+        engine_options["world"]["gravity"] = np.zeros(6) # Turn off gravity
+        engine_options["stepper"]["tolAbs"] = 1.0e-10
+        engine_options["stepper"]["tolRel"] = 1.0e-10
+        engine.set_options(engine_options)
+
+        # Run simulation, starting with no current and at ambient temperature
+        x0 = np.array([0.0, 0.0])
+        dt, n_steps = 1.0e-4, 250
+        engine.start(x0)
+        time, x_motor, u_motor = [0.0], [engine.system_state.x_motor.copy()], []
+        for _ in range(n_steps):
+            engine.step(dt)
+            time.append(engine.stepper_state.t)
+            x_motor.append(engine.system_state.x_motor.copy())
+            u_motor.append(engine.system_state.u_motor.copy())
+        engine.stop()
+        time, x_motor, u_motor = np.array(time), np.stack(x_motor, axis=0), np.stack(u_motor, axis=0)
+
+        # Analytical first-order response of the current
+        current_analytical = U / R * (1.0 - np.exp(- R / L * time))
+        self.assertTrue(np.allclose(x_motor[:, 0], current_analytical, atol=TOLERANCE))
+        self.assertTrue(np.allclose(x_motor[-1, 0], U / R, atol=1e-4))
+        self.assertTrue(np.allclose(u_motor[:, 0], K_t * x_motor[1:, 0], atol=TOLERANCE))
+
+        # Temperature heated by the Joule losses of the analytical current
+        def thermal_dynamics(t, x):
+            current = U / R * (1.0 - np.exp(- R / L * t))
+            return np.array([(R * current ** 2 - x[0] / R_th) / C_th])
+
+        temperature_python = integrate_dynamics(time, np.zeros(1), thermal_dynamics)
+        self.assertTrue(np.allclose(x_motor[:, 1], temperature_python[:, 0], atol=TOLERANCE))
+
 if __name__ == '__main__':
     unittest.main()
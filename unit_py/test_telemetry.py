@@ -0,0 +1,149 @@
+# This file aims at verifying that the telemetry is consistent from one simulation
+# to the next, whether its layout can be reused or must be configured again.
+import os
+import tempfile
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class Telemetry(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+
+        self.engine = jiminy.Engine()
+        self.engine.initialize(self.robot)
+
+        self.x0 = np.array([0.1, 0.0])
+
+    def _assert_logs_equal(self, log_data, log_data_ref):
+        self.assertEqual(set(log_data.keys()), set(log_data_ref.keys()))
+        for field, values in log_data_ref.items():
+            self.assertEqual(len(values), len(log_data[field]))
+            self.assertTrue(np.allclose(values, log_data[field], atol=TOLERANCE))
+
+    def test_warm_restart(self):
+        """
+        @brief Verify that simulating again without any change gives exactly the same
+               log, and that no data of the previous simulation remains in it.
+        """
+        tf = 2.0
+        self.engine.simulate(tf, self.x0)
+        log_data_ref, log_constants_ref = self.engine.get_log()
+
+        # Same simulation
+        self.engine.simulate(tf, self.x0)
+        log_data, log_constants = self.engine.get_log()
+        self._assert_logs_equal(log_data, log_data_ref)
+        self.assertEqual(log_constants, log_constants_ref)
+
+        # Shorter simulation
+        self.engine.simulate(tf / 2, self.x0)
+        log_data, _ = self.engine.get_log()
+        time = log_data['Global.Time']
+        self.assertTrue(np.all(np.diff(time) > 0.0))
+        self.assertTrue(np.isclose(time[-1], tf / 2, atol=TOLERANCE))
+        n_samples = len(time)
+        for field, values in log_data_ref.items():
+            self.assertTrue(np.allclose(log_data[field], values[:n_samples], atol=TOLERANCE))
+
+    def test_layout_changed(self):
+        """
+        @brief Verify that the telemetry is configured again whenever the variables to
+               register change between two simulations.
+        """
+        tf = 1.0
+        self.engine.simulate(tf, self.x0)
+        log_data_ref, _ = self.engine.get_log()
+        velocity_fields = ['.'.join(('HighLevelController', header))
+                           for header in self.robot.logfile_velocity_headers]
+        for field in velocity_fields:
+            self.assertTrue(field in log_data_ref.keys())
+
+        # Disable the logging of the velocity
+        engine_options = self.engine.get_options()
+        engine_options["telemetry"]["enableVelocity"] = False
+        self.engine.set_options(engine_options)
+        self.engine.simulate(tf, self.x0)
+        log_data, _ = self.engine.get_log()
+        self.assertEqual(set(log_data.keys()), set(log_data_ref.keys()) - set(velocity_fields))
+
+        # Enable it back
+        engine_options["telemetry"]["enableVelocity"] = True
+        self.engine.set_options(engine_options)
+        self.engine.simulate(tf, self.x0)
+        log_data, _ = self.engine.get_log()
+        self._assert_logs_equal(log_data, log_data_ref)
+
+        # Attach a new sensor
+        encoder = jiminy.EncoderSensor("PendulumJoint")
+        self.robot.attach_sensor(encoder)
+        encoder.initialize("PendulumJoint")
+        self.engine.simulate(tf, self.x0)
+        log_data, _ = self.engine.get_log()
+        self.assertTrue(set(log_data_ref.keys()) < set(log_data.keys()))
+        for field, values in log_data_ref.items():
+            self.assertTrue(np.allclose(values, log_data[field], atol=TOLERANCE))
+
+    def test_flight_recorder(self):
+        """
+        @brief Verify that only the most recent data are kept in flight recorder mode, and
+               that they are dumped if and only if the simulation fails.
+        """
+        # Stop the simulation once a given time is reached, between two updates of the controller
+        t_fail = 0.505
+        def callback(t, q, v):
+            return t < t_fail
+
+        def compute_command(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller, callback)
+
+        with tempfile.TemporaryDirectory() as log_dir:
+            log_path = os.path.join(log_dir, "flight_recorder.data")
+            controller_update_period = 1.0e-2
+            engine_options = engine.get_options()
+            engine_options["stepper"]["controllerUpdatePeriod"] = controller_update_period
+            engine_options["telemetry"]["flightRecorderMemSize"] = 1024
+            engine_options["telemetry"]["flightRecorderDumpPath"] = log_path
+            engine.set_options(engine_options)
+
+            # No log is dumped if the simulation succeeds
+            engine.simulate(t_fail / 2, self.x0)
+            self.assertFalse(os.path.exists(log_path))
+
+            # The log is dumped as soon as the simulation fails
+            engine.simulate(2 * t_fail, self.x0)
+            self.assertTrue(os.path.exists(log_path))
+            log_data, _ = jiminy.Engine.read_log_binary(log_path)
+            time = log_data['Global.Time']
+            self.assertTrue(t_fail < time[-1] < t_fail + controller_update_period)
+
+            # Only the most recent data have been kept, without any gap
+            self.assertTrue(time[0] > 0.0)
+            self.assertTrue(np.allclose(np.diff(time), controller_update_period, atol=TOLERANCE))
+
+            # The dump is identical to the log in memory, up to the precision of the log
+            log_data_mem, _ = engine.get_log()
+            self.assertEqual(set(log_data.keys()), set(log_data_mem.keys()))
+            for field, values in log_data_mem.items():
+                self.assertTrue(np.allclose(values, log_data[field]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,150 @@
+# This file aims at verifying the scheduling of the timed events of the engine,
+# namely the user-defined events and the discrete update of the sensors and controllers.
+import unittest
+import numpy as np
+
+from jiminy_py import core as jiminy
+
+from utilities import load_urdf_default
+
+# Small tolerance for numerical equality.
+TOLERANCE = 1e-9
+
+
+class TimedEvents(unittest.TestCase):
+    def setUp(self):
+        # Load URDF, create robot.
+        urdf_path = "data/simple_pendulum.urdf"
+        self.robot = load_urdf_default(urdf_path, ["PendulumJoint"])
+        encoder = jiminy.EncoderSensor("PendulumJoint")
+        self.robot.attach_sensor(encoder)
+        encoder.initialize("PendulumJoint")
+
+        self.x0 = np.array([0.1, 0.0])
+
+    def test_user_events(self):
+        """
+        @brief Verify that the user-defined events are called at the requested time, once or
+               periodically, and that they are kept from one simulation to the next until removed.
+        """
+        engine = jiminy.Engine()
+        engine.initialize(self.robot)
+
+        # Register a one-time event and a periodic one
+        calls = []
+        engine.register_timed_event(0.25, lambda t: calls.append(('once', t)))
+        engine.register_timed_event(0.1, lambda t: calls.append(('periodic', t)), 0.2)
+
+        # Run simulation
+        tf = 1.0
+        engine.simulate(tf, self.x0)
+
+        # Check the time of the calls
+        times_once = np.array([t for name, t in calls if name == 'once'])
+        times_periodic = np.array([t for name, t in calls if name == 'periodic'])
+        self.assertTrue(np.allclose(times_once, [0.25], atol=TOLERANCE))
+        self.assertTrue(np.allclose(times_periodic, [0.1, 0.3, 0.5, 0.7, 0.9], atol=TOLERANCE))
+
+        # The events are breakpoints for the stepper, so they are called in chronological order
+        times = np.array([t for _, t in calls])
+        self.assertTrue(np.all(np.diff(times) > 0.0))
+
+        # The events are called again at the next simulation
+        calls_prev = list(calls)
+        calls.clear()
+        engine.simulate(tf, self.x0)
+        self.assertEqual(len(calls), len(calls_prev))
+
+        # No event is called anymore once removed
+        engine.remove_timed_events()
+        calls.clear()
+        engine.simulate(tf, self.x0)
+        self.assertEqual(len(calls), 0)
+
+    def test_sensors_before_controller(self):
+        """
+        @brief Verify that the sensors are always updated before the controller when they
+               are due at the same time, so that the command uses up-to-date sensor data.
+        """
+        # Record the position and the encoder data at every update of the controller
+        records = []
+        def compute_command(t, q, v, sensor_data, u):
+            records.append((t, q[0], sensor_data['EncoderSensor', 'PendulumJoint'][0]))
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+
+        # Discrete-time simulation, with the sensors and the controller updated at the same rate
+        engine_options = engine.get_options()
+        engine_options["stepper"]["sensorsUpdatePeriod"] = 1.0e-2
+        engine_options["stepper"]["controllerUpdatePeriod"] = 1.0e-2
+        engine.set_options(engine_options)
+
+        # Run simulation
+        tf = 1.0
+        engine.simulate(tf, self.x0)
+
+        # The encoder must measure the current position at every update of the controller
+        records = np.array(records)
+        self.assertTrue(len(records) > 0)
+        self.assertTrue(np.allclose(records[:, 1], records[:, 2], atol=TOLERANCE))
+
+    def test_sensors_not_breakpoints(self):
+        """
+        @brief Verify that the discrete update of the sensors does not force the stepper to stop,
+               and that the default step size only depends on the update period of the controller.
+        """
+        # Record the position and the encoder data at every update of the controller
+        records = []
+        def compute_command(t, q, v, sensor_data, u):
+            records.append((t, q[0], sensor_data['EncoderSensor', 'PendulumJoint'][0]))
+            u[:] = 0.0
+
+        def internal_dynamics(t, q, v, sensor_data, u):
+            u[:] = 0.0
+
+        controller = jiminy.ControllerFunctor(compute_command, internal_dynamics)
+        controller.initialize(self.robot)
+
+        # The encoder is updated much faster than the controller
+        sensors_options = self.robot.get_sensors_options()
+        sensors_options['EncoderSensor']['PendulumJoint']['updatePeriod'] = 1.0e-3
+        self.robot.set_sensors_options(sensors_options)
+
+        engine = jiminy.Engine()
+        engine.initialize(self.robot, controller)
+
+        controller_update_period = 1.0e-2
+        engine_options = engine.get_options()
+        engine_options["stepper"]["controllerUpdatePeriod"] = controller_update_period
+        engine.set_options(engine_options)
+
+        # Run simulation
+        tf = 1.0
+        engine.simulate(tf, self.x0)
+
+        # The log is only recorded at the update of the controller
+        log_data, _ = engine.get_log()
+        time = log_data['Global.Time']
+        self.assertTrue(np.allclose(np.diff(time), controller_update_period, atol=TOLERANCE))
+
+        # The encoder is still up-to-date at every update of the controller
+        records = np.array(records)
+        self.assertTrue(np.allclose(records[:, 1], records[:, 2], atol=TOLERANCE))
+
+        # The default step size is the update period of the controller
+        engine.start(self.x0)
+        engine.step()
+        self.assertTrue(np.isclose(engine.stepper_state.t, controller_update_period, atol=TOLERANCE))
+        engine.stop()
+
+
+if __name__ == '__main__':
+    unittest.main()